@@ -4,66 +4,341 @@
  *
  * OPTIMIZED SOLUTION: O(n) using modulo grouping with sum tracking
  * Uses 128-bit integers for large products
+ *
+ * Built for 10^8-value inputs with K up to 10^6:
+ *   - input is streamed (no 10MB cap), workers take line-aligned chunks
+ *     and parse them with the SWAR aoc_parse_u64
+ *   - each group keeps sum and sum of squares side by side (2 per line)
+ *   - when the table outgrows L2, every chunk is radix-partitioned by
+ *     remainder range first, so accumulation stays in one cache-sized
+ *     slice of the table at a time
+ *   - each worker owns a table, merged at the end
  */
 
+#define _GNU_SOURCE
 #include "../../tools/runner/c/common.h"
 
-#define MAX_K 1000000
+#ifndef _WIN32
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#define MAX_WORKERS 16
+// Values per worker before another one is worth its table
+#define VALUES_PER_WORKER (1 << 20)
+// Groups per partition: 4096 * 32B = 128KB slice of the table
+#define PART_SHIFT 12
+
+// No count needed: with 0 or 1 value, s*s - sum_sq is already 0
+typedef struct {
+    __int128 sum;
+    __int128 sum_sq;
+} Group;
+
+typedef struct {
+    Group* groups;
+    // Chunk copy (shared stream) and per-chunk value blocks
+    char* text;
+    size_t text_cap;
+    int64_t* vals;
+    uint32_t* rems;
+    int64_t* part_vals;
+    uint32_t* part_rems;
+    size_t block_cap;
+    uint32_t counts[(1000000 >> PART_SHIFT) + 2];
+    #ifndef _WIN32
+    pthread_t thread;
+    #endif
+} Worker;
+
+static AocStream* stream;
+static const char* pending;  // rest of the first chunk, after the header
+static size_t pending_len;
+static int worker_count;
+#ifndef _WIN32
+static pthread_mutex_t input_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static uint32_t k;
+static uint64_t k_magic;  // fastmod: remainder of a u32 without a divide
+static int parts;
+static size_t table_size;
+
+static inline uint32_t mod_k(int64_t num) {
+    if ((uint64_t)num <= UINT32_MAX) {
+        uint64_t low = k_magic * (uint32_t)num;
+        return (uint32_t)(((unsigned __int128)low * k) >> 64);
+    }
+    int64_t rem = num % (int64_t)k;
+    return (uint32_t)(rem < 0 ? rem + k : rem);
+}
+
+static int cpu_count(void) {
+    #if defined(__linux__)
+    cpu_set_t set;
+    // Respects the runner's core lease (taskset)
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) return CPU_COUNT(&set);
+    #endif
+    #ifndef _WIN32
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+    #else
+    return 1;
+    #endif
+}
+
+static void* xrealloc(void* ptr, size_t size) {
+    ptr = realloc(ptr, size);
+    if (!ptr) {
+        fprintf(stderr, "ERROR:Out of memory\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+// Next chunk for this worker, NULL at end of input
+static const char* take_chunk(Worker* w, size_t* len) {
+    const char* chunk;
+
+    #ifndef _WIN32
+    pthread_mutex_lock(&input_lock);
+    #endif
+    if (pending) {
+        chunk = pending;
+        *len = pending_len;
+        pending = NULL;
+    } else {
+        chunk = aoc_stream_next(stream, len);
+    }
+
+    // The stream reuses its buffers on the next call: copy when shared
+    if (chunk && worker_count > 1) {
+        // Same padding as the stream, for aoc_parse_u64
+        if (w->text_cap < *len + AOC_PARSE_PAD) {
+            w->text_cap = *len + AOC_PARSE_PAD;
+            w->text = (char*)xrealloc(w->text, w->text_cap);
+        }
+        memcpy(w->text, chunk, *len + 1);
+        chunk = w->text;
+    }
+    #ifndef _WIN32
+    pthread_mutex_unlock(&input_lock);
+    #endif
+
+    return chunk;
+}
+
+static void process_chunk(Worker* w, const char* p, size_t len) {
+    // Every value takes at least 2 bytes with its newline
+    size_t cap = len / 2 + 1;
+    if (w->block_cap < cap) {
+        w->block_cap = cap;
+        w->vals = (int64_t*)xrealloc(w->vals, cap * sizeof(int64_t));
+        w->rems = (uint32_t*)xrealloc(w->rems, cap * sizeof(uint32_t));
+        if (parts > 1) {
+            w->part_vals =
+                (int64_t*)xrealloc(w->part_vals, cap * sizeof(int64_t));
+            w->part_rems =
+                (uint32_t*)xrealloc(w->part_rems, cap * sizeof(uint32_t));
+        }
+    }
+
+    const char* end = p + len;
+    size_t count = 0;
+    Group* groups = w->groups;
+
+    while (p < end) {
+        while (p < end && *p != '-' && (*p < '0' || *p > '9')) p++;
+        if (p >= end) break;
+
+        int neg = *p == '-';
+        uint64_t digits;
+        p = aoc_parse_u64(p + neg, &digits) + 1;  // and its separator
+        int64_t num = neg ? -(int64_t)digits : (int64_t)digits;
+
+        uint32_t rem = mod_k(num);
+        if (parts == 1) {
+            // Whole table fits in cache: accumulate right away
+            groups[rem].sum += num;
+            groups[rem].sum_sq += (__int128)num * num;
+        } else {
+            w->vals[count] = num;
+            w->rems[count] = rem;
+            count++;
+        }
+    }
 
-// Group data: count, sum, and sum of squares
-static long long group_count[MAX_K];
-static __int128 group_sum[MAX_K];
-static __int128 group_sum_sq[MAX_K];
+    if (parts == 1 || count == 0) return;
+
+    // Radix partition by remainder range, then accumulate slice by slice
+    uint32_t* counts = w->counts;
+    memset(counts, 0, (size_t)(parts + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < count; i++) {
+        counts[(w->rems[i] >> PART_SHIFT) + 1]++;
+    }
+    for (int i = 1; i <= parts; i++) counts[i] += counts[i - 1];
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t slot = counts[w->rems[i] >> PART_SHIFT]++;
+        w->part_vals[slot] = w->vals[i];
+        w->part_rems[slot] = w->rems[i];
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        int64_t num = w->part_vals[i];
+        Group* g = &groups[w->part_rems[i]];
+        g->sum += num;
+        g->sum_sq += (__int128)num * num;
+    }
+}
+
+static void* run_worker(void* arg) {
+    Worker* w = (Worker*)arg;
+    size_t len;
+    const char* chunk;
+    while ((chunk = take_chunk(w, &len))) process_chunk(w, chunk, len);
+    return NULL;
+}
+
+static Worker workers[MAX_WORKERS];
+
+typedef struct {
+    size_t from, to;
+    #ifndef _WIN32
+    pthread_t thread;
+    int started;
+    #endif
+} MergeRange;
+
+// Fold every worker's table into the first one, over a range of groups
+static void* merge_range(void* arg) {
+    MergeRange* range = (MergeRange*)arg;
+    Group* into = workers[0].groups;
+    for (int t = 1; t < worker_count; t++) {
+        const Group* from = workers[t].groups;
+        for (size_t r = range->from; r < range->to; r++) {
+            into[r].sum += from[r].sum;
+            into[r].sum_sq += from[r].sum_sq;
+        }
+    }
+    return NULL;
+}
 
 int main(void) {
-    char* input = aoc_read_input();
+    stream = aoc_stream_open(AOC_STREAM_CHUNK, 1);
 
     AOC_TIMER_START(parse);
 
-    int n, k;
-    char* ptr = input;
-    n = (int)strtol(ptr, &ptr, 10);
-    k = (int)strtol(ptr, &ptr, 10);
+    size_t len = 0;
+    const char* first = aoc_stream_next(stream, &len);
+    if (!first) {
+        AOC_ERROR("Empty input");
+        return 1;
+    }
 
-    // Reset groups
-    memset(group_count, 0, k * sizeof(long long));
-    memset(group_sum, 0, k * sizeof(__int128));
-    memset(group_sum_sq, 0, k * sizeof(__int128));
+    char* ptr;
+    long long n = strtoll(first, &ptr, 10);
+    long long k_in = strtoll(ptr, &ptr, 10);
+    if (k_in <= 0 || k_in > 1000000) {
+        AOC_ERROR("K must be in 1..1000000");
+        return 1;
+    }
+    k = (uint32_t)k_in;
+    k_magic = UINT64_MAX / k + 1;
+    parts = (int)((k - 1) >> PART_SHIFT) + 1;
+    // Small K: one table in L1/L2, partitioning would only add a pass
+    if ((size_t)k * sizeof(Group) <= (256u << 10)) parts = 1;
+
+    pending = ptr;
+    pending_len = len - (size_t)(ptr - first);
+
+    worker_count = cpu_count();
+    long long useful = n / VALUES_PER_WORKER + 1;
+    if (worker_count > useful) worker_count = (int)useful;
+    if (worker_count > MAX_WORKERS) worker_count = MAX_WORKERS;
+    #ifdef _WIN32
+    worker_count = 1;
+    #endif
+
+    table_size = (size_t)k * sizeof(Group);
+    // Reported kind: the weakest one any worker got
+    AocPages kind = AOC_PAGES_HUGETLB;
+    const int allocated = worker_count;
+    for (int t = 0; t < allocated; t++) {
+        AocPages got;
+        workers[t].groups = (Group*)aoc_alloc_large(table_size, &got);
+        if (got < kind) kind = got;
+    }
 
-    // Group numbers by remainder
-    for (int i = 0; i < n; i++) {
-        long long num = strtoll(ptr, &ptr, 10);
-        int rem = ((num % k) + k) % k;
-        group_count[rem]++;
-        group_sum[rem] += num;
-        group_sum_sq[rem] += (__int128)num * num;
+    #ifndef _WIN32
+    for (int t = 1; t < worker_count; t++) {
+        if (pthread_create(&workers[t].thread, NULL, run_worker,
+                           &workers[t]) != 0) {
+            // Merge only the tables of the workers that did start (the
+            // started ones read worker_count in take_chunk)
+            pthread_mutex_lock(&input_lock);
+            worker_count = t;
+            pthread_mutex_unlock(&input_lock);
+            break;
+        }
     }
+    #endif
+    run_worker(&workers[0]);
+    #ifndef _WIN32
+    for (int t = 1; t < worker_count; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    #endif
 
     AOC_TIMER_END(parse);
 
     AOC_TIMER_START(solve);
 
+    if (worker_count > 1) {
+        MergeRange ranges[MAX_WORKERS];
+        for (int t = 0; t < worker_count; t++) {
+            ranges[t].from = (size_t)k * t / worker_count;
+            ranges[t].to = (size_t)k * (t + 1) / worker_count;
+        }
+        #ifndef _WIN32
+        for (int t = 1; t < worker_count; t++) {
+            ranges[t].started = pthread_create(&ranges[t].thread, NULL,
+                                               merge_range, &ranges[t]) == 0;
+        }
+        #endif
+        merge_range(&ranges[0]);
+        for (int t = 1; t < worker_count; t++) {
+            #ifndef _WIN32
+            if (ranges[t].started) {
+                pthread_join(ranges[t].thread, NULL);
+                continue;
+            }
+            #endif
+            merge_range(&ranges[t]);  // no thread: merge it here
+        }
+    }
+
+    const Group* groups = workers[0].groups;
     __int128 total = 0;
 
     // Pairs within remainder 0 group
-    if (group_count[0] >= 2) {
-        __int128 s = group_sum[0];
-        total += (s * s - group_sum_sq[0]) / 2;
-    }
+    total += (groups[0].sum * groups[0].sum - groups[0].sum_sq) / 2;
 
     // Pairs between groups r and k-r
-    for (int r = 1; r < (k + 1) / 2; r++) {
-        total += group_sum[r] * group_sum[k - r];
+    for (uint32_t r = 1; r < (k + 1) / 2; r++) {
+        total += groups[r].sum * groups[k - r].sum;
     }
 
     // If K is even, pairs within K/2 group
-    if (k % 2 == 0 && group_count[k / 2] >= 2) {
-        __int128 s = group_sum[k / 2];
-        total += (s * s - group_sum_sq[k / 2]) / 2;
+    if (k % 2 == 0) {
+        const Group* g = &groups[k / 2];
+        total += (g->sum * g->sum - g->sum_sq) / 2;
     }
 
     AOC_TIMER_END(solve);
 
+    AOC_REPORT_PAGES(groups, kind);
+
     // Print 128-bit integer
     char buf[64];
     if (total == 0) {
@@ -79,6 +354,14 @@ int main(void) {
         printf("ANSWER:%s\n", &buf[i + 1]);
     }
 
-    aoc_cleanup(input);
+    for (int t = 0; t < allocated; t++) {
+        aoc_free_large(workers[t].groups, table_size);
+        free(workers[t].text);
+        free(workers[t].vals);
+        free(workers[t].rems);
+        free(workers[t].part_vals);
+        free(workers[t].part_rems);
+    }
+    aoc_stream_close(stream);
     return 0;
 }
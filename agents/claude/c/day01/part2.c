@@ -1,49 +1,367 @@
 /**
  * 🎄 Advent of Code 2025 - Day 01 Part 2
  * Count ALL zero crossings (during and at end of rotations)
- * Optimized single-pass: branchless where possible
+ *
+ * Two phases:
+ *   1. parse (AVX2 newline scan + SWAR digits): each rotation becomes a
+ *      signed delta in (-100, 100), its full turns click on 0 once each
+ *      and are counted right away
+ *   2. solve (AVX2): a prefix sum of 8 deltas gives 8 unwrapped positions
+ *      S at once. With F = floor(S / 100) and Z = (S % 100 == 0), a
+ *      rotation clicks on 0 |F - F_prev| times, plus Z - Z_prev for L
+ *      rotations (they count landing on 0, not leaving it)
+ *
+ * Both run on all cores as a parallel prefix scan: the input is split in
+ * line-aligned blocks, each worker parses its block and sums its deltas
+ * (pass 1), an exclusive scan of the sums gives every block's starting
+ * position (mod 100), then each worker solves its block (pass 2).
  */
 
+#define _GNU_SOURCE
 #include "../../tools/runner/c/common.h"
 
-int main(void) {
-    char* input = aoc_read_input();
-    char* ptr = input;
+#ifndef _WIN32
+#include <sched.h>
+#include <unistd.h>
+#endif
 
-    AOC_TIMER_START(solve);
-    int pos = 50;
-    long long count = 0;
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Positions are biased by a multiple of 100 to stay positive, and rebased
+// every RENORM_BLOCKS blocks of 8 so they stay exact as floats (< 2^24)
+#define BIAS 1000000
+#define RENORM_BLOCKS 1024
+
+#define MAX_WORKERS 64
+// Input bytes per worker before another one is worth a thread
+#define BYTES_PER_WORKER (4 << 20)
+
+typedef struct {
+    int32_t pos;    // unwrapped position + BIAS
+    int32_t floor;  // pos / 100
+    int32_t zero;   // pos % 100 == 0
+} Dial;
+
+typedef struct {
+    const char* from;  // line-aligned block of the input
+    const char* to;
+    int8_t* deltas;
+    size_t n;
+    long long turns;  // pass 1: full turns
+    int32_t shift;    // pass 1: net rotation of the block, mod 100
+    int32_t start;    // pass 2: dial position before the block
+    long long clicks;
+    #ifndef _WIN32
+    pthread_t thread;
+    int started;
+    #endif
+} Worker;
+
+static Worker workers[MAX_WORKERS];
+static int worker_count;
+static int avx2;
+
+static int cpu_count(void) {
+    #if defined(__linux__)
+    cpu_set_t set;
+    // Respects the runner's core lease (taskset)
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) return CPU_COUNT(&set);
+    #endif
+    #ifndef _WIN32
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+    #else
+    return 1;
+    #endif
+}
+
+// Signed delta of a rotation, its full turns added to *turns.
+// L (0x4C) and R (0x52) differ in bit 1: sign mask without a branch
+static inline int8_t to_delta(char dir, uint64_t dist, long long* turns) {
+    *turns += (long long)(dist / 100);
+    int32_t step = (int32_t)(dist % 100);
+    int32_t left = ((dir >> 1) & 1) - 1;  // L: -1, R: 0
+    return (int8_t)((step ^ left) - left);
+}
+
+// Sequential: each line starts where the previous number ended
+static size_t parse_scalar(const char* p, const char* end, int8_t* deltas,
+                           size_t n, long long* turns) {
+    while (p < end) {
+        if (*p < 'A') {
+            p++;
+            continue;
+        }
+        char dir = *p;
+        uint64_t dist;
+        p = aoc_parse_u64(p + 1, &dist) + 1;  // and its newline
+        deltas[n++] = to_delta(dir, dist, turns);
+    }
+    return n;
+}
+
+#if defined(__x86_64__)
+// Newlines of 32 bytes at once give every line's start and length up
+// front, so lines are converted independently instead of one after the
+// other. Returns the number of deltas, *rest is where parsing stopped.
+__attribute__((target("avx2")))
+static size_t parse_avx2(const char* in, size_t len, int8_t* deltas,
+                         long long* turns, const char** rest) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t n = 0;
+    size_t start = 0;
+
+    for (size_t o = 0; o + 32 <= len; o += 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(in + o));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(bytes, newline));
+
+        while (mask) {
+            size_t end = o + (size_t)__builtin_ctz(mask);
+            mask &= mask - 1;
+
+            // Empty line (a block may start on one): no digits to count
+            if (end == start) {
+                start = end + 1;
+                continue;
+            }
+
+            const char* line = in + start;
+            size_t digits = end - start - 1;
+            start = end + 1;
+            if (digits > 0 && line[digits] == '\r') digits--;  // CRLF
+            if (line[0] < 'A' || digits == 0 || digits > 8) {
+                // Blank or huge line: generic path
+                if (line[0] >= 'A') {
+                    uint64_t dist;
+                    aoc_parse_u64(line + 1, &dist);
+                    deltas[n++] = to_delta(line[0], dist, turns);
+                }
+                continue;
+            }
+
+            // Known length: right-align the digits, convert in 3 steps
+            uint64_t x;
+            memcpy(&x, line + 1, 8);
+            x = (x - 0x3030303030303030ull) << (8 * (8 - digits));
+            x = (x * 10 + (x >> 8)) & 0x00FF00FF00FF00FFull;
+            x = (x * 100 + (x >> 16)) & 0x0000FFFF0000FFFFull;
+            x = (x * 10000 + (x >> 32)) & 0xFFFFFFFFull;
+            deltas[n++] = to_delta(line[0], x, turns);
+        }
+    }
+
+    *rest = in + start;
+    return n;
+}
+#endif
+
+static inline void rebase(Dial* dial) {
+    int32_t shift = (dial->pos - BIAS) / 100;
+    dial->pos -= shift * 100;
+    dial->floor -= shift;
+}
+
+static long long solve_scalar(const int8_t* d, size_t n, Dial* dial) {
+    long long clicks = 0;
+    for (size_t i = 0; i < n; i++) {
+        if ((i & (RENORM_BLOCKS * 8 - 1)) == 0) rebase(dial);
+        int32_t pos = dial->pos + d[i];
+        int32_t floor = pos / 100;
+        int32_t zero = pos == floor * 100;
+        int32_t df = floor - dial->floor;
+        clicks += (df < 0 ? -df : df) + (d[i] < 0) * (zero - dial->zero);
+        dial->pos = pos;
+        dial->floor = floor;
+        dial->zero = zero;
+    }
+    return clicks;
+}
+
+#if defined(__x86_64__)
+// Processes whole blocks of 8, returns the number of deltas consumed
+__attribute__((target("avx2")))
+static size_t solve_avx2(const int8_t* d, size_t n, Dial* dial,
+                         long long* clicks) {
+    const __m256i rotate = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i lane7 = _mm256_set1_epi32(7);
+    const __m256i hundred = _mm256_set1_epi32(100);
+    const __m256 hundred_f = _mm256_set1_ps(100.0f);
+
+    __m256i pos = _mm256_set1_epi32(dial->pos);
+    __m256i floor = _mm256_set1_epi32(dial->floor);
+    __m256i zero = _mm256_set1_epi32(-dial->zero);  // masks: -1 / 0
+    size_t i = 0;
 
-    while (*ptr) {
-        // Skip until L or R
-        while (*ptr && *ptr != 'L' && *ptr != 'R') ptr++;
-        if (!*ptr) break;
+    while (i + 8 <= n) {
+        // Per-lane click counts stay small: flush them with each rebase
+        __m256i total = _mm256_setzero_si256();
+        size_t end = i + (size_t)RENORM_BLOCKS * 8;
+        if (end > n) end = n;
 
-        char dir = *ptr++;
+        for (; i + 8 <= end; i += 8) {
+            __m256i delta = _mm256_cvtepi8_epi32(
+                _mm_loadl_epi64((const __m128i*)(d + i)));
 
-        // Fast parse - at least one digit guaranteed
-        long dist = *ptr++ - '0';
-        while (*ptr >= '0' && *ptr <= '9') {
-            dist = dist * 10 + (*ptr++ - '0');
+            // Inclusive prefix sum: within 128-bit lanes, then carry the
+            // low lane's total into the high one
+            __m256i s = _mm256_add_epi32(delta, _mm256_slli_si256(delta, 4));
+            s = _mm256_add_epi32(s, _mm256_slli_si256(s, 8));
+            __m256i low = _mm256_permute2x128_si256(s, s, 0x08);
+            s = _mm256_add_epi32(s, _mm256_shuffle_epi32(low, 0xFF));
+            s = _mm256_add_epi32(s, pos);
+
+            // Exact: s < 2^24 and s / 100 is correctly rounded
+            __m256i f = _mm256_cvttps_epi32(
+                _mm256_div_ps(_mm256_cvtepi32_ps(s), hundred_f));
+            __m256i z = _mm256_cmpeq_epi32(s, _mm256_mullo_epi32(f, hundred));
+
+            // Previous rotation's F and Z, lane 0 from the last block
+            __m256i f_prev = _mm256_blend_epi32(
+                _mm256_permutevar8x32_epi32(f, rotate), floor, 0x01);
+            __m256i z_prev = _mm256_blend_epi32(
+                _mm256_permutevar8x32_epi32(z, rotate), zero, 0x01);
+
+            __m256i left = _mm256_srai_epi32(delta, 31);
+            __m256i crossed = _mm256_abs_epi32(_mm256_sub_epi32(f, f_prev));
+            __m256i landed =
+                _mm256_and_si256(_mm256_sub_epi32(z_prev, z), left);
+            total = _mm256_add_epi32(total, _mm256_add_epi32(crossed, landed));
+
+            pos = _mm256_permutevar8x32_epi32(s, lane7);
+            floor = _mm256_permutevar8x32_epi32(f, lane7);
+            zero = _mm256_permutevar8x32_epi32(z, lane7);
         }
 
-        if (dir == 'R') {
-            long total = pos + dist;
-            long crossings = total / 100;
-            count += crossings;
-            pos = (int)(total - crossings * 100);
+        int32_t lanes[8];
+        _mm256_storeu_si256((__m256i*)lanes, total);
+        for (int l = 0; l < 8; l++) *clicks += lanes[l];
+
+        dial->pos = _mm256_cvtsi256_si32(pos);
+        dial->floor = _mm256_cvtsi256_si32(floor);
+        dial->zero = -_mm256_cvtsi256_si32(zero);
+        rebase(dial);
+        pos = _mm256_set1_epi32(dial->pos);
+        floor = _mm256_set1_epi32(dial->floor);
+    }
+
+    return i;
+}
+#endif
+
+// Pass 1: deltas and net rotation of one block
+static void* parse_block(void* arg) {
+    Worker* w = (Worker*)arg;
+    size_t len = (size_t)(w->to - w->from);
+    // At least 2 bytes per rotation
+    w->deltas = (int8_t*)malloc(len / 2 + 1);
+    if (!w->deltas) {
+        fprintf(stderr, "ERROR:Out of memory\n");
+        exit(1);
+    }
+
+    // A block starts right after a newline, possibly on an empty line:
+    // both parsers skip blank lines wherever they are
+    const char* rest = w->from;
+    w->n = 0;
+    #if defined(__x86_64__)
+    if (avx2) w->n = parse_avx2(w->from, len, w->deltas, &w->turns, &rest);
+    #endif
+    w->n = parse_scalar(rest, w->to, w->deltas, w->n, &w->turns);
+
+    long long sum = 0;
+    for (size_t i = 0; i < w->n; i++) sum += w->deltas[i];
+    w->shift = (int32_t)(sum % 100);
+    return NULL;
+}
+
+// Pass 2: clicks of one block, from its starting position
+static void* solve_block(void* arg) {
+    Worker* w = (Worker*)arg;
+    Dial dial = {BIAS + w->start, (BIAS + w->start) / 100, w->start == 0};
+    size_t done = 0;
+
+    #if defined(__x86_64__)
+    if (avx2) done = solve_avx2(w->deltas, w->n, &dial, &w->clicks);
+    #endif
+    w->clicks += solve_scalar(w->deltas + done, w->n - done, &dial);
+    return NULL;
+}
+
+// One call per worker, the first one on this thread
+static void run_all(void* (*fn)(void*)) {
+    #ifndef _WIN32
+    for (int t = 1; t < worker_count; t++) {
+        workers[t].started =
+            pthread_create(&workers[t].thread, NULL, fn, &workers[t]) == 0;
+    }
+    #endif
+    fn(&workers[0]);
+    for (int t = 1; t < worker_count; t++) {
+        #ifndef _WIN32
+        if (workers[t].started) {
+            pthread_join(workers[t].thread, NULL);
+            continue;
+        }
+        #endif
+        fn(&workers[t]);  // no thread: run it here
+    }
+}
+
+int main(void) {
+    size_t len;
+    const char* input = aoc_map_input(&len);
+
+    AOC_TIMER_START(parse);
+    #if defined(__x86_64__)
+    avx2 = __builtin_cpu_supports("avx2");
+    #endif
+
+    worker_count = cpu_count();
+    size_t useful = len / BYTES_PER_WORKER + 1;
+    if ((size_t)worker_count > useful) worker_count = (int)useful;
+    if (worker_count > MAX_WORKERS) worker_count = MAX_WORKERS;
+
+    // Blocks end right after a newline (or at the end of input)
+    const char* end = input + len;
+    const char* from = input;
+    for (int t = 0; t < worker_count; t++) {
+        const char* to = input + len * (t + 1) / worker_count;
+        if (to < from) to = from;
+        if (t == worker_count - 1) {
+            to = end;
         } else {
-            long fullRot = dist / 100;
-            int rem = (int)(dist - fullRot * 100);
-            count += fullRot + ((rem >= pos) & (pos != 0));
-            pos -= rem;
-            pos += 100 & -(pos < 0);
+            const char* newline = (const char*)memchr(to, '\n', end - to);
+            to = newline ? newline + 1 : end;
         }
+        workers[t].from = from;
+        workers[t].to = to;
+        from = to;
+    }
+
+    run_all(parse_block);
+    AOC_TIMER_END(parse);
+
+    AOC_TIMER_START(solve);
+    // Exclusive scan of the net rotations: where each block starts
+    int32_t start = 50;
+    for (int t = 0; t < worker_count; t++) {
+        workers[t].start = start;
+        start = ((start + workers[t].shift) % 100 + 100) % 100;
     }
 
+    run_all(solve_block);
+
+    long long count = 0;
+    for (int t = 0; t < worker_count; t++) {
+        count += workers[t].turns + workers[t].clicks;
+    }
     AOC_TIMER_END(solve);
 
     AOC_RESULT_INT(count);
-    aoc_cleanup(input);
+    for (int t = 0; t < worker_count; t++) free(workers[t].deltas);
+    aoc_unmap_input(input);
     return 0;
 }
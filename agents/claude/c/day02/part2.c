@@ -1,115 +1,352 @@
 /**
  * 🎄 Advent of Code 2025 - Day 02 Part 2
  * Find IDs that are pattern repeated 2+ times
+ *
+ * Closed form, O(lengths x divisors) per range whatever its width:
+ * an L-digit ID with period p (p | L) is x * M(L, p), x a p-digit pattern
+ * and M(L, p) = (10^L - 1) / (10^p - 1) = 1 + 10^p + 10^2p + ...
+ * Periods overlap (period 1 IDs also have period 2, 3...): inclusion-
+ * exclusion over the proper divisors of L gives each period p the Möbius
+ * coefficient -mu(L / p), so every repeated ID is counted exactly once.
+ * Per period, the sum over a range is M times an arithmetic series.
+ *
+ * Batched for millions of ranges: they are radix-sorted and merged (an
+ * ID in overlapping ranges counts once), split at powers of 10 into
+ * per-length segments, then every term runs over all segments of its
+ * length in one branch-free loop, summed in u64 partials that are
+ * widened to __int128 once every FLUSH_SEGMENTS segments.
  */
 
 #include "../../tools/runner/c/common.h"
 
-static long long POW10[20];
+#define MAX_DIGITS 19  // IDs up to 10^19 - 1
+#define MAX_TERMS 3
+#define SMALL_SORT 64  // insertion sort up to this many ranges
+#define RADIX_BITS 11
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES 6  // 66 bits
+#define FLUSH_SEGMENTS 16  // 16 * 10^18 < 2^64
 
-static inline void init_pow10(void) {
-    POW10[0] = 1;
-    for (int i = 1; i < 20; i++) POW10[i] = POW10[i-1] * 10;
-}
+typedef struct {
+    int period;
+    int sign;       // -mu(L / period)
+    uint64_t mult;  // M(L, period)
+} Term;
+
+typedef struct {
+    int count;
+    Term terms[MAX_TERMS];
+} Length;
+
+// Proper divisors p of L with mu(L / p) != 0
+static const Length LENGTHS[MAX_DIGITS + 1] = {
+    [2] = {1, {{1, +1, 11ull}}},
+    [3] = {1, {{1, +1, 111ull}}},
+    [4] = {1, {{2, +1, 101ull}}},
+    [5] = {1, {{1, +1, 11111ull}}},
+    [6] = {3, {{3, +1, 1001ull}, {2, +1, 10101ull}, {1, -1, 111111ull}}},
+    [7] = {1, {{1, +1, 1111111ull}}},
+    [8] = {1, {{4, +1, 10001ull}}},
+    [9] = {1, {{3, +1, 1001001ull}}},
+    [10] = {3,
+            {{5, +1, 100001ull},
+             {2, +1, 101010101ull},
+             {1, -1, 1111111111ull}}},
+    [11] = {1, {{1, +1, 11111111111ull}}},
+    [12] = {3,
+            {{6, +1, 1000001ull},
+             {4, +1, 100010001ull},
+             {2, -1, 10101010101ull}}},
+    [13] = {1, {{1, +1, 1111111111111ull}}},
+    [14] = {3,
+            {{7, +1, 10000001ull},
+             {2, +1, 1010101010101ull},
+             {1, -1, 11111111111111ull}}},
+    [15] = {3,
+            {{5, +1, 10000100001ull},
+             {3, +1, 1001001001001ull},
+             {1, -1, 111111111111111ull}}},
+    [16] = {1, {{8, +1, 100000001ull}}},
+    [17] = {1, {{1, +1, 11111111111111111ull}}},
+    [18] = {3,
+            {{9, +1, 1000000001ull},
+             {6, +1, 1000001000001ull},
+             {3, -1, 1001001001001001ull}}},
+    [19] = {1, {{1, +1, 1111111111111111111ull}}},
+};
 
-static inline int count_digits(long long n) {
-    if (n < 10) return 1;
-    if (n < 100) return 2;
-    if (n < 1000) return 3;
-    if (n < 10000) return 4;
-    if (n < 100000) return 5;
-    if (n < 1000000) return 6;
-    if (n < 10000000) return 7;
-    if (n < 100000000) return 8;
-    if (n < 1000000000) return 9;
-    if (n < 10000000000LL) return 10;
-    int c = 10;
-    n /= 10000000000LL;
-    while (n) { c++; n /= 10; }
-    return c;
+static const uint64_t POW10[MAX_DIGITS + 1] = {
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull,
+};
+
+// log10 from the bit length (1233 / 4096 ~ log10(2)), then one compare
+static inline int count_digits(uint64_t n) {
+    int bits = 64 - __builtin_clzll(n | 1);
+    int len = (bits * 1233) >> 12;
+    len += len < MAX_DIGITS && n >= POW10[len];
+    return len > 0 ? len : 1;
 }
 
-// Fast hash set with open addressing
-#define HASH_SIZE 16381
-static long long hash_values[HASH_SIZE];
-static char hash_used[HASH_SIZE];
+// Ranges, then segments: struct of arrays for the batch loops
+typedef struct {
+    uint64_t* lo;
+    uint64_t* hi;
+    size_t count;
+} Ranges;
 
-static inline void hash_clear(void) {
-    __builtin_memset(hash_used, 0, HASH_SIZE);
+static void* xmalloc(size_t size) {
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        fprintf(stderr, "ERROR:Out of memory\n");
+        exit(1);
+    }
+    return ptr;
 }
 
-static inline int hash_insert(long long value) {
-    unsigned int idx = (unsigned int)(value % HASH_SIZE);
-    while (hash_used[idx]) {
-        if (hash_values[idx] == value) return 0;
-        idx = (idx + 1) % HASH_SIZE;
+// LSD radix sort by lo, 11 bits per pass (2048 buckets stay in L1).
+// Passes where every key has the same digit are skipped, and so is
+// the whole sort for already sorted input. The puzzle's few dozen
+// ranges skip the histograms altogether.
+static void sort_ranges(Ranges* r) {
+    size_t n = r->count;
+    uint64_t* lo = r->lo;
+    uint64_t* hi = r->hi;
+
+    int sorted = 1;
+    for (size_t i = 1; i < n && sorted; i++) sorted = lo[i - 1] <= lo[i];
+    if (sorted) return;
+
+    if (n <= SMALL_SORT) {
+        for (size_t i = 1; i < n; i++) {
+            uint64_t key = lo[i], value = hi[i];
+            size_t j = i;
+            for (; j > 0 && lo[j - 1] > key; j--) {
+                lo[j] = lo[j - 1];
+                hi[j] = hi[j - 1];
+            }
+            lo[j] = key;
+            hi[j] = value;
+        }
+        return;
+    }
+
+    uint64_t* tmp_lo = (uint64_t*)xmalloc(n * sizeof(uint64_t));
+    uint64_t* tmp_hi = (uint64_t*)xmalloc(n * sizeof(uint64_t));
+    size_t* counts =
+        (size_t*)calloc(RADIX_PASSES * RADIX_SIZE, sizeof(size_t));
+    if (!counts) {
+        fprintf(stderr, "ERROR:Out of memory\n");
+        exit(1);
     }
-    hash_values[idx] = value;
-    hash_used[idx] = 1;
-    return 1;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = lo[i];
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            counts[pass * RADIX_SIZE + (key & (RADIX_SIZE - 1))]++;
+            key >>= RADIX_BITS;
+        }
+    }
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        size_t* count = counts + pass * RADIX_SIZE;
+        int shift = RADIX_BITS * pass;
+        if (count[(lo[0] >> shift) & (RADIX_SIZE - 1)] == n) continue;
+
+        size_t offset = 0;
+        for (int d = 0; d < RADIX_SIZE; d++) {
+            size_t c = count[d];
+            count[d] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t slot = count[(lo[i] >> shift) & (RADIX_SIZE - 1)]++;
+            tmp_lo[slot] = lo[i];
+            tmp_hi[slot] = hi[i];
+        }
+
+        uint64_t* swap = lo;
+        lo = tmp_lo;
+        tmp_lo = swap;
+        swap = hi;
+        hi = tmp_hi;
+        tmp_hi = swap;
+    }
+
+    r->lo = lo;
+    r->hi = hi;
+    free(tmp_lo);
+    free(tmp_hi);
+    free(counts);
 }
 
-// Compute multiplier: 1 + 10^p + 10^2p + ... for r terms
-static inline long long get_multiplier(int patternLen, int repeatCount) {
-    long long mult = 0, power = 1;
-    for (int i = 0; i < repeatCount; i++) {
-        mult += power;
-        power *= POW10[patternLen];
+// Sorted ranges: fold overlapping and adjacent ones, in place
+static void merge_ranges(Ranges* r) {
+    size_t out = 0;
+    for (size_t i = 0; i < r->count; i++) {
+        if (out > 0 && r->lo[i] - 1 <= r->hi[out - 1]) {  // lo >= 1
+            if (r->hi[i] > r->hi[out - 1]) r->hi[out - 1] = r->hi[i];
+            continue;
+        }
+        r->lo[out] = r->lo[i];
+        r->hi[out] = r->hi[i];
+        out++;
     }
-    return mult;
+    r->count = out;
 }
 
-int main(void) {
-    init_pow10();
-    char* input = aoc_read_input();
-    char* ptr = input;
+// Cuts merged ranges at powers of 10, grouped by length:
+// segments of length L are seg[start[L] .. start[L + 1])
+static Ranges split_by_length(const Ranges* r, size_t* start) {
+    size_t counts[MAX_DIGITS + 2] = {0};
+    for (size_t i = 0; i < r->count; i++) {
+        int last = count_digits(r->hi[i]);
+        for (int len = count_digits(r->lo[i]); len <= last; len++) {
+            counts[len]++;
+        }
+    }
 
-    AOC_TIMER_START(solve);
-    long long sum = 0;
+    start[0] = 0;
+    for (int len = 0; len <= MAX_DIGITS; len++) {
+        start[len + 1] = start[len] + counts[len];
+    }
 
-    while (*ptr) {
-        while (*ptr && (*ptr < '0' || *ptr > '9')) ptr++;
-        if (!*ptr) break;
+    Ranges seg;
+    seg.count = start[MAX_DIGITS + 1];
+    seg.lo = (uint64_t*)xmalloc(seg.count * sizeof(uint64_t));
+    seg.hi = (uint64_t*)xmalloc(seg.count * sizeof(uint64_t));
 
-        long long start = 0;
-        while (*ptr >= '0' && *ptr <= '9') start = start * 10 + (*ptr++ - '0');
-        while (*ptr == '-') ptr++;
-        long long endNum = 0;
-        while (*ptr >= '0' && *ptr <= '9') endNum = endNum * 10 + (*ptr++ - '0');
+    size_t fill[MAX_DIGITS + 1];
+    memcpy(fill, start, sizeof(fill));
+    for (size_t i = 0; i < r->count; i++) {
+        uint64_t lo = r->lo[i];
+        uint64_t hi = r->hi[i];
+        int last = count_digits(hi);
+        for (int len = count_digits(lo); len <= last; len++) {
+            size_t s = fill[len]++;
+            seg.lo[s] = lo > POW10[len - 1] ? lo : POW10[len - 1];
+            seg.hi[s] = len < MAX_DIGITS && hi >= POW10[len] ? POW10[len] - 1
+                                                               : hi;
+        }
+    }
+    return seg;
+}
 
-        hash_clear();
+// floor(n / mult) through a float reciprocal: quotients are patterns
+// (< 10^9), so the estimate is off by at most one and fixed up exactly
+static inline uint64_t div_mult(uint64_t n, uint64_t mult, double inv) {
+    uint64_t q = (uint64_t)((double)n * inv);
+    q -= q * mult > n;
+    q += n - q * mult >= mult;
+    return q;
+}
 
-        int startLen = count_digits(start);
-        int endLen = count_digits(endNum);
+// Sum of the patterns x with x * mult in a segment, over all segments of
+// one length. Patterns have at most 9 digits, so a segment adds less than
+// 10^18: FLUSH_SEGMENTS of them fit in a u64 partial, widened to 128 bits
+// once per flush.
+static unsigned __int128 sum_patterns(const uint64_t* lo, const uint64_t* hi,
+                                      size_t count, uint64_t mult) {
+    double inv = 1.0 / (double)mult;
+    unsigned __int128 total = 0;
+    for (size_t i = 0; i < count;) {
+        size_t stop = count - i > FLUSH_SEGMENTS ? i + FLUSH_SEGMENTS : count;
+        uint64_t partial = 0;
+        for (; i < stop; i++) {
+            uint64_t first = div_mult(lo[i] - 1, mult, inv) + 1;
+            uint64_t last = div_mult(hi[i], mult, inv);
+            uint64_t n = last >= first ? last - first + 1 : 0;
+            partial += (n * (first + last)) >> 1;
+        }
+        total += partial;
+    }
+    return total;
+}
+
+static void print_answer(__int128 total) {
+    char buf[64];
+    int i = 63;
+    buf[i] = '\0';
+    do {
+        buf[--i] = (char)('0' + (int)(total % 10));
+        total /= 10;
+    } while (total > 0);
+    printf("ANSWER:%s\n", &buf[i]);
+}
+
+int main(void) {
+    size_t len;
+    const char* input = aoc_map_input(&len);
+    const char* ptr = input;
+    const char* end = input + len;
 
-        for (int totalLen = startLen; totalLen <= endLen; totalLen++) {
-            for (int patternLen = 1; patternLen <= totalLen / 2; patternLen++) {
-                if (totalLen % patternLen != 0) continue;
+    AOC_TIMER_START(parse);
+    // At least 4 bytes per range ("a-b,")
+    Ranges ranges;
+    ranges.lo = (uint64_t*)xmalloc((len / 4 + 1) * sizeof(uint64_t));
+    ranges.hi = (uint64_t*)xmalloc((len / 4 + 1) * sizeof(uint64_t));
+    ranges.count = 0;
 
-                int repeatCount = totalLen / patternLen;
-                if (repeatCount < 2) continue;
+    while (ptr < end) {
+        if (*ptr < '0' || *ptr > '9') {
+            ptr++;
+            continue;
+        }
+        uint64_t lo, hi;
+        ptr = aoc_parse_u64(ptr, &lo);
+        ptr = aoc_parse_u64(ptr + 1, &hi);  // after the dash
+        if (lo == 0) lo = 1;  // no 0-digit IDs
+        if (lo > hi) continue;
+        ranges.lo[ranges.count] = lo;
+        ranges.hi[ranges.count] = hi;
+        ranges.count++;
+    }
 
-                long long multiplier = get_multiplier(patternLen, repeatCount);
-                long long minPattern = POW10[patternLen - 1];
-                long long maxPattern = POW10[patternLen] - 1;
+    sort_ranges(&ranges);
+    merge_ranges(&ranges);
+    size_t start[MAX_DIGITS + 2];
+    Ranges seg = split_by_length(&ranges, start);
+    AOC_TIMER_END(parse);
 
-                long long minFromStart = (start + multiplier - 1) / multiplier;
-                long long maxFromEnd = endNum / multiplier;
-                if (minFromStart > minPattern) minPattern = minFromStart;
-                if (maxFromEnd < maxPattern) maxPattern = maxFromEnd;
+    AOC_TIMER_START(solve);
+    __int128 sum = 0;
 
-                for (long long pattern = minPattern; pattern <= maxPattern; pattern++) {
-                    long long repeated = pattern * multiplier;
-                    if (hash_insert(repeated)) {
-                        sum += repeated;
-                    }
-                }
-            }
+    for (int l = 1; l <= MAX_DIGITS; l++) {
+        size_t from = start[l];
+        size_t count = start[l + 1] - from;
+        if (count == 0) continue;
+        for (int t = 0; t < LENGTHS[l].count; t++) {
+            const Term* term = &LENGTHS[l].terms[t];
+            unsigned __int128 patterns = sum_patterns(
+                seg.lo + from, seg.hi + from, count, term->mult);
+            sum += term->sign * (__int128)(patterns * term->mult);
         }
     }
 
     AOC_TIMER_END(solve);
-    AOC_RESULT_INT(sum);
-    aoc_cleanup(input);
+    print_answer(sum);
+    free(ranges.lo);
+    free(ranges.hi);
+    free(seg.lo);
+    free(seg.hi);
+    aoc_unmap_input(input);
     return 0;
 }
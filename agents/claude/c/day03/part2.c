@@ -1,56 +1,262 @@
 /**
  * 🎄 Advent of Code 2025 - Day 03 Part 2
  * Pick 12 batteries to maximize 12-digit joltage
- * Simple greedy with linear scan
+ *
+ * Engine for any K up to the line length, two ways to pick:
+ *   - greedy: digit j is the first max of the window that still leaves
+ *     K - j - 1 digits after it, found with AVX2 (a '9' ends the search
+ *     early). Up to K * window / 32 steps, fast on short lines, small K
+ *     or lines rich in 9s
+ *   - monotonic stack: a digit pops every smaller one before it while
+ *     enough digits remain. O(n) whatever K, but branchy
+ * Greedy runs first, on a budget of n vectors read. The digits left
+ * to pick after its last one are an independent smaller problem, handed
+ * to the stack, so a line costs O(n) at worst.
+ * Joltages are summed per digit column and carried once at the end, so
+ * K can exceed 19 digits.
+ *
+ * Lines are independent: the input is split in line-aligned blocks, one
+ * per worker, each with its own column sums, added up at the end.
  */
 
+#define _GNU_SOURCE
 #include "../../tools/runner/c/common.h"
 
+#ifndef _WIN32
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 #define K 12
 
-int main(void) {
-    char* input = aoc_read_input();
-    char* ptr = input;
+#define MAX_WORKERS 64
+// Input bytes per worker before another one is worth a thread
+#define BYTES_PER_WORKER (1 << 20)
 
-    AOC_TIMER_START(solve);
-    unsigned long long total = 0;
+typedef struct {
+    const char* from;  // line-aligned block of the input
+    const char* to;
+    uint64_t columns[K];  // sum of each digit position
+    #ifndef _WIN32
+    pthread_t thread;
+    int started;
+    #endif
+} Worker;
+
+static Worker workers[MAX_WORKERS];
+static int worker_count;
+static int avx2;
 
-    while (*ptr) {
-        char* line = ptr;
-        while (*ptr >= '0') ptr++;
-        int len = ptr - line;
+static int cpu_count(void) {
+    #if defined(__linux__)
+    cpu_set_t set;
+    // Respects the runner's core lease (taskset)
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) return CPU_COUNT(&set);
+    #endif
+    #ifndef _WIN32
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+    #else
+    return 1;
+    #endif
+}
 
-        if (len >= K) {
-            unsigned long long joltage = 0;
-            int lastPos = -1;
+// First position of the largest digit in p[0..n)
+static size_t first_max_scalar(const char* p, size_t n) {
+    size_t best = 0;
+    for (size_t i = 1; i < n && p[best] != '9'; i++) {
+        if (p[i] > p[best]) best = i;
+    }
+    return best;
+}
 
-            for (int p = 0; p < K; p++) {
-                int start = lastPos + 1;
-                int end = len - K + p;
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+static size_t first_max_avx2(const char* p, size_t n) {
+    if (n < 32) return first_max_scalar(p, n);
 
-                // Linear scan for max in range
-                int maxIdx = start;
-                char maxVal = line[start];
+    // The last vector overlaps the one before: no byte past the window
+    const __m256i nine = _mm256_set1_epi8('9');
+    __m256i max = _mm256_setzero_si256();
+    for (size_t i = 0; i < n; i += 32) {
+        if (i + 32 > n) i = n - 32;
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        uint32_t nines =
+            (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nine));
+        if (nines) return i + (size_t)__builtin_ctz(nines);
+        max = _mm256_max_epu8(max, v);
+    }
 
-                for (int j = start + 1; j <= end; j++) {
-                    if (line[j] > maxVal) {
-                        maxVal = line[j];
-                        maxIdx = j;
-                    }
-                }
+    __m128i m = _mm_max_epu8(_mm256_castsi256_si128(max),
+                             _mm256_extracti128_si256(max, 1));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+    __m256i target = _mm256_broadcastb_epi8(m);
 
-                joltage = joltage * 10 + (maxVal - '0');
-                lastPos = maxIdx;
-            }
+    for (size_t i = 0;; i += 32) {
+        if (i + 32 > n) i = n - 32;
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+        uint32_t hits =
+            (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target));
+        if (hits) return i + (size_t)__builtin_ctz(hits);
+    }
+}
+#endif
 
-            total += joltage;
+static inline size_t first_max(const char* p, size_t n) {
+    #if defined(__x86_64__)
+    if (avx2) return first_max_avx2(p, n);
+    #endif
+    return first_max_scalar(p, n);
+}
+
+// Best k digits of line[0..len) into out
+static void pick_stack(const char* line, size_t len, size_t k, char* out) {
+    size_t top = 0;
+    size_t drop = len - k;  // digits that can still be left out
+    for (size_t i = 0; i < len; i++) {
+        char c = line[i];
+        while (top > 0 && drop > 0 && out[top - 1] < c) {
+            top--;
+            drop--;
+        }
+        if (top < k) {
+            out[top++] = c;
+        } else {
+            drop--;
+        }
+    }
+}
+
+static void pick(const char* line, size_t len, char* out) {
+    size_t budget = len;  // a vector costs about one stack step
+    size_t spent = 0;
+    size_t start = 0;
+    for (size_t j = 0; j < K; j++) {
+        if (spent > budget) {
+            pick_stack(line + start, len - start, K - j, out + j);
+            return;
         }
 
-        if (*ptr) ptr++;
+        size_t end = len - K + j + 1;  // window [start, end)
+        size_t at = start + first_max(line + start, end - start);
+        out[j] = line[at];
+        // Vectors read: up to the first 9, or the window twice
+        spent += out[j] == '9' ? (at - start) / 32 + 1
+                               : (end - start) / 16 + 1;
+        start = at + 1;
     }
+}
+
+static void* run_block(void* arg) {
+    Worker* w = (Worker*)arg;
+    const char* ptr = w->from;
+    const char* end = w->to;
+    char picked[K];
+
+    while (ptr < end) {
+        const char* line = ptr;
+        const char* eol =
+            (const char*)memchr(ptr, '\n', (size_t)(end - ptr));
+        if (!eol) eol = end;
+        ptr = eol + 1;
+        while (eol > line && eol[-1] < '0') eol--;  // CR
+        size_t n = (size_t)(eol - line);
+        if (n < K) continue;
+
+        pick(line, n, picked);
+        for (size_t j = 0; j < K; j++) {
+            w->columns[j] += (uint64_t)(picked[j] - '0');
+        }
+    }
+    return NULL;
+}
+
+// One call per worker, the first one on this thread
+static void run_all(void* (*fn)(void*)) {
+    #ifndef _WIN32
+    for (int t = 1; t < worker_count; t++) {
+        workers[t].started =
+            pthread_create(&workers[t].thread, NULL, fn, &workers[t]) == 0;
+    }
+    #endif
+    fn(&workers[0]);
+    for (int t = 1; t < worker_count; t++) {
+        #ifndef _WIN32
+        if (workers[t].started) {
+            pthread_join(workers[t].thread, NULL);
+            continue;
+        }
+        #endif
+        fn(&workers[t]);  // no thread: run it here
+    }
+}
+
+int main(void) {
+    size_t len;
+    const char* input = aoc_map_input(&len);
+
+    AOC_TIMER_START(solve);
+    #if defined(__x86_64__)
+    avx2 = __builtin_cpu_supports("avx2");
+    #endif
+
+    worker_count = cpu_count();
+    size_t useful = len / BYTES_PER_WORKER + 1;
+    if ((size_t)worker_count > useful) worker_count = (int)useful;
+    if (worker_count > MAX_WORKERS) worker_count = MAX_WORKERS;
+
+    // Blocks end right after a newline (or at the end of input)
+    const char* end = input + len;
+    const char* from = input;
+    for (int t = 0; t < worker_count; t++) {
+        const char* to = input + len * (t + 1) / worker_count;
+        if (to < from) to = from;
+        if (t == worker_count - 1) {
+            to = end;
+        } else {
+            const char* newline = (const char*)memchr(to, '\n', end - to);
+            to = newline ? newline + 1 : end;
+        }
+        workers[t].from = from;
+        workers[t].to = to;
+        from = to;
+    }
+
+    run_all(run_block);
+
+    uint64_t columns[K] = {0};
+    for (int t = 0; t < worker_count; t++) {
+        for (size_t j = 0; j < K; j++) columns[j] += workers[t].columns[j];
+    }
+
+    // Carry the columns into decimal digits, least significant first
+    char digits[K + 24];
+    size_t count = 0;
+    uint64_t carry = 0;
+    for (size_t j = K; j-- > 0;) {
+        uint64_t v = columns[j] + carry;
+        digits[count++] = (char)('0' + v % 10);
+        carry = v / 10;
+    }
+    while (carry) {
+        digits[count++] = (char)('0' + carry % 10);
+        carry /= 10;
+    }
+    while (count > 1 && digits[count - 1] == '0') count--;
+
+    char answer[K + 25];
+    for (size_t i = 0; i < count; i++) answer[i] = digits[count - 1 - i];
+    answer[count] = '\0';
 
     AOC_TIMER_END(solve);
-    AOC_RESULT_UINT(total);
-    aoc_cleanup(input);
+    AOC_RESULT(answer);
+    aoc_unmap_input(input);
     return 0;
 }
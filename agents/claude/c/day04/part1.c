@@ -1,64 +1,138 @@
 /**
  * 🎄 Advent of Code 2025 - Day 04 Part 1
  * Count rolls (@) with fewer than 4 neighbors
+ *
+ * Bit-sliced grid, as in part 2: 64 cells per word, zero padding around,
+ * neighbor counts of 64 cells from a few adders on whole words. One pass
+ * of popcounts, no size limit.
  */
 
 #include "../../tools/runner/c/common.h"
 
-#define MAX_SIZE 256
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+static uint64_t* grid;
+static size_t stride;  // words per row, padding included
+
+// Rolls of word i with fewer than 4 of their 8 neighbors.
+// Per column, s = up + mid + down (2 bits), m = up + down (2 bits):
+// count = s(west) + s(east) + m, and count >= 4 exactly when at least
+// two of the weight-2 bits (the three high bits and the carry of the
+// three low ones) are set.
+static inline uint64_t accessible(size_t i) {
+    const uint64_t* up = grid + i - stride;
+    const uint64_t* mid = grid + i;
+    const uint64_t* down = grid + i + stride;
+
+    uint64_t s0[3], s1[3];
+    for (int k = 0; k < 3; k++) {
+        uint64_t a = up[k - 1], b = mid[k - 1], c = down[k - 1];
+        s0[k] = a ^ b ^ c;
+        s1[k] = (a & b) | (c & (a ^ b));
+    }
+
+    // West neighbor of bit j is bit j - 1, east is bit j + 1
+    uint64_t w0 = (s0[1] << 1) | (s0[0] >> 63);
+    uint64_t w1 = (s1[1] << 1) | (s1[0] >> 63);
+    uint64_t e0 = (s0[1] >> 1) | (s0[2] << 63);
+    uint64_t e1 = (s1[1] >> 1) | (s1[2] << 63);
+    uint64_t m0 = up[0] ^ down[0];
+    uint64_t m1 = up[0] & down[0];
+
+    uint64_t carry = (w0 & e0) | (m0 & (w0 ^ e0));
+    uint64_t four = (w1 & e1) | (m1 & carry) | ((w1 ^ e1) & (m1 ^ carry));
+    return mid[0] & ~four;
+}
+
+// Bits of the '@' among the first n (<= 64) bytes
+static inline uint64_t pack_scalar(const char* p, size_t n) {
+    uint64_t bits = 0;
+    for (size_t j = 0; j < n; j++) bits |= (uint64_t)(p[j] == '@') << j;
+    return bits;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+static inline uint64_t pack_avx2(const char* p) {
+    const __m256i roll = _mm256_set1_epi8('@');
+    __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+    uint32_t l = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, roll));
+    uint32_t h = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, roll));
+    return (uint64_t)h << 32 | l;
+}
+#endif
+
+static void* xcalloc(size_t count, size_t size) {
+    void* ptr = calloc(count, size);
+    if (!ptr) {
+        fprintf(stderr, "ERROR:Out of memory\n");
+        exit(1);
+    }
+    return ptr;
+}
 
 int main(void) {
-    char* input = aoc_read_input();
+    size_t len;
+    const char* input = aoc_map_input(&len);
+    const char* end = input + len;
 
     AOC_TIMER_START(solve);
 
-    // Find grid dimensions
-    int cols = 0;
-    while (input[cols] && input[cols] != '\n') cols++;
-    int rows = 0;
-    char* ptr = input;
-    while (*ptr) {
-        if (*ptr == '\n') rows++;
-        ptr++;
+    // Grid dimensions: width of the first line, number of non-empty lines
+    const char* eol = (const char*)memchr(input, '\n', len);
+    size_t cols = (size_t)((eol ? eol : end) - input);
+    if (cols > 0 && input[cols - 1] == '\r') cols--;
+    size_t rows = 0;
+    for (const char* p = input; p < end;) {
+        const char* next = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!next) next = end;
+        if (next > p && *p != '\r') rows++;
+        p = next + 1;
+    }
+
+    size_t words = (cols + 63) / 64;
+    stride = words + 2;
+    grid = (uint64_t*)xcalloc((rows + 2) * stride, sizeof(uint64_t));
+
+    #if defined(__x86_64__)
+    int avx2 = __builtin_cpu_supports("avx2");
+    #endif
+    const char* line = input;
+    for (size_t r = 1; r <= rows; r++) {
+        uint64_t* row = grid + r * stride + 1;
+        size_t n = cols;
+        const char* eol_r =
+            (const char*)memchr(line, '\n', (size_t)(end - line));
+        if (!eol_r) eol_r = end;
+        if ((size_t)(eol_r - line) < n) n = (size_t)(eol_r - line);
+
+        size_t w = 0;
+        #if defined(__x86_64__)
+        if (avx2) {
+            for (; (w + 1) * 64 <= n; w++) row[w] = pack_avx2(line + w * 64);
+        }
+        #endif
+        for (; w * 64 < n; w++) {
+            size_t take = n - w * 64 < 64 ? n - w * 64 : 64;
+            row[w] = pack_scalar(line + w * 64, take);
+        }
+        line = eol_r + 1;
     }
-    if (ptr > input && *(ptr-1) != '\n') rows++;
-
-    // Direct pointer access to grid
-    // Each row is cols+1 chars (including newline)
-    int stride = cols + 1;
-
-    int count = 0;
-
-    for (int r = 0; r < rows; r++) {
-        for (int c = 0; c < cols; c++) {
-            if (input[r * stride + c] != '@') continue;
-
-            // Count neighbors (8 directions) - unrolled for speed
-            int neighbors = 0;
-
-            // Top row
-            if (r > 0) {
-                if (c > 0 && input[(r-1) * stride + c - 1] == '@') neighbors++;
-                if (input[(r-1) * stride + c] == '@') neighbors++;
-                if (c < cols-1 && input[(r-1) * stride + c + 1] == '@') neighbors++;
-            }
-            // Middle row
-            if (c > 0 && input[r * stride + c - 1] == '@') neighbors++;
-            if (c < cols-1 && input[r * stride + c + 1] == '@') neighbors++;
-            // Bottom row
-            if (r < rows-1) {
-                if (c > 0 && input[(r+1) * stride + c - 1] == '@') neighbors++;
-                if (input[(r+1) * stride + c] == '@') neighbors++;
-                if (c < cols-1 && input[(r+1) * stride + c + 1] == '@') neighbors++;
-            }
-
-            if (neighbors < 4) count++;
+
+    long long count = 0;
+    for (size_t r = 1; r <= rows; r++) {
+        for (size_t w = 1; w <= words; w++) {
+            count += __builtin_popcountll(accessible(r * stride + w));
         }
     }
 
     AOC_TIMER_END(solve);
 
     AOC_RESULT_INT(count);
-    aoc_cleanup(input);
+    free(grid);
+    aoc_unmap_input(input);
     return 0;
 }
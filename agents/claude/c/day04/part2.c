@@ -1,99 +1,359 @@
 /**
  * 🎄 Advent of Code 2025 - Day 04 Part 2
- * Simulate removing rolls with BFS optimization
+ * Simulate removing rolls until none is accessible
+ *
+ * Bit-sliced grid: 64 cells per word, a zero word on each side of every
+ * row and a zero row above and below, so no cell needs a bounds check.
+ * Neighbor counts of 64 cells come from a few adders on whole words
+ * (see accessible). Removal is monotonic, so words are updated in place
+ * and waves only revisit the dirty words around the last removals.
+ * No size limit: a 10^4 x 10^4 grid is 1.6M words.
+ *
+ * Large grids run on all cores, split in row bands. Each band owns its
+ * rows plus a copy of the row above and below it (halos), and removes
+ * until nothing in it changes. Then, between two barriers, every band
+ * refreshes its halos from its neighbors and re-checks the words next
+ * to the cells they lost. It stops when no band has anything left.
  */
 
+#define _GNU_SOURCE
 #include "../../tools/runner/c/common.h"
-#include <string.h>
 
-#define MAX_SIZE 256
-#define MAX_QUEUE (MAX_SIZE * MAX_SIZE)
+#ifndef _WIN32
+#include <sched.h>
+#include <unistd.h>
+#endif
 
-// Direction offsets: 8 neighbors
-static const int DR[] = {-1, -1, -1, 0, 0, 1, 1, 1};
-static const int DC[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
-int main(void) {
-    char* input = aoc_read_input();
+#define MAX_WORKERS 64
+// Input bytes per band before another one is worth a thread
+#define BYTES_PER_WORKER (1 << 20)
 
-    AOC_TIMER_START(solve);
+typedef struct {
+    size_t first;    // first grid row of the band (0-based)
+    size_t rows;
+    uint64_t* grid;  // rows + 2 rows of stride words: halo, band, halo
+    uint32_t* frontier;
+    uint32_t* next;
+    uint8_t* queued;
+    size_t count;    // words in frontier
+    long long removed;
+    int pending;     // work left after the last halo exchange
+    #ifndef _WIN32
+    pthread_t thread;
+    #endif
+} Band;
+
+static Band bands[MAX_WORKERS];
+static int band_count;
+static int avx2;
+
+static const char* input;
+static size_t input_len;
+static size_t line_len;  // bytes per line, newline included
+static size_t cols;
+static size_t words;     // words per row, padding excluded
+static size_t stride;    // words per row, padding included
+
+#ifndef _WIN32
+// Barrier by hand (no pthread_barrier_t on macOS); the same lock and
+// condition hold the threads until the bands are laid out
+static pthread_mutex_t sync_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sync_cond = PTHREAD_COND_INITIALIZER;
+static int sync_waiting;
+static unsigned sync_phase;
+static int started;
+#endif
 
-    // Find grid dimensions
-    int cols = 0;
-    while (input[cols] && input[cols] != '\n') cols++;
-    int rows = 0;
-    char* ptr = input;
-    while (*ptr) {
-        if (*ptr == '\n') rows++;
-        ptr++;
+static void sync_bands(void) {
+    #ifndef _WIN32
+    if (band_count == 1) return;
+    pthread_mutex_lock(&sync_lock);
+    unsigned phase = sync_phase;
+    if (++sync_waiting == band_count) {
+        sync_waiting = 0;
+        sync_phase++;
+        pthread_cond_broadcast(&sync_cond);
+    } else {
+        while (phase == sync_phase) pthread_cond_wait(&sync_cond, &sync_lock);
     }
-    if (ptr > input && *(ptr-1) != '\n') rows++;
+    pthread_mutex_unlock(&sync_lock);
+    #endif
+}
 
-    int stride = cols + 1;
+static int cpu_count(void) {
+    #if defined(__linux__)
+    cpu_set_t set;
+    // Respects the runner's core lease (taskset)
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) return CPU_COUNT(&set);
+    #endif
+    #ifndef _WIN32
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+    #else
+    return 1;
+    #endif
+}
 
-    // Copy grid for modification (use '.' for removed)
-    static char grid[MAX_SIZE * MAX_SIZE];
-    for (int r = 0; r < rows; r++) {
-        memcpy(&grid[r * cols], &input[r * stride], cols);
+static void* xcalloc(size_t count, size_t size) {
+    void* ptr = calloc(count, size);
+    if (!ptr) {
+        fprintf(stderr, "ERROR:Out of memory\n");
+        exit(1);
     }
+    return ptr;
+}
 
-    // Count neighbors helper macro
-    #define COUNT_NEIGHBORS(r, c) ({ \
-        int n = 0; \
-        for (int d = 0; d < 8; d++) { \
-            int nr = (r) + DR[d], nc = (c) + DC[d]; \
-            if (nr >= 0 && nr < rows && nc >= 0 && nc < cols && grid[nr * cols + nc] == '@') n++; \
-        } \
-        n; \
-    })
-
-    // Queue for BFS
-    static int queue[MAX_QUEUE];
-    static char inQueue[MAX_SIZE * MAX_SIZE];
-    memset(inQueue, 0, rows * cols);
-
-    int head = 0, tail = 0;
-
-    // Initial pass: find all accessible rolls
-    for (int r = 0; r < rows; r++) {
-        for (int c = 0; c < cols; c++) {
-            if (grid[r * cols + c] == '@' && COUNT_NEIGHBORS(r, c) < 4) {
-                queue[tail++] = r * cols + c;
-                inQueue[r * cols + c] = 1;
-            }
+// Rolls of word i with fewer than 4 of their 8 neighbors.
+// Per column, s = up + mid + down (2 bits), m = up + down (2 bits):
+// count = s(west) + s(east) + m, and count >= 4 exactly when at least
+// two of the weight-2 bits (the three high bits and the carry of the
+// three low ones) are set.
+static inline uint64_t accessible(const uint64_t* grid, size_t i) {
+    const uint64_t* up = grid + i - stride;
+    const uint64_t* mid = grid + i;
+    const uint64_t* down = grid + i + stride;
+
+    uint64_t s0[3], s1[3];
+    for (int k = 0; k < 3; k++) {
+        uint64_t a = up[k - 1], b = mid[k - 1], c = down[k - 1];
+        s0[k] = a ^ b ^ c;
+        s1[k] = (a & b) | (c & (a ^ b));
+    }
+
+    // West neighbor of bit j is bit j - 1, east is bit j + 1
+    uint64_t w0 = (s0[1] << 1) | (s0[0] >> 63);
+    uint64_t w1 = (s1[1] << 1) | (s1[0] >> 63);
+    uint64_t e0 = (s0[1] >> 1) | (s0[2] << 63);
+    uint64_t e1 = (s1[1] >> 1) | (s1[2] << 63);
+    uint64_t m0 = up[0] ^ down[0];
+    uint64_t m1 = up[0] & down[0];
+
+    uint64_t carry = (w0 & e0) | (m0 & (w0 ^ e0));
+    uint64_t four = (w1 & e1) | (m1 & carry) | ((w1 ^ e1) & (m1 ^ carry));
+    return mid[0] & ~four;
+}
+
+// Bits of the '@' among the first n (<= 64) bytes
+static inline uint64_t pack_scalar(const char* p, size_t n) {
+    uint64_t bits = 0;
+    for (size_t j = 0; j < n; j++) bits |= (uint64_t)(p[j] == '@') << j;
+    return bits;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+static inline uint64_t pack_avx2(const char* p) {
+    const __m256i roll = _mm256_set1_epi8('@');
+    __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+    uint32_t l = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, roll));
+    uint32_t h = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, roll));
+    return (uint64_t)h << 32 | l;
+}
+#endif
+
+// Queues word j of the band unless empty or already queued
+static inline void push(Band* b, size_t j) {
+    if (b->grid[j] && !b->queued[j]) {
+        b->queued[j] = 1;
+        b->next[b->count++] = (uint32_t)j;
+    }
+}
+
+static inline void swap_frontier(Band* b) {
+    uint32_t* swap = b->frontier;
+    b->frontier = b->next;
+    b->next = swap;
+}
+
+// Packs the band's rows, all non-empty words queued for the first wave
+static void load_band(Band* b) {
+    size_t cells = (b->rows + 2) * stride;
+    b->grid = (uint64_t*)xcalloc(cells, sizeof(uint64_t));
+    b->frontier = (uint32_t*)xcalloc(cells, sizeof(uint32_t));
+    b->next = (uint32_t*)xcalloc(cells, sizeof(uint32_t));
+    b->queued = (uint8_t*)xcalloc(cells, 1);
+
+    for (size_t r = 1; r <= b->rows; r++) {
+        size_t offset = (b->first + r - 1) * line_len;
+        const char* line = input + offset;
+        size_t n = input_len - offset < cols ? input_len - offset : cols;
+        uint64_t* row = b->grid + r * stride + 1;
+
+        size_t w = 0;
+        #if defined(__x86_64__)
+        if (avx2) {
+            for (; (w + 1) * 64 <= n; w++) row[w] = pack_avx2(line + w * 64);
+        }
+        #endif
+        for (; w * 64 < n; w++) {
+            size_t take = n - w * 64 < 64 ? n - w * 64 : 64;
+            row[w] = pack_scalar(line + w * 64, take);
         }
     }
 
-    int totalRemoved = 0;
-
-    while (head < tail) {
-        int key = queue[head++];
-        int r = key / cols, c = key % cols;
-        inQueue[key] = 0;
-
-        // Check if still accessible
-        if (grid[key] != '@' || COUNT_NEIGHBORS(r, c) >= 4) continue;
-
-        // Remove this roll
-        grid[key] = '.';
-        totalRemoved++;
-
-        // Check neighbors
-        for (int d = 0; d < 8; d++) {
-            int nr = r + DR[d], nc = c + DC[d];
-            if (nr >= 0 && nr < rows && nc >= 0 && nc < cols) {
-                int nkey = nr * cols + nc;
-                if (grid[nkey] == '@' && !inQueue[nkey] && COUNT_NEIGHBORS(nr, nc) < 4) {
-                    queue[tail++] = nkey;
-                    inQueue[nkey] = 1;
-                }
+    b->count = 0;
+    for (size_t r = 1; r <= b->rows; r++) {
+        for (size_t w = 1; w <= words; w++) push(b, r * stride + w);
+    }
+}
+
+// Removal waves until nothing in the band changes
+static void drain(Band* b) {
+    size_t first = stride;  // band rows only, halos are read-only
+    size_t last = (b->rows + 1) * stride;
+
+    while (b->count > 0) {
+        size_t count = b->count;
+        b->count = 0;
+        for (size_t f = 0; f < count; f++) {
+            size_t i = b->frontier[f];
+            b->queued[i] = 0;
+            uint64_t gone = accessible(b->grid, i);
+            if (!gone) continue;
+
+            b->grid[i] &= ~gone;
+            b->removed += __builtin_popcountll(gone);
+
+            // Words whose cells saw a neighbor go: the column above and
+            // below, and the side words when an edge bit went
+            size_t west = gone & 1, east = gone >> 63;
+            for (size_t r = i - stride; r <= i + stride; r += stride) {
+                if (r < first || r >= last) continue;
+                for (size_t j = r - west; j <= r + east; j++) push(b, j);
             }
         }
+        swap_frontier(b);
+    }
+}
+
+// Copies a neighbor's edge row into a halo row, queuing the words of the
+// band's own edge row next to the cells that went
+static void refresh_halo(Band* b, size_t halo, size_t edge,
+                         const uint64_t* src) {
+    uint64_t* dst = b->grid + halo * stride;
+    for (size_t w = 1; w <= words; w++) {
+        uint64_t gone = dst[w] & ~src[w];
+        if (gone) {
+            size_t i = edge * stride + w;
+            if (gone & 1) push(b, i - 1);
+            push(b, i);
+            if (gone >> 63) push(b, i + 1);
+        }
+        dst[w] = src[w];
+    }
+}
+
+// Halos of band t from the current edge rows of its neighbors, then the
+// queued words become the next wave
+static void exchange(int t) {
+    Band* b = &bands[t];
+    if (t > 0) {
+        const Band* above = &bands[t - 1];
+        refresh_halo(b, 0, 1, above->grid + above->rows * stride);
+    }
+    if (t < band_count - 1) {
+        const Band* below = &bands[t + 1];
+        refresh_halo(b, b->rows + 1, b->rows, below->grid + stride);
+    }
+    swap_frontier(b);
+}
+
+static void* run_band(void* arg) {
+    Band* b = (Band*)arg;
+    int t = (int)(b - bands);
+
+    #ifndef _WIN32
+    pthread_mutex_lock(&sync_lock);
+    while (!started) pthread_cond_wait(&sync_cond, &sync_lock);
+    pthread_mutex_unlock(&sync_lock);
+    #endif
+
+    load_band(b);
+
+    for (;;) {
+        // Nobody removes while the edge rows are copied
+        sync_bands();
+        exchange(t);
+        b->pending = b->count > 0;
+        sync_bands();
+
+        int pending = 0;
+        for (int u = 0; u < band_count; u++) pending |= bands[u].pending;
+        if (!pending) break;
+        drain(b);
+    }
+    return NULL;
+}
+
+int main(void) {
+    input = aoc_map_input(&input_len);
+
+    AOC_TIMER_START(solve);
+    #if defined(__x86_64__)
+    avx2 = __builtin_cpu_supports("avx2");
+    #endif
+
+    // Rectangular grid: every line as long as the first one
+    const char* eol = (const char*)memchr(input, '\n', input_len);
+    cols = eol ? (size_t)(eol - input) : input_len;
+    line_len = cols + 1;
+    if (cols > 0 && input[cols - 1] == '\r') cols--;
+    size_t rows = (input_len + line_len - 1) / line_len;
+    words = (cols + 63) / 64;
+    stride = words + 2;
+
+    band_count = cpu_count();
+    size_t useful = input_len / BYTES_PER_WORKER + 1;
+    if ((size_t)band_count > useful) band_count = (int)useful;
+    if ((size_t)band_count > rows) band_count = rows ? (int)rows : 1;
+    if (band_count > MAX_WORKERS) band_count = MAX_WORKERS;
+
+    // Threads first: if one fails, fewer and wider bands
+    #ifndef _WIN32
+    for (int t = 1; t < band_count; t++) {
+        if (pthread_create(&bands[t].thread, NULL, run_band, &bands[t])) {
+            band_count = t;
+            break;
+        }
+    }
+    #endif
+
+    for (int t = 0; t < band_count; t++) {
+        bands[t].first = rows * t / band_count;
+        bands[t].rows = rows * (t + 1) / band_count - bands[t].first;
+    }
+
+    #ifndef _WIN32
+    pthread_mutex_lock(&sync_lock);
+    started = 1;
+    pthread_cond_broadcast(&sync_cond);
+    pthread_mutex_unlock(&sync_lock);
+    #endif
+
+    run_band(&bands[0]);
+
+    long long removed = 0;
+    for (int t = 0; t < band_count; t++) {
+        #ifndef _WIN32
+        if (t > 0) pthread_join(bands[t].thread, NULL);
+        #endif
+        removed += bands[t].removed;
     }
 
     AOC_TIMER_END(solve);
 
-    AOC_RESULT_INT(totalRemoved);
-    aoc_cleanup(input);
+    AOC_RESULT_INT(removed);
+    for (int t = 0; t < band_count; t++) {
+        free(bands[t].grid);
+        free(bands[t].frontier);
+        free(bands[t].next);
+        free(bands[t].queued);
+    }
+    aoc_unmap_input(input);
     return 0;
 }
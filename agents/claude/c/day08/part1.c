@@ -30,8 +30,9 @@ typedef struct {
 } Pair;
 
 static Point points[MAX_POINTS];
-static Pair pairs_a[MAX_PAIRS];
-static Pair pairs_b[MAX_PAIRS];
+// ~4 MB each: huge pages when available (aoc_alloc_large)
+static Pair* pairs_a;
+static Pair* pairs_b;
 static int parent[MAX_POINTS];
 static int sizes[MAX_POINTS];
 
@@ -60,6 +61,7 @@ static inline void uf_union(int x, int y) {
     int rx = uf_find(x);
     int ry = uf_find(y);
     if (rx != ry) {
+        AOC_COUNT(unions);
         // Always attach smaller to larger (union by size)
         if (sizes[rx] < sizes[ry]) {
             parent[rx] = ry;
@@ -135,6 +137,12 @@ static Pair* radix_sort_pairs(Pair* src, Pair* dst, int count) {
 int main(void) {
     char* input = aoc_read_input();
 
+    AocPages pages_a, pages_b;
+    pairs_a = (Pair*)aoc_alloc_large(MAX_PAIRS * sizeof(Pair), &pages_a);
+    pairs_b = (Pair*)aoc_alloc_large(MAX_PAIRS * sizeof(Pair), &pages_b);
+    AOC_REPORT_PAGES(pairs_a, pages_a);
+    AOC_REPORT_PAGES(pairs_b, pages_b);
+
     AOC_TIMER_START(parse);
 
     const char* p = input;
@@ -213,6 +221,8 @@ int main(void) {
 
     AOC_RESULT_INT(result);
 
+    aoc_free_large(pairs_a, MAX_PAIRS * sizeof(Pair));
+    aoc_free_large(pairs_b, MAX_PAIRS * sizeof(Pair));
     aoc_cleanup(input);
     return 0;
 }
@@ -186,6 +186,7 @@ int main(void) {
             int minY = y1 < y2 ? y1 : y2;
             int maxY = y1 > y2 ? y1 : y2;
 
+            AOC_COUNT(rects_checked);
             if (isValidRect(minX, maxX, minY, maxY)) {
                 maxArea = area;
             }
@@ -26,6 +26,7 @@ static int numPivots, numFree, upperBound;
 static long long minSum;
 
 static void search(int idx, int freeVals[], int freeSum) {
+    AOC_COUNT(branches);
     if (freeSum >= minSum) return;
 
     if (idx == numFree) {
@@ -107,6 +107,7 @@ static void gen_orientations(int8_t* orig_r, int8_t* orig_c, int n, ShapeType* s
 }
 
 static bool solve(uint8_t* pieces, int num_pieces, int idx, int h, int w, int min_pos) {
+    AOC_COUNT(nodes);
     if (idx >= num_pieces) return true;
 
     int type = pieces[idx];
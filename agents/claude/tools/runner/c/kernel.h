@@ -0,0 +1,186 @@
+/**
+ * 🎄 AoC 2025 Battle Royale - Kernel Microbenchmarks
+ *
+ * Compares several implementations of the same kernel (one agent's
+ * variants, or the same step from several agents) on one prepared input.
+ *
+ * Usage:
+ *   #include "../../tools/runner/c/kernel.h"
+ *
+ *   typedef struct { int n; int32_t xs[1024], ys[1024]; } Points;
+ *
+ *   static uint64_t scalar(const void* ctx) { const Points* p = ctx; ... }
+ *   static uint64_t simd(const void* ctx) { ... }
+ *
+ *   int main(void) {
+ *     char* input = aoc_read_input();
+ *     static Points points;
+ *     // ... parse input into points ...
+ *
+ *     aoc_kernel_register("gemini/scalar", scalar);  // reference
+ *     aoc_kernel_register("gemini/simd", simd);
+ *     return aoc_kernel_main(&points);
+ *   }
+ *
+ * Each kernel is warmed up, its calls per sample are calibrated so that a
+ * sample lasts AOC_KERNEL_SAMPLE_MS, then AOC_KERNEL_SAMPLES samples are
+ * timed. Answers are cross-checked against the first kernel. One line per
+ * kernel, times per call in ns (read by `aoc kernels`):
+ *   KERNEL:<name>:iters=..,samples=..,min_ns=..,median_ns=..,mean_ns=..,
+ *     max_ns=..,stddev_ns=..,ok=1,answer=<value>
+ *
+ * The sample count, sample and warmup durations can be overridden at run
+ * time with AOC_KERNEL_SAMPLES, AOC_KERNEL_SAMPLE_MS, AOC_KERNEL_WARMUP_MS.
+ */
+
+#ifndef AOC_KERNEL_H
+#define AOC_KERNEL_H
+
+#include "common.h"
+
+#ifndef AOC_KERNEL_MAX
+#define AOC_KERNEL_MAX 64
+#endif
+#ifndef AOC_KERNEL_SAMPLES
+#define AOC_KERNEL_SAMPLES 20
+#endif
+#ifndef AOC_KERNEL_SAMPLE_MS
+#define AOC_KERNEL_SAMPLE_MS 10.0
+#endif
+#ifndef AOC_KERNEL_WARMUP_MS
+#define AOC_KERNEL_WARMUP_MS 50.0
+#endif
+
+// Kernel signature: prepared input in, answer out
+typedef uint64_t (*AocKernelFn)(const void* ctx);
+
+typedef struct {
+    const char* name;
+    AocKernelFn fn;
+} AocKernel;
+
+static AocKernel _aoc_kernels[AOC_KERNEL_MAX];
+static int _aoc_kernel_count = 0;
+
+// Keeps the compiler from dropping calls whose answer is unused
+static volatile uint64_t _aoc_kernel_sink;
+
+// Names must not contain ':', ',' or '='
+static inline void aoc_kernel_register(const char* name, AocKernelFn fn) {
+    if (_aoc_kernel_count >= AOC_KERNEL_MAX) {
+        printf("ERROR:Too many kernels (AOC_KERNEL_MAX=%d)\n", AOC_KERNEL_MAX);
+        exit(1);
+    }
+    _aoc_kernels[_aoc_kernel_count].name = name;
+    _aoc_kernels[_aoc_kernel_count].fn = fn;
+    _aoc_kernel_count++;
+}
+
+static inline double aoc_kernel_env(const char* name, double fallback) {
+    const char* value = getenv(name);
+    if (!value || !*value) return fallback;
+    double parsed = atof(value);
+    return parsed > 0 ? parsed : fallback;
+}
+
+// Newton's method: keeps libm (-lm) out of the build
+static inline double aoc_kernel_sqrt(double x) {
+    if (x <= 0) return 0;
+    double r = x > 1 ? x : 1;
+    for (int i = 0; i < 64; i++) r = (r + x / r) / 2;
+    return r;
+}
+
+static int aoc_kernel_compare(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Time `iters` calls, returns ms
+static inline double aoc_kernel_time(const AocKernel* kernel, const void* ctx,
+                                     uint64_t iters) {
+    AocTimer timer;
+    uint64_t acc = 0;
+    aoc_timer_start(&timer);
+    for (uint64_t i = 0; i < iters; i++) acc += kernel->fn(ctx);
+    double ms = aoc_timer_end(&timer);
+    _aoc_kernel_sink = acc;
+    return ms;
+}
+
+/**
+ * Benchmark every registered kernel on `ctx`. Returns 1 when a kernel's
+ * answer differs from the first one, 0 otherwise.
+ */
+static inline int aoc_kernel_main(const void* ctx) {
+    int samples = (int)aoc_kernel_env("AOC_KERNEL_SAMPLES", AOC_KERNEL_SAMPLES);
+    double sample_ms =
+        aoc_kernel_env("AOC_KERNEL_SAMPLE_MS", AOC_KERNEL_SAMPLE_MS);
+    double warmup_ms =
+        aoc_kernel_env("AOC_KERNEL_WARMUP_MS", AOC_KERNEL_WARMUP_MS);
+
+    if (_aoc_kernel_count == 0) {
+        AOC_ERROR("No kernel registered");
+        return 1;
+    }
+
+    double* times = (double*)malloc((size_t)samples * sizeof(double));
+    if (!times) {
+        AOC_ERROR("Failed to allocate samples");
+        return 1;
+    }
+
+    uint64_t reference = 0;
+    int mismatch = 0;
+
+    for (int k = 0; k < _aoc_kernel_count; k++) {
+        const AocKernel* kernel = &_aoc_kernels[k];
+
+        // Warmup (caches, branch predictors, frequency), also measures
+        // the cost of one call to calibrate the samples
+        uint64_t answer = kernel->fn(ctx);
+        uint64_t calls = 1;
+        double spent = 0;
+        while (spent < warmup_ms) {
+            spent += aoc_kernel_time(kernel, ctx, calls);
+            calls *= 2;
+        }
+        double call_ms = spent / (double)(calls - 1);
+        uint64_t iters = call_ms > 0 ? (uint64_t)(sample_ms / call_ms) + 1 : 1;
+
+        if (k == 0) reference = answer;
+        int ok = answer == reference;
+        if (!ok) mismatch = 1;
+
+        for (int s = 0; s < samples; s++) {
+            times[s] = aoc_kernel_time(kernel, ctx, iters) * 1e6 / (double)iters;
+        }
+        qsort(times, (size_t)samples, sizeof(double), aoc_kernel_compare);
+
+        double mean = 0;
+        for (int s = 0; s < samples; s++) mean += times[s];
+        mean /= samples;
+        double variance = 0;
+        for (int s = 0; s < samples; s++) {
+            variance += (times[s] - mean) * (times[s] - mean);
+        }
+        double stddev = samples > 1 ? aoc_kernel_sqrt(variance / (samples - 1)) : 0;
+        double median = samples % 2
+            ? times[samples / 2]
+            : (times[samples / 2 - 1] + times[samples / 2]) / 2;
+
+        printf("KERNEL:%s:iters=%llu,samples=%d,min_ns=%.3f,median_ns=%.3f,"
+               "mean_ns=%.3f,max_ns=%.3f,stddev_ns=%.3f,ok=%d,answer=%llu\n",
+               kernel->name, (unsigned long long)iters, samples, times[0],
+               median, mean, times[samples - 1], stddev, ok,
+               (unsigned long long)answer);
+        fflush(stdout);
+    }
+
+    free(times);
+    AOC_RESULT_UINT(reference);
+    return mismatch;
+}
+
+#endif // AOC_KERNEL_H
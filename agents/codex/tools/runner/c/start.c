@@ -0,0 +1,87 @@
+/**
+ * 🎄 AoC 2025 Battle Royale - Minimal startup (nostart build mode)
+ *
+ * Linked instead of the libc startup files when a solver is built with
+ * AOC_C_BUILD=nostart (-static -nostdlib): no dynamic loader, no libc
+ * init, no stdio buffers. `_start` calls main() and exits with its
+ * return value. Such solvers cannot use libc: see nolibc.h for I/O and
+ * timing. The runner falls back to a static build for solvers that do.
+ *
+ * Linux x86_64 and aarch64 only.
+ */
+
+#include "nolibc.h"
+
+int main(int argc, char** argv, char** envp);
+
+// Called by _start with the initial stack: argc, argv[], NULL, envp[]
+__attribute__((used, noreturn)) void aoc_start(long* sp) {
+    int argc = (int)sp[0];
+    char** argv = (char**)(sp + 1);
+    aoc_sys_exit(main(argc, argv, argv + argc + 1));
+}
+
+#if defined(__x86_64__)
+__asm__(".text\n"
+        ".global _start\n"
+        "_start:\n"
+        "  xor %rbp, %rbp\n"
+        "  mov %rsp, %rdi\n"
+        "  and $-16, %rsp\n"
+        "  call aoc_start\n"
+        "  hlt\n");
+#elif defined(__aarch64__)
+__asm__(".text\n"
+        ".global _start\n"
+        "_start:\n"
+        "  mov x29, #0\n"
+        "  mov x30, #0\n"
+        "  mov x0, sp\n"
+        "  bl aoc_start\n");
+#endif
+
+// ═══════════════════════════════════════════════════════════════
+// Compiler support
+// ═══════════════════════════════════════════════════════════════
+// The compiler emits calls to these for struct copies and large
+// initializers. The empty asm keeps it from turning the loops back into
+// memcpy/memset calls.
+
+__attribute__((weak)) void* memcpy(void* dest, const void* src, size_t n) {
+    unsigned char* d = dest;
+    const unsigned char* s = src;
+    for (size_t i = 0; i < n; i++) {
+        d[i] = s[i];
+        __asm__("" : "+r"(d));
+    }
+    return dest;
+}
+
+__attribute__((weak)) void* memmove(void* dest, const void* src, size_t n) {
+    unsigned char* d = dest;
+    const unsigned char* s = src;
+    if (d < s) return memcpy(dest, src, n);
+    for (size_t i = n; i > 0; i--) {
+        d[i - 1] = s[i - 1];
+        __asm__("" : "+r"(d));
+    }
+    return dest;
+}
+
+__attribute__((weak)) void* memset(void* dest, int c, size_t n) {
+    unsigned char* d = dest;
+    for (size_t i = 0; i < n; i++) {
+        d[i] = (unsigned char)c;
+        __asm__("" : "+r"(d));
+    }
+    return dest;
+}
+
+__attribute__((weak)) int memcmp(const void* a, const void* b, size_t n) {
+    const unsigned char* x = a;
+    const unsigned char* y = b;
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] != y[i]) return x[i] - y[i];
+    }
+    return 0;
+}
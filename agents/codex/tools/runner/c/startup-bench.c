@@ -0,0 +1,123 @@
+/**
+ * 🎄 AoC 2025 Battle Royale - Startup cost benchmark
+ *
+ * Usage: startup-bench <binary> <runs>
+ *
+ * Spawns the empty solver (startup.c) `runs` times and measures, from just
+ * before posix_spawn():
+ *   - exec_to_main : until main() starts (loader + libc init)
+ *   - exec_to_exit : until the process has been reaped
+ * Prints the median and minimum of each, in µs, as PERF: lines.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* name, uint64_t* samples, int n) {
+    qsort(samples, (size_t)n, sizeof(uint64_t), compare_u64);
+    printf("PERF:%s_us:%.3f\n", name, samples[n / 2] / 1000.0);
+    printf("PERF:%s_min_us:%.3f\n", name, samples[0] / 1000.0);
+}
+
+// One spawn of the empty solver, 0 on success
+static int run_once(const char* binary, uint64_t* to_main, uint64_t* to_exit) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], 1);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+    char* argv[] = {(char*)binary, NULL};
+    pid_t pid;
+    uint64_t start = now_ns();
+    int err = posix_spawn(&pid, binary, &actions, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (err != 0) {
+        close(fds[0]);
+        return -1;
+    }
+
+    char out[256];
+    size_t len = 0;
+    ssize_t n;
+    while ((n = read(fds[0], out + len, sizeof(out) - 1 - len)) > 0) {
+        len += (size_t)n;
+        if (len == sizeof(out) - 1) break;
+    }
+    close(fds[0]);
+    out[len] = '\0';
+
+    int status;
+    waitpid(pid, &status, 0);
+    uint64_t end = now_ns();
+
+    const char* entered = strstr(out, "PERF:main_ns:");
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !entered) return -1;
+
+    *to_main = strtoull(entered + strlen("PERF:main_ns:"), NULL, 10) - start;
+    *to_exit = end - start;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("ERROR:usage: %s <binary> <runs>\n", argv[0]);
+        return 1;
+    }
+
+    int runs = atoi(argv[2]);
+    if (runs < 1) runs = 1;
+
+    uint64_t* to_main = malloc((size_t)runs * sizeof(uint64_t));
+    uint64_t* to_exit = malloc((size_t)runs * sizeof(uint64_t));
+    if (!to_main || !to_exit) {
+        printf("ERROR:Failed to allocate samples\n");
+        return 1;
+    }
+
+    // Warm up the page cache and the binary's mappings
+    uint64_t ignored_main, ignored_exit;
+    run_once(argv[1], &ignored_main, &ignored_exit);
+
+    for (int i = 0; i < runs; i++) {
+        if (run_once(argv[1], &to_main[i], &to_exit[i]) != 0) {
+            printf("ERROR:Failed to run %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    report("exec_to_main", to_main, runs);
+    report("exec_to_exit", to_exit, runs);
+    printf("ANSWER:%d\n", runs);
+
+    free(to_main);
+    free(to_exit);
+    return 0;
+}
@@ -1,8 +1,6 @@
-#include "tools/runner/c/common.h"
+// Day 09 area kernel shootout: ./tools/aoc kernels bench.c 9
+#include "tools/runner/c/kernel.h"
 #include <immintrin.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <time.h>
 
 // -----------------------------------------------------------------------------
 // Data
@@ -132,6 +130,10 @@ long long solve_hull(int n) {
 // -----------------------------------------------------------------------------
 // Main Bench
 // -----------------------------------------------------------------------------
+static uint64_t kernel_scalar(const void* ctx) { return (uint64_t)solve_scalar(*(const int*)ctx); }
+static uint64_t kernel_simd(const void* ctx) { return (uint64_t)solve_simd(*(const int*)ctx); }
+static uint64_t kernel_hull(const void* ctx) { return (uint64_t)solve_hull(*(const int*)ctx); }
+
 int main() {
     // Read stdin
     char* input = aoc_read_input();
@@ -160,32 +162,12 @@ int main() {
     
     printf("N = %d\n", n);
 
-    // Warmup
-    solve_scalar(n);
-    
-    #define RUNS 1000
-    
-    // Bench Scalar
-    AOC_TIMER_START(scalar);
-    long long r1 = 0;
-    for(int i=0; i<RUNS; i++) r1 = solve_scalar(n);
-    AOC_TIMER_END(scalar);
-    
-    // Bench SIMD
-    AOC_TIMER_START(simd);
-    long long r2 = 0;
-    for(int i=0; i<RUNS; i++) r2 = solve_simd(n);
-    AOC_TIMER_END(simd);
-    
-    // Bench Hull
-    AOC_TIMER_START(hull);
-    long long r3 = 0;
-    for(int i=0; i<RUNS; i++) r3 = solve_hull(n);
-    AOC_TIMER_END(hull);
-    
-    printf("Scalar Result: %lld\n", r1);
-    printf("SIMD Result:   %lld\n", r2);
-    printf("Hull Result:   %lld\n", r3);
+    // Scalar is the reference answer
+    aoc_kernel_register("gemini/scalar", kernel_scalar);
+    if (__builtin_cpu_supports("avx2")) aoc_kernel_register("gemini/simd", kernel_simd);
+    aoc_kernel_register("gemini/hull", kernel_hull);
     
-    return 0;
+    int status = aoc_kernel_main(&n_points);
+    aoc_cleanup(input);
+    return status;
 }
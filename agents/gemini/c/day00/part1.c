@@ -4,6 +4,9 @@
  *
  * OPTIMIZED SOLUTION: O(n) using modulo grouping
  * Uses fixed-size array for remainders (faster than hash map)
+ *
+ * Streams the input: a reader thread fills the next chunk while this one
+ * is parsed (SWAR) straight into the counts. O(K) memory whatever n.
  */
 
 #include "../../tools/runner/c/common.h"
@@ -12,24 +15,61 @@
 
 static long long remainder_count[MAX_K];
 
+static uint32_t k;
+static uint64_t k_magic;  // fastmod: remainder of a u32 without a divide
+
+static inline uint32_t mod_k(int64_t num) {
+    if ((uint64_t)num <= UINT32_MAX) {
+        uint64_t low = k_magic * (uint32_t)num;
+        return (uint32_t)(((unsigned __int128)low * k) >> 64);
+    }
+    int64_t rem = num % (int64_t)k;
+    return (uint32_t)(rem < 0 ? rem + k : rem);
+}
+
+// The separator after a number is skipped with it
+static void count_chunk(const char* p, const char* end) {
+    while (p < end) {
+        uint64_t num;
+        if (*p >= '0' && *p <= '9') {
+            p = aoc_parse_u64(p, &num) + 1;
+            remainder_count[mod_k((int64_t)num)]++;
+        } else if (*p == '-') {
+            p = aoc_parse_u64(p + 1, &num) + 1;
+            remainder_count[mod_k(-(int64_t)num)]++;
+        } else {
+            p++;
+        }
+    }
+}
+
 int main(void) {
-    char* input = aoc_read_input();
+    AocStream* stream = aoc_stream_open(AOC_STREAM_CHUNK, 1);
 
     AOC_TIMER_START(parse);
 
-    int n, k;
-    char* ptr = input;
-    n = (int)strtol(ptr, &ptr, 10);
-    k = (int)strtol(ptr, &ptr, 10);
+    size_t len;
+    const char* chunk = aoc_stream_next(stream, &len);
+    if (!chunk) {
+        AOC_ERROR("Empty input");
+        return 1;
+    }
 
-    // Reset remainder counts
-    memset(remainder_count, 0, k * sizeof(long long));
+    // Header: n k (n is implied by the number of lines)
+    char* ptr;
+    strtoll(chunk, &ptr, 10);
+    long long k_in = strtoll(ptr, &ptr, 10);
+    if (k_in <= 0 || k_in > MAX_K) {
+        AOC_ERROR("K must be in 1..1000000");
+        return 1;
+    }
+    k = (uint32_t)k_in;
+    k_magic = UINT64_MAX / k + 1;
 
     // Count numbers by remainder
-    for (int i = 0; i < n; i++) {
-        long long num = strtoll(ptr, &ptr, 10);
-        int rem = ((num % k) + k) % k;
-        remainder_count[rem]++;
+    count_chunk(ptr, chunk + len);
+    while ((chunk = aoc_stream_next(stream, &len))) {
+        count_chunk(chunk, chunk + len);
     }
 
     AOC_TIMER_END(parse);
@@ -43,7 +83,7 @@ int main(void) {
     pairs += (c0 * (c0 - 1)) / 2;
 
     // Pairs where remainders sum to K
-    for (int r = 1; r < (k + 1) / 2; r++) {
+    for (uint32_t r = 1; r < (k + 1) / 2; r++) {
         pairs += remainder_count[r] * remainder_count[k - r];
     }
 
@@ -57,6 +97,6 @@ int main(void) {
 
     AOC_RESULT_INT(pairs);
 
-    aoc_cleanup(input);
+    aoc_stream_close(stream);
     return 0;
 }
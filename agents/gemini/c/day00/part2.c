@@ -4,6 +4,9 @@
  *
  * OPTIMIZED SOLUTION: O(n) using modulo grouping with sum tracking
  * Uses 128-bit integers for large products
+ *
+ * Streams the input: a reader thread fills the next chunk while this one
+ * is parsed (SWAR) straight into the groups. O(K) memory whatever n.
  */
 
 #include "../../tools/runner/c/common.h"
@@ -15,28 +18,68 @@ static long long group_count[MAX_K];
 static __int128 group_sum[MAX_K];
 static __int128 group_sum_sq[MAX_K];
 
+static uint32_t k;
+static uint64_t k_magic;  // fastmod: remainder of a u32 without a divide
+
+static inline uint32_t mod_k(int64_t num) {
+    if ((uint64_t)num <= UINT32_MAX) {
+        uint64_t low = k_magic * (uint32_t)num;
+        return (uint32_t)(((unsigned __int128)low * k) >> 64);
+    }
+    int64_t rem = num % (int64_t)k;
+    return (uint32_t)(rem < 0 ? rem + k : rem);
+}
+
+static inline void add_number(int64_t num) {
+    uint32_t rem = mod_k(num);
+    group_count[rem]++;
+    group_sum[rem] += num;
+    group_sum_sq[rem] += (__int128)num * num;
+}
+
+// The separator after a number is skipped with it
+static void group_chunk(const char* p, const char* end) {
+    while (p < end) {
+        uint64_t num;
+        if (*p >= '0' && *p <= '9') {
+            p = aoc_parse_u64(p, &num) + 1;
+            add_number((int64_t)num);
+        } else if (*p == '-') {
+            p = aoc_parse_u64(p + 1, &num) + 1;
+            add_number(-(int64_t)num);
+        } else {
+            p++;
+        }
+    }
+}
+
 int main(void) {
-    char* input = aoc_read_input();
+    AocStream* stream = aoc_stream_open(AOC_STREAM_CHUNK, 1);
 
     AOC_TIMER_START(parse);
 
-    int n, k;
-    char* ptr = input;
-    n = (int)strtol(ptr, &ptr, 10);
-    k = (int)strtol(ptr, &ptr, 10);
+    size_t len;
+    const char* chunk = aoc_stream_next(stream, &len);
+    if (!chunk) {
+        AOC_ERROR("Empty input");
+        return 1;
+    }
 
-    // Reset groups
-    memset(group_count, 0, k * sizeof(long long));
-    memset(group_sum, 0, k * sizeof(__int128));
-    memset(group_sum_sq, 0, k * sizeof(__int128));
+    // Header: n k (n is implied by the number of lines)
+    char* ptr;
+    strtoll(chunk, &ptr, 10);
+    long long k_in = strtoll(ptr, &ptr, 10);
+    if (k_in <= 0 || k_in > MAX_K) {
+        AOC_ERROR("K must be in 1..1000000");
+        return 1;
+    }
+    k = (uint32_t)k_in;
+    k_magic = UINT64_MAX / k + 1;
 
     // Group numbers by remainder
-    for (int i = 0; i < n; i++) {
-        long long num = strtoll(ptr, &ptr, 10);
-        int rem = ((num % k) + k) % k;
-        group_count[rem]++;
-        group_sum[rem] += num;
-        group_sum_sq[rem] += (__int128)num * num;
+    group_chunk(ptr, chunk + len);
+    while ((chunk = aoc_stream_next(stream, &len))) {
+        group_chunk(chunk, chunk + len);
     }
 
     AOC_TIMER_END(parse);
@@ -52,7 +95,7 @@ int main(void) {
     }
 
     // Pairs between groups r and k-r
-    for (int r = 1; r < (k + 1) / 2; r++) {
+    for (uint32_t r = 1; r < (k + 1) / 2; r++) {
         total += group_sum[r] * group_sum[k - r];
     }
 
@@ -79,6 +122,6 @@ int main(void) {
         printf("ANSWER:%s\n", &buf[i + 1]);
     }
 
-    aoc_cleanup(input);
+    aoc_stream_close(stream);
     return 0;
 }
@@ -23,6 +23,8 @@ export default defineNuxtConfig({
   // Runtime config for database path
   runtimeConfig: {
     dbPath: "./data/aoc25.db",
+    // "rows" (one benchmark_runs row per run) or "blob" (one per session)
+    benchSampleStorage: "rows",
   },
 
   // Nitro config
@@ -0,0 +1,58 @@
+/**
+ * GET /api/benchmarks/distribution - Distribution des latences
+ *
+ * ?ids=12,13         sessions précises (fusionnées)
+ * ?agent&day&part&language[&sessions=5]   dernières sessions d'un puzzle
+ * [&percentiles=50,99,99.99]
+ */
+
+import {
+  getDistribution,
+  getLatestSessionIds,
+  DISTRIBUTION_PERCENTILES,
+} from "~/server/utils/histograms";
+
+function parseNumberList(value: unknown): number[] {
+  if (typeof value !== "string" || !value) return [];
+  return value
+    .split(",")
+    .map((v) => parseFloat(v))
+    .filter((v) => !isNaN(v));
+}
+
+export default defineEventHandler(async (event) => {
+  const query = getQuery(event);
+
+  const percentiles = parseNumberList(query.percentiles).filter(
+    (p) => p >= 0 && p <= 100
+  );
+
+  let sessionIds = parseNumberList(query.ids).map(Math.trunc);
+
+  if (sessionIds.length === 0) {
+    const agent = query.agent as string | undefined;
+    const language = query.language as string | undefined;
+    const day = parseInt(query.day as string);
+    const part = parseInt(query.part as string);
+
+    if (!agent || !language || isNaN(day) || isNaN(part)) {
+      throw createError({
+        statusCode: 400,
+        message: "ids or agent, day, part and language are required",
+      });
+    }
+
+    sessionIds = getLatestSessionIds({
+      agent,
+      day,
+      part,
+      language,
+      sessions: Math.min(100, parseInt(query.sessions as string) || 1),
+    });
+  }
+
+  return getDistribution(
+    sessionIds,
+    percentiles.length > 0 ? percentiles : DISTRIBUTION_PERCENTILES
+  );
+});
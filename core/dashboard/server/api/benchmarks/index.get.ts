@@ -2,7 +2,11 @@
  * GET /api/benchmarks - Historique benchmarks
  */
 
-import { getDb, sqliteBool } from "~/server/utils/db";
+import {
+  getDb,
+  sqliteBool,
+  BENCHMARK_SESSION_COLUMNS,
+} from "~/server/utils/db";
 
 interface BenchmarkRow {
   id: number;
@@ -20,6 +24,10 @@ interface BenchmarkRow {
   p50_time_ms: number | null;
   p95_time_ms: number | null;
   p99_time_ms: number | null;
+  perf_verdict: string | null;
+  perf_p_value: number | null;
+  perf_delta_pct: number | null;
+  perf_baseline_runs: number | null;
   created_at: string;
 }
 
@@ -31,7 +39,7 @@ export default defineEventHandler(async (event) => {
 
   const db = getDb();
 
-  let sql = "SELECT * FROM benchmark_sessions WHERE 1=1";
+  let sql = `SELECT ${BENCHMARK_SESSION_COLUMNS} FROM benchmark_sessions WHERE 1=1`;
   const params: unknown[] = [];
 
   if (day !== null) {
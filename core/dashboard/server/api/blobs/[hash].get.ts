@@ -0,0 +1,36 @@
+/**
+ * GET /api/blobs/:hash - Contenu d'un énoncé / input par hash
+ *
+ * Le contenu d'un hash ne change jamais : cache navigateur illimité.
+ */
+
+import { getBlob } from "@aoc25/db";
+import { getDb } from "~/server/utils/db";
+
+export default defineEventHandler((event) => {
+  const hash = getRouterParam(event, "hash") ?? "";
+
+  if (!/^[0-9a-f]{64}$/.test(hash)) {
+    throw createError({
+      statusCode: 400,
+      message: "Invalid hash (expected SHA-256 hex)",
+    });
+  }
+
+  const content = getBlob(getDb(), hash);
+
+  if (content === null) {
+    throw createError({
+      statusCode: 404,
+      message: "Blob not found",
+    });
+  }
+
+  setResponseHeaders(event, {
+    "Content-Type": "text/plain; charset=utf-8",
+    "Cache-Control": "public, max-age=31536000, immutable",
+    ETag: `"${hash}"`,
+  });
+
+  return content;
+});
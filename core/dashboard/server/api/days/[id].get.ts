@@ -2,16 +2,21 @@
  * GET /api/days/:id - Détail d'un jour
  */
 
-import { getDb, sqliteBool } from "~/server/utils/db";
+import { DAY_COLUMNS, getDayContent } from "@aoc25/db";
+import {
+  getDb,
+  sqliteBool,
+  BENCHMARK_SESSION_COLUMNS,
+} from "~/server/utils/db";
 
 interface DayRow {
   id: number;
-  puzzle1_md: string | null;
-  puzzle2_md: string | null;
-  sample_input: string | null;
+  puzzle1_md_hash: string | null;
+  puzzle2_md_hash: string | null;
+  sample_input_hash: string | null;
   sample_expected_p1: string | null;
   sample_expected_p2: string | null;
-  final_input: string | null;
+  final_input_hash: string | null;
   answer_p1: string | null;
   answer_p2: string | null;
   published_at: string | null;
@@ -30,6 +35,7 @@ interface RunRow {
   is_correct: number | null;
   is_sample: number;
   error: string | null;
+  stats: string | null;
   created_at: string;
 }
 
@@ -47,7 +53,7 @@ export default defineEventHandler(async (event) => {
   const db = getDb();
 
   // Get day
-  const day = db.prepare("SELECT * FROM days WHERE id = ?").get(dayId) as DayRow | undefined;
+  const day = db.prepare(`SELECT ${DAY_COLUMNS} FROM days WHERE id = ?`).get(dayId) as DayRow | undefined;
 
   if (!day) {
     throw createError({
@@ -63,15 +69,19 @@ export default defineEventHandler(async (event) => {
 
   // Get benchmarks for this day
   const benchmarks = db.prepare(`
-    SELECT * FROM benchmark_sessions WHERE day = ? ORDER BY created_at DESC LIMIT 20
+    SELECT ${BENCHMARK_SESSION_COLUMNS} FROM benchmark_sessions
+    WHERE day = ? ORDER BY created_at DESC LIMIT 20
   `).all(dayId);
 
   return {
     ...day,
+    // Statements and inputs from the content store
+    ...getDayContent(db, dayId),
     runs: runs.map((run) => ({
       ...run,
       is_correct: sqliteBool(run.is_correct),
       is_sample: run.is_sample === 1,
+      stats: run.stats === null ? null : JSON.parse(run.stats),
     })),
     benchmarks,
   };
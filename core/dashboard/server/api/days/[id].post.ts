@@ -5,6 +5,13 @@
 
 import { writeFile, mkdir } from "node:fs/promises";
 import { join } from "node:path";
+import {
+  DAY_COLUMNS,
+  DAY_CONTENT_FIELDS,
+  setDayContent,
+  getDayContent,
+  deleteUnreferencedBlobs,
+} from "@aoc25/db";
 import { getDb } from "~/server/utils/db";
 
 interface UpdateDayBody {
@@ -35,24 +42,22 @@ export default defineEventHandler(async (event) => {
   const fields: string[] = [];
   const values: unknown[] = [];
 
-  const allowedFields = [
-    "puzzle1_md",
-    "puzzle2_md",
-    "sample_input",
-    "sample_expected_p1",
-    "sample_expected_p2",
-    "final_input",
-  ];
+  const allowedFields = ["sample_expected_p1", "sample_expected_p2"] as const;
 
   for (const field of allowedFields) {
-    const value = body[field as keyof UpdateDayBody];
+    const value = body[field];
     if (value !== undefined) {
       fields.push(`${field} = ?`);
       values.push(value);
     }
   }
 
-  if (fields.length === 0) {
+  // Statements and inputs go to the content store
+  const contents = DAY_CONTENT_FIELDS.filter(
+    (field) => body[field] !== undefined
+  );
+
+  if (fields.length === 0 && contents.length === 0) {
     throw createError({
       statusCode: 400,
       message: "No fields to update",
@@ -61,7 +66,17 @@ export default defineEventHandler(async (event) => {
 
   values.push(dayId);
 
-  db.prepare(`UPDATE days SET ${fields.join(", ")}, updated_at = CURRENT_TIMESTAMP WHERE id = ?`).run(...values);
+  db.transaction(() => {
+    for (const field of contents) {
+      setDayContent(db, dayId, field, body[field] ?? null);
+    }
+
+    fields.push("updated_at = CURRENT_TIMESTAMP");
+    db.prepare(`UPDATE days SET ${fields.join(", ")} WHERE id = ?`).run(...values);
+
+    // Previous versions of the updated contents
+    if (contents.length > 0) deleteUnreferencedBlobs(db);
+  })();
 
   // Also write to files in core/data/dayXX
   const dayStr = dayId.toString().padStart(2, "0");
@@ -105,7 +120,7 @@ export default defineEventHandler(async (event) => {
   }
 
   // Return updated day
-  const day = db.prepare("SELECT * FROM days WHERE id = ?").get(dayId);
+  const day = db.prepare(`SELECT ${DAY_COLUMNS} FROM days WHERE id = ?`).get(dayId) as Record<string, unknown>;
 
-  return day;
+  return { ...day, ...getDayContent(db, dayId) };
 });
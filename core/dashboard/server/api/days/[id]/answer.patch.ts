@@ -5,6 +5,7 @@
 
 import { writeFile, mkdir, readFile } from "node:fs/promises";
 import { join } from "node:path";
+import { DAY_COLUMNS } from "@aoc25/db";
 import { getDb } from "~/server/utils/db";
 
 interface SetAnswerBody {
@@ -72,7 +73,7 @@ export default defineEventHandler(async (event) => {
   await writeFile(answersPath, JSON.stringify(answers, null, 2), "utf-8");
 
   // Return updated day
-  const day = db.prepare("SELECT * FROM days WHERE id = ?").get(dayId);
+  const day = db.prepare(`SELECT ${DAY_COLUMNS} FROM days WHERE id = ?`).get(dayId);
 
   return day;
 });
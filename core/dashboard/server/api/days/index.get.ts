@@ -1,17 +1,21 @@
 /**
  * GET /api/days - Liste tous les jours avec derniers runs
+ *
+ * Métadonnées uniquement : énoncés et inputs sont référencés par hash
+ * (contenu via GET /api/days/:id ou GET /api/blobs/:hash).
  */
 
+import { DAY_COLUMNS } from "@aoc25/db";
 import { getDb, sqliteBool } from "~/server/utils/db";
 
 interface DayRow {
   id: number;
-  puzzle1_md: string | null;
-  puzzle2_md: string | null;
-  sample_input: string | null;
+  puzzle1_md_hash: string | null;
+  puzzle2_md_hash: string | null;
+  sample_input_hash: string | null;
   sample_expected_p1: string | null;
   sample_expected_p2: string | null;
-  final_input: string | null;
+  final_input_hash: string | null;
   answer_p1: string | null;
   answer_p2: string | null;
   published_at: string | null;
@@ -37,21 +41,27 @@ export default defineEventHandler(async () => {
   const db = getDb();
 
   // Get all days
-  const days = db.prepare("SELECT * FROM days ORDER BY id").all() as DayRow[];
+  const days = db
+    .prepare(`SELECT ${DAY_COLUMNS} FROM days ORDER BY id`)
+    .all() as DayRow[];
 
-  // Get latest runs for each day/agent/language/part combo
+  // Latest final run for each day/agent/language/part combo: one seek in
+  // idx_runs_latest per combo, however many runs are stored
   const latestRuns = db.prepare(`
-    SELECT r.* FROM runs r
-    INNER JOIN (
-      SELECT day, agent, language, part, MAX(created_at) as max_created
-      FROM runs
-      WHERE is_sample = 0
-      GROUP BY day, agent, language, part
-    ) latest ON r.day = latest.day
-      AND r.agent = latest.agent
-      AND r.language = latest.language
-      AND r.part = latest.part
-      AND r.created_at = latest.max_created
+    WITH agents(agent) AS (VALUES ('claude'), ('codex'), ('gemini')),
+      languages(language) AS (VALUES ('ts'), ('c')),
+      parts(part) AS (VALUES (1), (2))
+    SELECT r.* FROM days d
+    CROSS JOIN agents a
+    CROSS JOIN languages l
+    CROSS JOIN parts p
+    JOIN runs r ON r.id = (
+      SELECT id FROM runs
+      WHERE day = d.id AND agent = a.agent AND language = l.language
+        AND part = p.part AND is_sample = 0
+      ORDER BY created_at DESC, id DESC
+      LIMIT 1
+    )
     ORDER BY r.day, r.agent, r.language, r.part
   `).all() as RunRow[];
 
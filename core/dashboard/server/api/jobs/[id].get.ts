@@ -0,0 +1,16 @@
+/**
+ * GET /api/jobs/:id - Statut d'un job (queued, running, done, failed)
+ */
+
+import { getJobQueue } from "~/server/utils/jobs";
+
+export default defineEventHandler((event) => {
+  const id = parseInt(getRouterParam(event, "id") || "");
+
+  const job = isNaN(id) ? undefined : getJobQueue().get(id);
+  if (!job) {
+    throw createError({ statusCode: 404, message: "Job not found" });
+  }
+
+  return job;
+});
@@ -0,0 +1,20 @@
+/**
+ * GET /api/jobs - Jobs de la file d'exécution (runs + benchmarks)
+ *
+ * Du plus récent au plus ancien, avec le nombre de jobs par statut.
+ * ?kind=run|benchmark et ?status=queued|running|done|failed pour filtrer
+ */
+
+import { getJobQueue } from "~/server/utils/jobs";
+
+export default defineEventHandler((event) => {
+  const query = getQuery(event);
+  const queue = getJobQueue();
+
+  const jobs = queue
+    .list()
+    .filter((job) => !query.kind || job.kind === query.kind)
+    .filter((job) => !query.status || job.status === query.status);
+
+  return { counts: queue.status(), jobs };
+});
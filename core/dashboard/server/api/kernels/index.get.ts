@@ -0,0 +1,22 @@
+/**
+ * GET /api/kernels - Historique des microbenchmarks c/kernel.h
+ *
+ * ?agent=, ?day=, ?file= filtrent, ?limit= (20 par défaut)
+ */
+
+import { getKernelRuns } from "@aoc25/db";
+import type { Agent } from "@aoc25/db";
+import { getDb } from "~/server/utils/db";
+
+export default defineEventHandler((event) => {
+  const query = getQuery(event);
+  const day = query.day ? parseInt(query.day as string) : NaN;
+  const limit = parseInt(query.limit as string) || 20;
+
+  return getKernelRuns(getDb(), {
+    ...(typeof query.agent === "string" && { agent: query.agent as Agent }),
+    ...(!Number.isNaN(day) && { day }),
+    ...(typeof query.file === "string" && { file: query.file }),
+    limit,
+  });
+});
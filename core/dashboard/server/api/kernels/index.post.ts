@@ -0,0 +1,75 @@
+/**
+ * POST /api/kernels - Enregistrer un microbenchmark c/kernel.h
+ *
+ * Le corps est la sortie de `aoc kernels --json`, avec l'agent, le fichier
+ * du bench (relatif au dossier de l'agent) et le jour dont l'input a servi :
+ *   { agent, file, day?, buildMode?, kernels: [...], ... }
+ */
+
+import { insertKernelRun } from "@aoc25/db";
+import { parseCBuildMode } from "@aoc25/runner";
+import type { KernelStats } from "@aoc25/runner";
+import { getDb } from "~/server/utils/db";
+
+interface KernelRunRequest {
+  agent: "claude" | "codex" | "gemini";
+  file: string;
+  day?: number | null;
+  buildMode?: string;
+  kernels: KernelStats[];
+}
+
+const NUMBER_FIELDS = [
+  "iterations",
+  "samples",
+  "minNs",
+  "medianNs",
+  "meanNs",
+  "maxNs",
+  "stdDevNs",
+] as const;
+
+export default defineEventHandler(async (event) => {
+  const body = await readBody<KernelRunRequest>(event);
+
+  // Validate
+  if (!["claude", "codex", "gemini"].includes(body.agent)) {
+    throw createError({ statusCode: 400, message: "Invalid agent" });
+  }
+  if (typeof body.file !== "string" || body.file.length === 0) {
+    throw createError({ statusCode: 400, message: "Invalid file" });
+  }
+  const day = body.day ?? null;
+  if (day !== null && (!Number.isInteger(day) || day < 0 || day > 12)) {
+    throw createError({
+      statusCode: 400,
+      message: "Invalid day (must be 0-12)",
+    });
+  }
+  const buildMode = parseCBuildMode(body.buildMode ?? "dynamic");
+  if (!buildMode) {
+    throw createError({ statusCode: 400, message: "Invalid buildMode" });
+  }
+  const valid =
+    Array.isArray(body.kernels) &&
+    body.kernels.length > 0 &&
+    body.kernels.every(
+      (k) =>
+        typeof k.name === "string" &&
+        typeof k.ok === "boolean" &&
+        NUMBER_FIELDS.every((field) => Number.isFinite(k[field]))
+    );
+  if (!valid) {
+    throw createError({ statusCode: 400, message: "Invalid kernels" });
+  }
+
+  const id = insertKernelRun(getDb(), {
+    agent: body.agent,
+    file: body.file,
+    day,
+    build_mode: buildMode,
+    kernels: body.kernels.map((k) => ({ ...k, answer: String(k.answer) })),
+  });
+
+  return { id };
+});
@@ -0,0 +1,25 @@
+/**
+ * GET /api/leaderboard - Points podium des benchmarks
+ *
+ * 3 / 2 / 1 points par jour × part × langage, sur la meilleure médiane
+ * correcte de chaque agent. Lu depuis les tables maintenues à l'écriture
+ * des sessions : O(agents × puzzles), quel que soit l'historique.
+ *
+ * ?puzzles=1 ajoute le meilleur temps de chaque agent par puzzle
+ */
+
+import { getLeaderboard, getPuzzleBests } from "@aoc25/db";
+import { getDb } from "~/server/utils/db";
+
+export default defineEventHandler((event) => {
+  const query = getQuery(event);
+  const db = getDb();
+
+  const agents = getLeaderboard(db);
+
+  if (query.puzzles !== "1" && query.puzzles !== "true") {
+    return { agents };
+  }
+
+  return { agents, puzzles: getPuzzleBests(db) };
+});
@@ -2,11 +2,10 @@
  * POST /api/runs - Exécuter un solver
  */
 
-import { spawn } from "node:child_process";
 import { join } from "node:path";
-import { readFile } from "node:fs/promises";
 import { existsSync } from "node:fs";
-import { getDb, sqliteBool } from "~/server/utils/db";
+import { getDb } from "~/server/utils/db";
+import { executeRunner } from "~/server/utils/solvers";
 
 interface RunRequest {
   agent: "claude" | "codex" | "gemini";
@@ -16,103 +15,6 @@ interface RunRequest {
   useSample?: boolean;
 }
 
-interface RunResult {
-  answer: string;
-  timeMs: number;
-  error?: string;
-}
-
-async function executeRunner(
-  agentDir: string,
-  day: number,
-  part: 1 | 2,
-  language: "ts" | "c",
-  useSample: boolean
-): Promise<RunResult> {
-  return new Promise((resolve) => {
-    const isWindows = process.platform === "win32";
-    const aocPath = join(agentDir, "tools", isWindows ? "aoc.bat" : "aoc");
-    const args = ["run", day.toString(), part.toString()];
-
-    if (useSample) args.push("--sample");
-    if (language === "c") args.push("--lang", "c");
-
-    // Use appropriate shell for platform
-    const proc = isWindows
-      ? spawn("cmd", ["/c", aocPath, ...args], {
-          cwd: agentDir,
-          env: { ...process.env },
-        })
-      : spawn(aocPath, args, { cwd: agentDir, env: { ...process.env } });
-
-    let stdout = "";
-    let stderr = "";
-
-    const startTime = process.hrtime.bigint();
-
-    proc.stdout.on("data", (data) => {
-      stdout += data.toString();
-    });
-
-    proc.stderr.on("data", (data) => {
-      stderr += data.toString();
-    });
-
-    // Timeout after 120 seconds
-    const timeout = setTimeout(() => {
-      proc.kill("SIGKILL");
-      resolve({
-        answer: "",
-        timeMs: 120000,
-        error: "Execution timed out (120s)",
-      });
-    }, 120000);
-
-    proc.on("close", (code) => {
-      clearTimeout(timeout);
-      const endTime = process.hrtime.bigint();
-      const timeMs = Number(endTime - startTime) / 1_000_000;
-
-      if (code !== 0) {
-        resolve({
-          answer: "",
-          timeMs,
-          error: stderr || `Exit code ${code}`,
-        });
-        return;
-      }
-
-      // Parse output - look for "Answer: XXX" (with or without emoji)
-      const answerMatch = stdout.match(/Answer:\s*(.+)/);
-      // Time can have emoji prefix like "⏱️  Time: 666µs"
-      const timeMatch = stdout.match(/Time:\s*([\d.]+)(µs|ms|s)/);
-
-      let parsedTime = timeMs;
-      if (timeMatch) {
-        const value = parseFloat(timeMatch[1]!);
-        const unit = timeMatch[2];
-        if (unit === "µs") parsedTime = value / 1000;
-        else if (unit === "ms") parsedTime = value;
-        else if (unit === "s") parsedTime = value * 1000;
-      }
-
-      resolve({
-        answer: answerMatch ? answerMatch[1]!.trim() : "",
-        timeMs: parsedTime,
-      });
-    });
-
-    proc.on("error", (err) => {
-      clearTimeout(timeout);
-      resolve({
-        answer: "",
-        timeMs: 0,
-        error: `Process error: ${err.message}`,
-      });
-    });
-  });
-}
-
 export default defineEventHandler(async (event) => {
   const body = await readBody<RunRequest>(event);
 
@@ -154,7 +56,11 @@ export default defineEventHandler(async (event) => {
 
   // Get expected answer
   const db = getDb();
-  const day = db.prepare("SELECT * FROM days WHERE id = ?").get(body.day) as {
+  const day = db
+    .prepare(
+      "SELECT answer_p1, answer_p2, sample_expected_p1, sample_expected_p2 FROM days WHERE id = ?"
+    )
+    .get(body.day) as {
     answer_p1: string | null;
     answer_p2: string | null;
     sample_expected_p1: string | null;
@@ -178,8 +84,8 @@ export default defineEventHandler(async (event) => {
   const insertResult = db
     .prepare(
       `
-    INSERT INTO runs (agent, day, part, language, answer, time_ms, is_correct, is_sample, error)
-    VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+    INSERT INTO runs (agent, day, part, language, answer, time_ms, is_correct, is_sample, error, build_mode)
+    VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
   `
     )
     .run(
@@ -191,7 +97,8 @@ export default defineEventHandler(async (event) => {
       result.timeMs,
       isCorrect === null ? null : isCorrect ? 1 : 0,
       body.useSample ? 1 : 0,
-      result.error || null
+      result.error || null,
+      result.buildMode ?? null
     );
 
   return {
@@ -0,0 +1,15 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Benchmark Writer Shutdown
+ *
+ * Nitro runs its close hook on a graceful shutdown (SIGINT / SIGTERM,
+ * dev server restarts): the runs still buffered by the benchmark writer
+ * are written before the database goes away.
+ */
+
+import { flushBenchmarkWriter } from "~/server/utils/db";
+
+export default defineNitroPlugin((nitroApp) => {
+  nitroApp.hooks.hook("close", () => {
+    flushBenchmarkWriter();
+  });
+});
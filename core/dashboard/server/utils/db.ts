@@ -5,9 +5,24 @@
 import Database from "better-sqlite3";
 import { readFileSync, existsSync, mkdirSync } from "node:fs";
 import { join, dirname } from "node:path";
+import {
+  applyMigrations,
+  migrateDayContentToBlobs,
+  ensureLeaderboard,
+  BenchmarkWriter,
+} from "@aoc25/db";
 
 // Singleton database instance
 let db: Database.Database | null = null;
+let benchmarkWriter: BenchmarkWriter | null = null;
+
+// benchmark_sessions columns sent to the client (blobs left out)
+export const BENCHMARK_SESSION_COLUMNS = `
+  id, agent, day, part, language, num_runs, answer, is_correct,
+  avg_time_ms, min_time_ms, max_time_ms, std_dev_ms,
+  p50_time_ms, p95_time_ms, p99_time_ms,
+  perf_verdict, perf_p_value, perf_delta_pct, perf_baseline_runs,
+  build_mode, created_at`;
 
 export function getDb(): Database.Database {
   if (db) return db;
@@ -23,6 +38,8 @@ export function getDb(): Database.Database {
 
   db = new Database(dbPath);
   db.pragma("journal_mode = WAL");
+  // Safe with WAL, and avoids an fsync per benchmark session
+  db.pragma("synchronous = NORMAL");
   db.pragma("foreign_keys = ON");
 
   // Initialize schema
@@ -31,6 +48,33 @@ export function getDb(): Database.Database {
   return db;
 }
 
+/**
+ * Buffered benchmark write path: runs are committed in large transactions,
+ * or stored as one samples blob per session when benchSampleStorage=blob
+ */
+export function getBenchmarkWriter(): BenchmarkWriter {
+  if (benchmarkWriter) return benchmarkWriter;
+
+  const config = useRuntimeConfig();
+  benchmarkWriter = new BenchmarkWriter(getDb(), {
+    storage: config.benchSampleStorage === "blob" ? "blob" : "rows",
+  });
+
+  // Backstop for exits that skip Nitro's close hook (see
+  // plugins/benchmark-writer.ts): better-sqlite3 is synchronous, so pending
+  // runs can still be written here
+  process.once("exit", flushBenchmarkWriter);
+
+  return benchmarkWriter;
+}
+
+/**
+ * Write the runs still buffered by the benchmark writer, if any
+ */
+export function flushBenchmarkWriter(): void {
+  benchmarkWriter?.flush();
+}
+
 function initSchema(database: Database.Database): void {
   const schemaPath = join(process.cwd(), "..", "db", "schema.sql");
 
@@ -42,12 +86,12 @@ function initSchema(database: Database.Database): void {
     database.exec(`
       CREATE TABLE IF NOT EXISTS days (
         id INTEGER PRIMARY KEY,
-        puzzle1_md TEXT,
-        puzzle2_md TEXT,
-        sample_input TEXT,
+        puzzle1_md_hash TEXT,
+        puzzle2_md_hash TEXT,
+        sample_input_hash TEXT,
         sample_expected_p1 TEXT,
         sample_expected_p2 TEXT,
-        final_input TEXT,
+        final_input_hash TEXT,
         answer_p1 TEXT,
         answer_p2 TEXT,
         published_at DATETIME,
@@ -55,6 +99,13 @@ function initSchema(database: Database.Database): void {
         updated_at DATETIME DEFAULT CURRENT_TIMESTAMP
       );
 
+      CREATE TABLE IF NOT EXISTS blobs (
+        hash TEXT PRIMARY KEY,
+        size INTEGER NOT NULL,
+        created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+        content TEXT NOT NULL
+      );
+
       CREATE TABLE IF NOT EXISTS runs (
         id INTEGER PRIMARY KEY AUTOINCREMENT,
         agent TEXT NOT NULL CHECK (agent IN ('claude', 'codex', 'gemini')),
@@ -85,6 +136,13 @@ function initSchema(database: Database.Database): void {
         p50_time_ms REAL,
         p95_time_ms REAL,
         p99_time_ms REAL,
+        perf_verdict TEXT,
+        perf_p_value REAL,
+        perf_delta_pct REAL,
+        perf_baseline_runs INTEGER,
+        samples_blob BLOB,
+        histogram_blob BLOB,
+        build_mode TEXT,
         created_at DATETIME DEFAULT CURRENT_TIMESTAMP
       );
 
@@ -95,9 +153,66 @@ function initSchema(database: Database.Database): void {
         time_ms REAL NOT NULL,
         FOREIGN KEY (session_id) REFERENCES benchmark_sessions(id) ON DELETE CASCADE
       );
+
+      CREATE TABLE IF NOT EXISTS kernel_runs (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        agent TEXT NOT NULL CHECK (agent IN ('claude', 'codex', 'gemini')),
+        day INTEGER,
+        file TEXT NOT NULL,
+        build_mode TEXT NOT NULL,
+        ok INTEGER NOT NULL,
+        created_at DATETIME DEFAULT CURRENT_TIMESTAMP
+      );
+
+      CREATE TABLE IF NOT EXISTS kernel_results (
+        id INTEGER PRIMARY KEY AUTOINCREMENT,
+        run_id INTEGER NOT NULL,
+        name TEXT NOT NULL,
+        iterations INTEGER NOT NULL,
+        samples INTEGER NOT NULL,
+        min_ns REAL NOT NULL,
+        median_ns REAL NOT NULL,
+        mean_ns REAL NOT NULL,
+        max_ns REAL NOT NULL,
+        std_dev_ns REAL NOT NULL,
+        ok INTEGER NOT NULL,
+        answer TEXT,
+        FOREIGN KEY (run_id) REFERENCES kernel_runs(id) ON DELETE CASCADE
+      );
+
+      CREATE TABLE IF NOT EXISTS puzzle_best (
+        agent TEXT NOT NULL,
+        day INTEGER NOT NULL,
+        part INTEGER NOT NULL,
+        language TEXT NOT NULL,
+        session_id INTEGER NOT NULL,
+        best_time_ms REAL NOT NULL,
+        points INTEGER NOT NULL DEFAULT 0,
+        PRIMARY KEY (day, part, language, agent)
+      );
+
+      CREATE TABLE IF NOT EXISTS leaderboard (
+        agent TEXT PRIMARY KEY,
+        points INTEGER NOT NULL DEFAULT 0,
+        gold INTEGER NOT NULL DEFAULT 0,
+        silver INTEGER NOT NULL DEFAULT 0,
+        bronze INTEGER NOT NULL DEFAULT 0,
+        puzzles INTEGER NOT NULL DEFAULT 0,
+        total_best_ms REAL NOT NULL DEFAULT 0
+      );
+
+      CREATE INDEX IF NOT EXISTS idx_runs_latest
+        ON runs(day, agent, language, part, is_sample, created_at);
     `);
   }
 
+  // Columns added after a database was created
+  applyMigrations(database);
+  // Inline statements and inputs of older databases
+  migrateDayContentToBlobs(database);
+  // Podium tables of databases that predate them
+  ensureLeaderboard(database);
+
   // Initialize days 0-12 (Day 0 is test day, Days 1-12 are competition days)
   const insertDay = database.prepare("INSERT OR IGNORE INTO days (id) VALUES (?)");
   for (let i = 0; i <= 12; i++) {
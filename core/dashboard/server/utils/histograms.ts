@@ -0,0 +1,68 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Latency Distributions
+ *
+ * Merge the stored per-session histograms and answer percentile queries
+ * without touching benchmark_runs.
+ */
+
+import { mergeSessionHistograms } from "@aoc25/db";
+import type { HistogramBucket, PercentileValue } from "@aoc25/db";
+import { getDb } from "~/server/utils/db";
+
+export const DISTRIBUTION_PERCENTILES = [50, 75, 90, 95, 99, 99.9];
+export const DISTRIBUTION_MAX_BUCKETS = 40;
+
+export interface LatencyDistribution {
+  sessionIds: number[];
+  count: number;
+  min: number | null;
+  max: number | null;
+  percentiles: PercentileValue[];
+  buckets: HistogramBucket[];
+}
+
+export interface DistributionQuery {
+  agent: string;
+  day: number;
+  part: number;
+  language: string;
+  // Latest N sessions of the puzzle
+  sessions: number;
+}
+
+/**
+ * Latest session ids of a puzzle, newest first
+ */
+export function getLatestSessionIds(query: DistributionQuery): number[] {
+  return getDb()
+    .prepare(
+      `SELECT id FROM benchmark_sessions
+       WHERE agent = ? AND day = ? AND part = ? AND language = ?
+       ORDER BY created_at DESC, id DESC LIMIT ?`
+    )
+    .pluck()
+    .all(
+      query.agent,
+      query.day,
+      query.part,
+      query.language,
+      query.sessions
+    ) as number[];
+}
+
+export function getDistribution(
+  sessionIds: number[],
+  percentiles = DISTRIBUTION_PERCENTILES,
+  maxBuckets = DISTRIBUTION_MAX_BUCKETS
+): LatencyDistribution {
+  const histogram = mergeSessionHistograms(getDb(), sessionIds);
+
+  return {
+    sessionIds,
+    count: histogram.totalCount,
+    min: histogram.minMs,
+    max: histogram.maxMs,
+    percentiles: histogram.percentiles(percentiles),
+    buckets: histogram.buckets(maxBuckets),
+  };
+}
@@ -0,0 +1,334 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Implementation Index
+ *
+ * Long-lived index of the agents' solution files, scanned once then kept
+ * current by fs.watch. Each source is keyed by path and revalidated on
+ * mtime + size, so "is it implemented?" queries never touch the disk.
+ * The index also remembers the source hash and the last successful C
+ * build, which lets benchmarks skip clang when nothing changed.
+ */
+
+import { watch, statSync, readFileSync } from "node:fs";
+import type { FSWatcher } from "node:fs";
+import { createHash } from "node:crypto";
+import { join } from "node:path";
+import type { CBuildMode } from "@aoc25/runner";
+
+export const AGENTS = ["claude", "codex", "gemini"] as const;
+export const LANGUAGES = ["ts", "c"] as const;
+export const PARTS = [1, 2] as const;
+export const DAYS = Array.from({ length: 13 }, (_, i) => i); // 0-12
+
+export type IndexAgent = (typeof AGENTS)[number];
+export type IndexLanguage = (typeof LANGUAGES)[number];
+
+export const NOT_IMPLEMENTED_MARKERS = [
+  "NOT_IMPLEMENTED",
+  "TODO: Implement solution",
+  'return "NOT_IMPLEMENTED"',
+];
+
+// Changes under agents/<agent>/<lang>/ that concern a solution file
+const SOURCE_PATTERN = /day(\d{2})[\\/]part([12])\.(ts|c)$/;
+
+export interface FileEntry {
+  exists: boolean;
+  mtimeMs: number;
+  size: number;
+  hash: string | null;
+  content: string | null;
+}
+
+export interface SourceEntry extends FileEntry {
+  implemented: boolean;
+}
+
+export interface BuildArtifact {
+  binaryPath: string;
+  sourceHash: string;
+  // Agent's common.h at build time
+  headerHash: string | null;
+  // Mode the binary was built in (nostart may fall back to static)
+  mode: CBuildMode;
+  binaryMtimeMs: number;
+}
+
+const MISSING: FileEntry = {
+  exists: false,
+  mtimeMs: 0,
+  size: 0,
+  hash: null,
+  content: null,
+};
+
+export function implementationKey(
+  agent: string,
+  day: number,
+  part: number,
+  language: string
+): string {
+  return `${agent}-${day}-${part}-${language}`;
+}
+
+function readEntry(path: string, previous?: FileEntry): FileEntry {
+  let stats;
+  try {
+    stats = statSync(path);
+  } catch {
+    return MISSING;
+  }
+
+  // Same path + mtime + size: keep what we already know
+  if (
+    previous?.exists &&
+    previous.mtimeMs === stats.mtimeMs &&
+    previous.size === stats.size
+  ) {
+    return previous;
+  }
+
+  try {
+    const content = readFileSync(path, "utf-8");
+    return {
+      exists: true,
+      mtimeMs: stats.mtimeMs,
+      size: stats.size,
+      hash: createHash("sha256").update(content).digest("hex"),
+      content,
+    };
+  } catch {
+    return MISSING;
+  }
+}
+
+export class ImplementationIndex {
+  private sources = new Map<string, SourceEntry>();
+  private files = new Map<string, FileEntry>();
+  private builds = new Map<string, BuildArtifact>();
+  private watchers: FSWatcher[] = [];
+  // Without fs.watch, queries fall back to a stat per source
+  private watching = false;
+
+  constructor(readonly rootDir: string) {}
+
+  sourcePath(
+    agent: string,
+    day: number,
+    part: number,
+    language: string
+  ): string {
+    const dayStr = day.toString().padStart(2, "0");
+    return join(
+      this.rootDir,
+      "agents",
+      agent,
+      language,
+      `day${dayStr}`,
+      `part${part}.${language}`
+    );
+  }
+
+  /**
+   * Scan every solution file once and start watching the agents' dirs
+   */
+  start(): this {
+    for (const agent of AGENTS) {
+      for (const language of LANGUAGES) {
+        for (const day of DAYS) {
+          for (const part of PARTS) {
+            this.refresh(this.sourcePath(agent, day, part, language));
+          }
+        }
+      }
+    }
+
+    this.watching = true;
+    for (const agent of AGENTS) {
+      for (const language of LANGUAGES) {
+        const dir = join(this.rootDir, "agents", agent, language);
+        try {
+          const watcher = watch(dir, { recursive: true }, (_, filename) => {
+            const match = filename?.toString().match(SOURCE_PATTERN);
+            if (!match || match[3] !== language) return;
+            const day = parseInt(match[1]!, 10);
+            this.refresh(this.sourcePath(agent, day, +match[2]!, language));
+          });
+          watcher.on("error", () => this.stopWatching());
+          this.watchers.push(watcher);
+        } catch {
+          // Missing dir or no recursive watch on this platform
+          this.stopWatching();
+          return this;
+        }
+      }
+    }
+
+    return this;
+  }
+
+  close(): void {
+    this.stopWatching();
+  }
+
+  private stopWatching(): void {
+    this.watching = false;
+    for (const watcher of this.watchers) watcher.close();
+    this.watchers = [];
+  }
+
+  /**
+   * Re-stat one source; it is only read again when mtime or size changed
+   */
+  refresh(path: string): SourceEntry {
+    const previous = this.sources.get(path);
+    const file = readEntry(path, previous);
+    if (previous && file === previous) return previous;
+
+    const entry: SourceEntry = {
+      ...file,
+      implemented:
+        file.content !== null &&
+        !NOT_IMPLEMENTED_MARKERS.some((marker) =>
+          file.content!.includes(marker)
+        ),
+    };
+    this.sources.set(path, entry);
+    return entry;
+  }
+
+  getSource(path: string): SourceEntry {
+    const entry = this.sources.get(path);
+    return entry && this.watching ? entry : this.refresh(path);
+  }
+
+  isImplemented(
+    agent: string,
+    day: number,
+    part: number,
+    language: string
+  ): boolean {
+    return this.getSource(this.sourcePath(agent, day, part, language))
+      .implemented;
+  }
+
+  /**
+   * "agent-day-part-lang" -> implemented, for every known source
+   */
+  implementedMap(): Record<string, boolean> {
+    const map: Record<string, boolean> = {};
+    for (const agent of AGENTS) {
+      for (const day of DAYS) {
+        for (const part of PARTS) {
+          for (const language of LANGUAGES) {
+            map[implementationKey(agent, day, part, language)] =
+              this.isImplemented(agent, day, part, language);
+          }
+        }
+      }
+    }
+    return map;
+  }
+
+  /**
+   * Any other file (inputs, headers), revalidated with a stat per call
+   */
+  getFile(path: string): FileEntry {
+    const file = readEntry(path, this.files.get(path));
+    this.files.set(path, file);
+    return file;
+  }
+
+  /**
+   * Identity of what a run executes: the source, plus the agent's common.h
+   * for C since the binary is built from both with fixed flags
+   */
+  solverHash(
+    agent: string,
+    day: number,
+    part: number,
+    language: string
+  ): string | null {
+    const sourcePath = this.sourcePath(agent, day, part, language);
+    const source = this.getSource(sourcePath);
+    if (!source.hash) return null;
+    if (language !== "c") return source.hash;
+
+    return createHash("sha256")
+      .update(`${source.hash}:${this.headerHash(sourcePath) ?? ""}`)
+      .digest("hex");
+  }
+
+  /**
+   * Hash of the common.h a C source includes
+   */
+  headerHash(sourcePath: string): string | null {
+    // agents/<agent>/c/dayNN/partP.c -> agents/<agent>/tools/runner/c/common.h
+    const headerPath = join(
+      sourcePath,
+      "..",
+      "..",
+      "..",
+      "tools",
+      "runner",
+      "c",
+      "common.h"
+    );
+    return this.getFile(headerPath).hash;
+  }
+
+  /**
+   * Binary of the last successful build of this exact source, if any
+   */
+  getBuild(sourcePath: string): BuildArtifact | null {
+    const build = this.builds.get(sourcePath);
+    if (!build) return null;
+
+    const source = this.getSource(sourcePath);
+    let binaryMtimeMs = -1;
+    try {
+      binaryMtimeMs = statSync(build.binaryPath).mtimeMs;
+    } catch {
+      // Binary deleted
+    }
+
+    if (
+      source.hash !== build.sourceHash ||
+      this.headerHash(sourcePath) !== build.headerHash ||
+      binaryMtimeMs !== build.binaryMtimeMs
+    ) {
+      this.builds.delete(sourcePath);
+      return null;
+    }
+
+    return build;
+  }
+
+  /**
+   * Remember a successful build. `sourceHash` and `headerHash` are the
+   * hashes the compiler saw (taken before compiling, so an edit of either
+   * file during the build invalidates it).
+   */
+  recordBuild(
+    sourcePath: string,
+    build: Omit<BuildArtifact, "binaryMtimeMs">
+  ): void {
+    try {
+      this.builds.set(sourcePath, {
+        ...build,
+        binaryMtimeMs: statSync(build.binaryPath).mtimeMs,
+      });
+    } catch {
+      this.builds.delete(sourcePath);
+    }
+  }
+}
+
+let index: ImplementationIndex | null = null;
+
+export function getImplementationIndex(): ImplementationIndex {
+  if (!index) {
+    // Dashboard runs from core/dashboard
+    index = new ImplementationIndex(join(process.cwd(), "..", "..")).start();
+  }
+  return index;
+}
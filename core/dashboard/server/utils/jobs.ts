@@ -0,0 +1,172 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Job Queue
+ *
+ * Every run and benchmark launched by the dashboard goes through one
+ * queue: identical requests in flight (other tabs, repeated "run all"
+ * clicks) share a single execution, and each job can be followed through
+ * GET /api/jobs. Correct outputs are remembered by (solver hash, input
+ * hash, C build mode and counters), so re-running an unchanged solver
+ * does not spawn it again. A cached result is not a measurement: it is
+ * returned but not inserted in `runs` again.
+ */
+
+import { existsSync } from "node:fs";
+import {
+  JobQueue,
+  ResultCache,
+  getCBuildMode,
+  getCStats,
+} from "@aoc25/runner";
+import type { Job, SchedulerMode } from "@aoc25/runner";
+import { getScheduler } from "~/server/utils/scheduler";
+import { getImplementationIndex } from "~/server/utils/implementations";
+import {
+  executeRunner,
+  getAgentDir,
+  getExpectedAnswer,
+  getSolverCores,
+  insertRun,
+  readPuzzleInput,
+  runBenchmark,
+} from "~/server/utils/solvers";
+import type {
+  PuzzleRef,
+  BenchmarkTask,
+  BenchmarkOutcome,
+  SolverOutput,
+} from "~/server/utils/solvers";
+
+// Same limit the run stream used to apply on its own
+export const RUN_CONCURRENCY = 6;
+
+export interface RunResult extends PuzzleRef {
+  answer: string;
+  timeMs: number;
+  isCorrect: boolean | null;
+  error?: string;
+  // Answer served from the cache, solver not executed
+  cached?: boolean;
+}
+
+let queue: JobQueue | null = null;
+const answers = new ResultCache<SolverOutput>(1000);
+
+export function getJobQueue(): JobQueue {
+  if (!queue) {
+    // Benchmarks are already limited by the core scheduler
+    queue = new JobQueue({ concurrency: { run: RUN_CONCURRENCY } });
+  }
+  return queue;
+}
+
+function puzzleKey(puzzle: PuzzleRef): string {
+  return `${puzzle.agent}-${puzzle.day}-${puzzle.part}-${puzzle.language}`;
+}
+
+async function executeRun(
+  puzzle: PuzzleRef,
+  useSample: boolean
+): Promise<RunResult> {
+  const agentDir = getAgentDir(puzzle.agent);
+  if (!existsSync(agentDir)) {
+    return {
+      ...puzzle,
+      answer: "",
+      timeMs: 0,
+      isCorrect: null,
+      error: "Agent directory not found",
+    };
+  }
+
+  const solverHash = getImplementationIndex().solverHash(
+    puzzle.agent,
+    puzzle.day,
+    puzzle.part,
+    puzzle.language
+  );
+  const inputHash = readPuzzleInput(puzzle.day, useSample)?.hash;
+  // The runner builds C per AOC_C_BUILD / AOC_STATS: each its own binary
+  const build =
+    puzzle.language === "c"
+      ? `${getCBuildMode()}${getCStats() ? "+stats" : ""}`
+      : "";
+  const cacheKey =
+    solverHash && inputHash
+      ? `${puzzle.part}:${build}:${solverHash}:${inputHash}`
+      : null;
+
+  const expected = getExpectedAnswer(puzzle.day, puzzle.part, useSample);
+  const cached = cacheKey ? answers.get(cacheKey) : undefined;
+
+  let output: SolverOutput;
+  if (cached && cached.answer === expected) {
+    output = cached;
+  } else {
+    output = await executeRunner(
+      agentDir,
+      puzzle.day,
+      puzzle.part,
+      puzzle.language,
+      useSample
+    );
+  }
+
+  const isCorrect =
+    expected !== null && !output.error ? output.answer === expected : null;
+  if (cacheKey && isCorrect && output !== cached) {
+    answers.set(cacheKey, output);
+  }
+
+  const result: RunResult = { ...puzzle, ...output, isCorrect };
+  if (output === cached) {
+    // Timing of an earlier run: not stored as a new one
+    result.cached = true;
+    return result;
+  }
+
+  insertRun(result, useSample);
+  return result;
+}
+
+/**
+ * Run a solver through the agent's `aoc` tool, stored in `runs`
+ */
+export function submitRun(
+  puzzle: PuzzleRef,
+  useSample: boolean
+): Job<RunResult> {
+  const key = `${puzzleKey(puzzle)}-${useSample ? "sample" : "final"}`;
+  return getJobQueue().submit("run", key, () =>
+    executeRun(puzzle, useSample)
+  );
+}
+
+/**
+ * Benchmark a solver on its own core(s), all of them for a threaded C
+ * solver, stored as a benchmark session. Progress details are
+ * BenchmarkProgress events.
+ */
+export function submitBenchmark(
+  task: BenchmarkTask,
+  mode: SchedulerMode
+): Job<BenchmarkOutcome> {
+  const key = `${puzzleKey(task)}-${task.numRuns}-${mode}`;
+  return getJobQueue().submit("benchmark", key, ({ progress }) =>
+    getScheduler().run(
+      mode,
+      (lease) =>
+        runBenchmark(
+          task,
+          readPuzzleInput(task.day)?.content,
+          lease,
+          (event) =>
+            progress(
+              event.type === "run" ? event.runIndex : event.runIndex - 1,
+              task.numRuns,
+              event
+            )
+        ),
+      getSolverCores(task)
+    )
+  );
+}
@@ -0,0 +1,26 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Benchmark Scheduler
+ *
+ * One scheduler for the whole server, so concurrent benchmark requests
+ * share the same core pool instead of overlapping.
+ */
+
+import { CoreScheduler } from "@aoc25/runner";
+import type { SchedulerMode } from "@aoc25/runner";
+
+let scheduler: CoreScheduler | null = null;
+
+export function getScheduler(): CoreScheduler {
+  if (!scheduler) {
+    scheduler = new CoreScheduler();
+    console.log(
+      `[Scheduler] ${scheduler.capacity("isolated")} isolated cores, ` +
+        `${scheduler.capacity("throughput")} CPUs in throughput mode`
+    );
+  }
+  return scheduler;
+}
+
+export function parseSchedulerMode(value: unknown): SchedulerMode {
+  return value === "throughput" ? "throughput" : "isolated";
+}
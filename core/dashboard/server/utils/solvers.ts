@@ -0,0 +1,558 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Solver Execution
+ *
+ * Compile / execute helpers shared by the run and benchmark endpoints:
+ *   - runs go through the agent's `aoc` tool
+ *   - benchmarks spawn the solver directly and time parse + solve (C) or
+ *     solve() in a fresh process (TS)
+ */
+
+import { spawn } from "node:child_process";
+import { join } from "node:path";
+import { existsSync } from "node:fs";
+import {
+  pinCommand,
+  OutputParser,
+  CappedText,
+  cBinaryPath,
+  compileCSource,
+  getCBuildMode,
+  getHarnessDir,
+  parseCBuildMode,
+  parseOutputLine,
+  solverCores,
+} from "@aoc25/runner";
+import type {
+  CBuildMode,
+  CpuLease,
+  OutputRecord,
+  SolverStat,
+} from "@aoc25/runner";
+import type { BenchmarkStats, RegressionResult } from "@aoc25/db";
+import { getDb, getBenchmarkWriter } from "~/server/utils/db";
+import { getImplementationIndex } from "~/server/utils/implementations";
+
+export type AgentName = "claude" | "codex" | "gemini";
+export type SolverLanguage = "ts" | "c";
+
+export interface PuzzleRef {
+  agent: AgentName;
+  day: number;
+  part: 1 | 2;
+  language: SolverLanguage;
+}
+
+export interface SolverOutput {
+  answer: string;
+  timeMs: number;
+  error?: string;
+  // Work counters, when the dashboard runs with AOC_STATS=1 (C only)
+  stats?: Record<string, SolverStat>;
+  // C only: mode of the binary that ran (AOC_C_BUILD, nostart may fall
+  // back to static)
+  buildMode?: CBuildMode;
+}
+
+export interface BenchmarkTask extends PuzzleRef {
+  numRuns: number;
+}
+
+// Streamed while a benchmark runs: each finished run, and each TIME:/PERF:
+// record a C solver prints (several per run for in-process iterations)
+export type BenchmarkProgress =
+  | { type: "run"; runIndex: number; totalRuns: number; timeMs: number }
+  | {
+      type: "record";
+      runIndex: number;
+      record: Extract<OutputRecord, { type: "time" | "perf" }>;
+    };
+
+export interface BenchmarkOutcome {
+  agent: string;
+  day: number;
+  part: number;
+  language: string;
+  success: boolean;
+  cpus: number[];
+  answer?: string;
+  isCorrect?: boolean | null;
+  stats?: BenchmarkStats;
+  regression?: RegressionResult;
+  error?: string;
+  sessionId?: number;
+}
+
+export function getRootDir(): string {
+  return join(process.cwd(), "..", "..");
+}
+
+export function getAgentDir(agent: string): string {
+  return join(getRootDir(), "agents", agent);
+}
+
+export function getInputPath(day: number, useSample: boolean): string {
+  const dayStr = day.toString().padStart(2, "0");
+  return join(
+    getRootDir(),
+    "core",
+    "data",
+    `day${dayStr}`,
+    useSample ? "sample.txt" : "input.txt"
+  );
+}
+
+/**
+ * Puzzle input with its hash (cached until the file changes)
+ */
+export function readPuzzleInput(
+  day: number,
+  useSample = false
+): { content: string; hash: string } | null {
+  const file = getImplementationIndex().getFile(getInputPath(day, useSample));
+  return file.content !== null && file.hash !== null
+    ? { content: file.content, hash: file.hash }
+    : null;
+}
+
+/**
+ * Cores to lease for a benchmark: threaded C solvers get every core
+ * (see solverCores)
+ */
+export function getSolverCores(puzzle: PuzzleRef): number {
+  if (puzzle.language !== "c") return 1;
+  const implementations = getImplementationIndex();
+  const source = implementations.getSource(
+    implementations.sourcePath(puzzle.agent, puzzle.day, puzzle.part, "c")
+  );
+  return source.content === null ? 1 : solverCores(source.content);
+}
+
+export function getExpectedAnswer(
+  day: number,
+  part: 1 | 2,
+  useSample: boolean
+): string | null {
+  const row = getDb()
+    .prepare(
+      "SELECT answer_p1, answer_p2, sample_expected_p1, sample_expected_p2 FROM days WHERE id = ?"
+    )
+    .get(day) as
+    | {
+        answer_p1: string | null;
+        answer_p2: string | null;
+        sample_expected_p1: string | null;
+        sample_expected_p2: string | null;
+      }
+    | undefined;
+
+  if (!row) return null;
+  if (useSample) {
+    return part === 1 ? row.sample_expected_p1 : row.sample_expected_p2;
+  }
+  return part === 1 ? row.answer_p1 : row.answer_p2;
+}
+
+export function insertRun(
+  run: PuzzleRef & SolverOutput & { isCorrect: boolean | null },
+  useSample: boolean
+): number {
+  const result = getDb()
+    .prepare(
+      `
+      INSERT INTO runs (agent, day, part, language, answer, time_ms, is_correct, is_sample, error, stats, build_mode)
+      VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    `
+    )
+    .run(
+      run.agent,
+      run.day,
+      run.part,
+      run.language,
+      run.answer || null,
+      run.timeMs,
+      run.isCorrect === null ? null : run.isCorrect ? 1 : 0,
+      useSample ? 1 : 0,
+      run.error || null,
+      run.stats ? JSON.stringify(run.stats) : null,
+      run.buildMode ?? null
+    );
+
+  return Number(result.lastInsertRowid);
+}
+
+/**
+ * Run a solver through the agent's `aoc` tool (60s timeout)
+ */
+export function executeRunner(
+  agentDir: string,
+  day: number,
+  part: 1 | 2,
+  language: SolverLanguage,
+  useSample: boolean
+): Promise<SolverOutput> {
+  return new Promise((resolve) => {
+    const isWindows = process.platform === "win32";
+    const aocPath = join(agentDir, "tools", isWindows ? "aoc.bat" : "aoc");
+    const args = ["run", day.toString(), part.toString()];
+
+    if (useSample) args.push("--sample");
+    if (language === "c") args.push("--lang", "c");
+
+    const proc = isWindows
+      ? spawn("cmd", ["/c", aocPath, ...args], {
+          cwd: agentDir,
+          env: { ...process.env },
+        })
+      : spawn(aocPath, args, { cwd: agentDir, env: { ...process.env } });
+
+    let stdout = "";
+    let stderr = "";
+    const startTime = process.hrtime.bigint();
+
+    proc.stdout.on("data", (data) => {
+      stdout += data.toString();
+    });
+
+    proc.stderr.on("data", (data) => {
+      stderr += data.toString();
+    });
+
+    const timeout = setTimeout(() => {
+      proc.kill("SIGKILL");
+      resolve({
+        answer: "",
+        timeMs: 60000,
+        error: "Execution timed out (60s)",
+      });
+    }, 60000);
+
+    proc.on("close", (code) => {
+      clearTimeout(timeout);
+      const endTime = process.hrtime.bigint();
+      const timeMs = Number(endTime - startTime) / 1_000_000;
+
+      if (code !== 0) {
+        resolve({ answer: "", timeMs, error: stderr || `Exit code ${code}` });
+        return;
+      }
+
+      const answerMatch = stdout.match(/Answer:\s*(.+)/);
+      const timeMatch = stdout.match(/Time:\s*([\d.]+)(µs|ms|s)/);
+
+      let parsedTime = timeMs;
+      if (timeMatch) {
+        const value = parseFloat(timeMatch[1]!);
+        const unit = timeMatch[2];
+        if (unit === "µs") parsedTime = value / 1000;
+        else if (unit === "ms") parsedTime = value;
+        else if (unit === "s") parsedTime = value * 1000;
+      }
+
+      // STAT: lines echoed by the CLI for AOC_STATS builds
+      const stats: Record<string, SolverStat> = {};
+      for (const line of stdout.split("\n")) {
+        const record = parseOutputLine(line.trim());
+        if (record.type === "stat") stats[record.name] = record.stat;
+      }
+
+      // The CLI builds per AOC_C_BUILD and says when nostart fell back
+      const fallback = stdout.match(/ran the (\w+) build/);
+      const buildMode =
+        language === "c"
+          ? (parseCBuildMode(fallback?.[1]) ?? getCBuildMode())
+          : undefined;
+
+      resolve({
+        answer: answerMatch ? answerMatch[1]!.trim() : "",
+        timeMs: parsedTime,
+        ...(Object.keys(stats).length > 0 ? { stats } : {}),
+        ...(buildMode && { buildMode }),
+      });
+    });
+
+    proc.on("error", (err) => {
+      clearTimeout(timeout);
+      resolve({
+        answer: "",
+        timeMs: 0,
+        error: `Process error: ${err.message}`,
+      });
+    });
+  });
+}
+
+/**
+ * Compile a C solver once for a benchmark, reusing the last build while
+ * the source (and common.h) are unchanged. The build mode comes from
+ * AOC_C_BUILD, like the runner; the one actually built is returned.
+ */
+export async function compileC(
+  agentDir: string,
+  day: number,
+  part: 1 | 2,
+  lease?: CpuLease
+): Promise<{ binaryPath: string; mode: CBuildMode } | { error: string }> {
+  const dayStr = day.toString().padStart(2, "0");
+  const sourceDir = join(agentDir, "c", `day${dayStr}`);
+  const sourcePath = join(sourceDir, `part${part}.c`);
+  const mode = getCBuildMode();
+  const binaryPath = cBinaryPath(sourceDir, part, mode);
+
+  const implementations = getImplementationIndex();
+  const cached = implementations.getBuild(sourcePath);
+  if (cached?.binaryPath === binaryPath) {
+    return { binaryPath, mode: cached.mode };
+  }
+  const sourceHash = implementations.getSource(sourcePath).hash;
+  const headerHash = implementations.headerHash(sourcePath);
+
+  const compiled = await compileCSource(sourcePath, binaryPath, {
+    mode,
+    harnessDir: getHarnessDir(agentDir),
+    wrap: (command, args) => pinCommand(lease, command, args),
+  });
+  if ("error" in compiled) return compiled;
+
+  if (sourceHash) {
+    implementations.recordBuild(sourcePath, {
+      binaryPath,
+      sourceHash,
+      headerHash,
+      mode: compiled.mode,
+    });
+  }
+  return { binaryPath, mode: compiled.mode };
+}
+
+/**
+ * Execute a solver once and measure it (30s timeout). Output is parsed
+ * line by line as it arrives, with bounded buffers.
+ */
+export function executeSolver(
+  agentDir: string,
+  day: number,
+  part: 1 | 2,
+  language: SolverLanguage,
+  input: string,
+  precompiledBinary?: string,
+  lease?: CpuLease,
+  onRecord?: (record: OutputRecord) => void
+): Promise<SolverOutput> {
+  return new Promise((resolve) => {
+    const dayStr = day.toString().padStart(2, "0");
+
+    let proc;
+    const startTime = process.hrtime.bigint();
+
+    if (language === "c" && precompiledBinary) {
+      const pinned = pinCommand(lease, precompiledBinary, []);
+      proc = spawn(pinned.command, pinned.args, {
+        cwd: agentDir,
+        stdio: ["pipe", "pipe", "pipe"],
+      });
+    } else {
+      const solverPath = join(agentDir, "ts", `day${dayStr}`, `part${part}.ts`);
+
+      if (!existsSync(solverPath)) {
+        resolve({
+          answer: "",
+          timeMs: 0,
+          error: `File not found: ${solverPath}`,
+        });
+        return;
+      }
+
+      // Use a proper async wrapper to avoid top-level await issues
+      const runnerCode = `
+(async () => {
+  const { pathToFileURL } = await import('url');
+  const { readFileSync } = await import('fs');
+  const solver = (await import(pathToFileURL('${solverPath.replace(
+    /\\/g,
+    "/"
+  )}').href)).solver;
+  const input = readFileSync(0, 'utf-8');
+  const start = process.hrtime.bigint();
+  const result = solver.solve(input);
+  const end = process.hrtime.bigint();
+  console.log(JSON.stringify({ answer: result, timeNs: Number(end - start) }));
+})();
+`;
+
+      // Don't use shell: true - it breaks stdin piping
+      const pinned = pinCommand(lease, "npx", ["tsx", "-e", runnerCode]);
+      proc = spawn(pinned.command, pinned.args, {
+        cwd: agentDir,
+        stdio: ["pipe", "pipe", "pipe"],
+      });
+    }
+
+    // EPIPE if the solver exits without reading its input
+    proc.stdin.on("error", () => {});
+    proc.stdin.write(input);
+    proc.stdin.end();
+
+    const stdout = new OutputParser(onRecord ? { onRecord } : {});
+    const stderr = new CappedText();
+
+    proc.stdout.on("data", (data: Buffer) => stdout.write(data));
+    proc.stderr.on("data", (data: Buffer) => stderr.write(data));
+
+    const timeout = setTimeout(() => {
+      proc.kill("SIGKILL");
+      resolve({ answer: "", timeMs: 30000, error: "Timeout" });
+    }, 30000);
+
+    proc.on("close", (code) => {
+      clearTimeout(timeout);
+      const endTime = process.hrtime.bigint();
+      const totalTimeMs = Number(endTime - startTime) / 1_000_000;
+      const output = stdout.end();
+
+      if (code !== 0) {
+        resolve({
+          answer: "",
+          timeMs: totalTimeMs,
+          error: stderr.toString() || `Exit ${code}`,
+        });
+        return;
+      }
+
+      if (language === "c") {
+        // Internal timing (parse + solve), process startup left out
+        const internalTimeMs =
+          (output.times.parse ?? 0) + (output.times.solve ?? 0);
+        resolve({
+          answer: output.answer ?? "",
+          timeMs: internalTimeMs > 0 ? internalTimeMs : totalTimeMs,
+        });
+      } else {
+        // The wrapper prints its JSON last, after any solver logging
+        const lines = output.text.trim().split("\n");
+        const last = lines[lines.length - 1] ?? "";
+        try {
+          const result = JSON.parse(last);
+          resolve({
+            answer: String(result.answer),
+            timeMs: result.timeNs / 1_000_000,
+          });
+        } catch (e) {
+          resolve({
+            answer: last,
+            timeMs: totalTimeMs,
+            error: `Parse error: ${e}`,
+          });
+        }
+      }
+    });
+
+    proc.on("error", (err) => {
+      clearTimeout(timeout);
+      resolve({ answer: "", timeMs: 0, error: err.message });
+    });
+  });
+}
+
+/**
+ * Compile once, run `numRuns` times, store the session
+ */
+export async function runBenchmark(
+  task: BenchmarkTask,
+  input: string | undefined,
+  lease?: CpuLease,
+  onProgress?: (progress: BenchmarkProgress) => void
+): Promise<BenchmarkOutcome> {
+  const agentDir = getAgentDir(task.agent);
+  const outcome = {
+    agent: task.agent,
+    day: task.day,
+    part: task.part,
+    language: task.language,
+    cpus: lease?.cpus ?? [],
+  };
+
+  if (!existsSync(agentDir)) {
+    return { ...outcome, success: false, error: "Agent directory not found" };
+  }
+
+  if (input === undefined) {
+    return { ...outcome, success: false, error: "Input file not found" };
+  }
+
+  // Pre-compile C if needed
+  let precompiledBinary: string | undefined;
+  let buildMode: CBuildMode | undefined;
+  if (task.language === "c") {
+    const result = await compileC(agentDir, task.day, task.part, lease);
+    if ("error" in result) {
+      return { ...outcome, success: false, error: result.error };
+    }
+    precompiledBinary = result.binaryPath;
+    buildMode = result.mode;
+  }
+
+  const times: number[] = [];
+  let answer = "";
+
+  for (let i = 0; i < task.numRuns; i++) {
+    const runIndex = i + 1;
+    const result = await executeSolver(
+      agentDir,
+      task.day,
+      task.part,
+      task.language,
+      input,
+      precompiledBinary,
+      lease,
+      onProgress &&
+        ((record) => {
+          if (record.type === "time" || record.type === "perf") {
+            onProgress({ type: "record", runIndex, record });
+          }
+        })
+    );
+
+    if (result.error) {
+      return { ...outcome, success: false, error: result.error };
+    }
+
+    times.push(result.timeMs);
+    if (i === 0) answer = result.answer;
+    onProgress?.({
+      type: "run",
+      runIndex,
+      totalRuns: task.numRuns,
+      timeMs: result.timeMs,
+    });
+  }
+
+  if (times.length === 0) {
+    return { ...outcome, success: false, error: "No successful runs" };
+  }
+
+  const expectedAnswer = getExpectedAnswer(task.day, task.part, false);
+  const isCorrect = expectedAnswer !== null ? answer === expectedAnswer : null;
+
+  // Store in database (stats + regression check vs previous sessions)
+  const { id: sessionId, stats, regression } = getBenchmarkWriter().write({
+    agent: task.agent,
+    day: task.day,
+    part: task.part,
+    language: task.language,
+    num_runs: task.numRuns,
+    answer,
+    ...(isCorrect !== null && { is_correct: isCorrect }),
+    ...(buildMode && { build_mode: buildMode }),
+    times,
+  });
+
+  return {
+    ...outcome,
+    success: true,
+    answer,
+    isCorrect,
+    stats,
+    regression,
+    sessionId,
+  };
+}
@@ -5,15 +5,17 @@
 export type Agent = "claude" | "codex" | "gemini";
 export type Language = "ts" | "c";
 export type Part = 1 | 2;
+export type PerfVerdict = "regression" | "improvement" | "unchanged" | "insufficient";
 
+// GET /api/days: statements and inputs referenced by hash only
 export interface Day {
   id: number;
-  puzzle1_md: string | null;
-  puzzle2_md: string | null;
-  sample_input: string | null;
+  puzzle1_md_hash: string | null;
+  puzzle2_md_hash: string | null;
+  sample_input_hash: string | null;
   sample_expected_p1: string | null;
   sample_expected_p2: string | null;
-  final_input: string | null;
+  final_input_hash: string | null;
   answer_p1: string | null;
   answer_p2: string | null;
   published_at: string | null;
@@ -21,6 +23,14 @@ export interface Day {
   updated_at: string;
 }
 
+// GET /api/days/:id: contents resolved from the store
+export interface DayWithContent extends Day {
+  puzzle1_md: string | null;
+  puzzle2_md: string | null;
+  sample_input: string | null;
+  final_input: string | null;
+}
+
 export interface Run {
   id: number;
   agent: Agent;
@@ -51,9 +61,50 @@ export interface BenchmarkSession {
   p50_time_ms: number | null;
   p95_time_ms: number | null;
   p99_time_ms: number | null;
+  perf_verdict: PerfVerdict | null;
+  perf_p_value: number | null;
+  perf_delta_pct: number | null;
+  perf_baseline_runs: number | null;
   created_at: string;
 }
 
+// GET /api/leaderboard (podium points, see core/db/src/leaderboard.ts)
+export interface LeaderboardEntry {
+  agent: Agent;
+  points: number;
+  gold: number;
+  silver: number;
+  bronze: number;
+  puzzles: number;
+  total_best_ms: number;
+}
+
+export interface PuzzleBest {
+  agent: Agent;
+  day: number;
+  part: Part;
+  language: Language;
+  session_id: number;
+  best_time_ms: number;
+  points: number;
+}
+
+export interface HistogramBucket {
+  lowMs: number;
+  highMs: number;
+  count: number;
+}
+
+// GET /api/benchmarks/distribution (merged session histograms)
+export interface LatencyDistribution {
+  sessionIds: number[];
+  count: number;
+  min: number | null;
+  max: number | null;
+  percentiles: { p: number; ms: number | null }[];
+  buckets: HistogramBucket[];
+}
+
 export interface DayWithRuns extends Day {
   runs: Run[];
   latestRuns: {
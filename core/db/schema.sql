@@ -1,14 +1,15 @@
 -- 🏆 AoC 2025 Battle Royale - Database Schema
 
 -- Days table: stores puzzle info and expected answers
+-- (statements and inputs live in blobs, referenced by hash)
 CREATE TABLE IF NOT EXISTS days (
     id INTEGER PRIMARY KEY,  -- 0-12 (0 = test day, 1-12 = competition days)
-    puzzle1_md TEXT,
-    puzzle2_md TEXT,
-    sample_input TEXT,
+    puzzle1_md_hash TEXT,
+    puzzle2_md_hash TEXT,
+    sample_input_hash TEXT,
     sample_expected_p1 TEXT,
     sample_expected_p2 TEXT,
-    final_input TEXT,
+    final_input_hash TEXT,
     answer_p1 TEXT,
     answer_p2 TEXT,
     published_at DATETIME,
@@ -16,6 +17,14 @@ CREATE TABLE IF NOT EXISTS days (
     updated_at DATETIME DEFAULT CURRENT_TIMESTAMP
 );
 
+-- Content-addressed store for puzzle statements and inputs
+CREATE TABLE IF NOT EXISTS blobs (
+    hash TEXT PRIMARY KEY,  -- SHA-256 of content (hex)
+    size INTEGER NOT NULL,  -- bytes
+    created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+    content TEXT NOT NULL  -- last: metadata reads skip its overflow pages
+);
+
 -- Runs table: individual solution executions
 CREATE TABLE IF NOT EXISTS runs (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -28,6 +37,8 @@ CREATE TABLE IF NOT EXISTS runs (
     is_correct INTEGER,  -- 1 = true, 0 = false, NULL = not checked
     is_sample INTEGER NOT NULL DEFAULT 0,  -- 1 = sample, 0 = final
     error TEXT,
+    stats TEXT,  -- JSON of the STAT: work counters (AOC_STATS builds)
+    build_mode TEXT CHECK (build_mode IN ('dynamic', 'static', 'nostart')),  -- C only
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
 
     FOREIGN KEY (day) REFERENCES days(id)
@@ -51,6 +62,19 @@ CREATE TABLE IF NOT EXISTS benchmark_sessions (
     p50_time_ms REAL,  -- median
     p95_time_ms REAL,
     p99_time_ms REAL,
+    -- Regression check against the previous sessions (Mann-Whitney U)
+    perf_verdict TEXT CHECK (perf_verdict IN ('regression', 'improvement', 'unchanged', 'insufficient')),
+    perf_p_value REAL,
+    perf_delta_pct REAL,  -- median shift vs baseline, in %
+    perf_baseline_runs INTEGER,
+    -- Samples as a delta-encoded blob (see src/samples.ts), NULL when they
+    -- are stored as benchmark_runs rows
+    samples_blob BLOB,
+    -- Log-bucketed latency histogram (see src/histogram.ts)
+    histogram_blob BLOB,
+    -- C build mode (NULL for TS): baselines and the podium compare like
+    -- with like (see src/builds.ts)
+    build_mode TEXT CHECK (build_mode IN ('dynamic', 'static', 'nostart')),
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
 
     FOREIGN KEY (day) REFERENCES days(id)
@@ -66,11 +90,71 @@ CREATE TABLE IF NOT EXISTS benchmark_runs (
     FOREIGN KEY (session_id) REFERENCES benchmark_sessions(id) ON DELETE CASCADE
 );
 
+-- Best correct session per agent and puzzle, with its podium points
+-- (maintained by the benchmark write path, see src/leaderboard.ts)
+CREATE TABLE IF NOT EXISTS puzzle_best (
+    agent TEXT NOT NULL,
+    day INTEGER NOT NULL,
+    part INTEGER NOT NULL,
+    language TEXT NOT NULL,
+    session_id INTEGER NOT NULL,
+    best_time_ms REAL NOT NULL,  -- lowest p50 among correct sessions
+    points INTEGER NOT NULL DEFAULT 0,  -- 3 / 2 / 1, ties share a step
+
+    PRIMARY KEY (day, part, language, agent)
+);
+
+-- Podium totals per agent (days 1+)
+CREATE TABLE IF NOT EXISTS leaderboard (
+    agent TEXT PRIMARY KEY,
+    points INTEGER NOT NULL DEFAULT 0,
+    gold INTEGER NOT NULL DEFAULT 0,
+    silver INTEGER NOT NULL DEFAULT 0,
+    bronze INTEGER NOT NULL DEFAULT 0,
+    puzzles INTEGER NOT NULL DEFAULT 0,
+    total_best_ms REAL NOT NULL DEFAULT 0
+);
+
+-- c/kernel.h microbenchmarks (`aoc kernels`, POST /api/kernels), one row
+-- per run and one per kernel (see src/kernels.ts)
+CREATE TABLE IF NOT EXISTS kernel_runs (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    agent TEXT NOT NULL CHECK (agent IN ('claude', 'codex', 'gemini')),
+    day INTEGER,  -- input fed to the bench, NULL when it embeds its data
+    file TEXT NOT NULL,  -- bench source, relative to the agent directory
+    build_mode TEXT NOT NULL CHECK (build_mode IN ('dynamic', 'static', 'nostart')),
+    ok INTEGER NOT NULL,  -- 1 = every kernel agreed with the reference
+    created_at DATETIME DEFAULT CURRENT_TIMESTAMP
+);
+
+CREATE TABLE IF NOT EXISTS kernel_results (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    run_id INTEGER NOT NULL,
+    name TEXT NOT NULL,
+    iterations INTEGER NOT NULL,  -- calls per timed sample
+    samples INTEGER NOT NULL,
+    -- Times per call
+    min_ns REAL NOT NULL,
+    median_ns REAL NOT NULL,
+    mean_ns REAL NOT NULL,
+    max_ns REAL NOT NULL,
+    std_dev_ns REAL NOT NULL,
+    ok INTEGER NOT NULL,  -- same answer as the first (reference) kernel
+    answer TEXT,
+
+    FOREIGN KEY (run_id) REFERENCES kernel_runs(id) ON DELETE CASCADE
+);
+
 -- Indexes for common queries
 CREATE INDEX IF NOT EXISTS idx_runs_agent_day ON runs(agent, day);
 CREATE INDEX IF NOT EXISTS idx_runs_created ON runs(created_at);
+-- Covers "latest final run per (day, agent, language, part)" (rowid included)
+CREATE INDEX IF NOT EXISTS idx_runs_latest ON runs(day, agent, language, part, is_sample, created_at);
 CREATE INDEX IF NOT EXISTS idx_benchmark_sessions_agent_day ON benchmark_sessions(agent, day);
+CREATE INDEX IF NOT EXISTS idx_benchmark_sessions_puzzle ON benchmark_sessions(agent, day, part, language, created_at);
 CREATE INDEX IF NOT EXISTS idx_benchmark_runs_session ON benchmark_runs(session_id);
+CREATE INDEX IF NOT EXISTS idx_kernel_runs_file ON kernel_runs(agent, file, created_at);
+CREATE INDEX IF NOT EXISTS idx_kernel_results_run ON kernel_results(run_id);
 
 -- Trigger to update updated_at on days
 CREATE TRIGGER IF NOT EXISTS update_days_timestamp
@@ -0,0 +1,298 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Benchmark Sessions
+ *
+ * Shared write path for benchmark sessions. Used by AocDatabase and by the
+ * dashboard endpoints, which hold their own connection.
+ */
+
+import type Database from "better-sqlite3";
+import { computeStats, compareToBaseline } from "./stats.js";
+import { encodeSamples, decodeSamples } from "./samples.js";
+import type { SampleStorage } from "./samples.js";
+import { LatencyHistogram } from "./histogram.js";
+import { recordPuzzleResult } from "./leaderboard.js";
+import { storedBuildMode } from "./builds.js";
+import type {
+  BenchmarkKey,
+  CreateBenchmarkInput,
+  CreatedBenchmark,
+  RegressionOptions,
+} from "./types.js";
+
+// Number of previous sessions pooled into the regression baseline
+export const BASELINE_SESSIONS = 5;
+
+// Rows per multi-row INSERT (3 params each, well below SQLite's limit)
+const RUN_INSERT_CHUNK = 500;
+
+export interface BenchmarkWriteOptions {
+  // "rows": one benchmark_runs row per sample, "blob": samples_blob
+  storage?: SampleStorage;
+  regression?: RegressionOptions;
+}
+
+/**
+ * Samples of the last `sessions` sessions for the same puzzle and C build
+ * mode, skipping sessions that produced a wrong answer
+ */
+export function getBaselineSamples(
+  db: Database.Database,
+  key: BenchmarkKey,
+  sessions = BASELINE_SESSIONS
+): number[] {
+  const rows = db
+    .prepare(
+      `
+      SELECT id, samples_blob FROM benchmark_sessions
+      WHERE agent = ? AND day = ? AND part = ? AND language = ?
+        AND build_mode IS ?
+        AND (is_correct IS NULL OR is_correct = 1)
+      ORDER BY created_at DESC, id DESC
+      LIMIT ?
+    `
+    )
+    .all(
+      key.agent,
+      key.day,
+      key.part,
+      key.language,
+      storedBuildMode(key),
+      sessions
+    ) as {
+    id: number;
+    samples_blob: Buffer | null;
+  }[];
+
+  const samples: number[] = [];
+  const rowSessions: number[] = [];
+
+  for (const row of rows) {
+    if (row.samples_blob) {
+      for (const time of decodeSamples(row.samples_blob)) samples.push(time);
+    } else {
+      rowSessions.push(row.id);
+    }
+  }
+
+  if (rowSessions.length > 0) {
+    const times = db
+      .prepare(
+        `SELECT time_ms FROM benchmark_runs WHERE session_id IN (${rowSessions
+          .map(() => "?")
+          .join(", ")})`
+      )
+      .pluck()
+      .all(...rowSessions) as number[];
+    for (const time of times) samples.push(time);
+  }
+
+  return samples;
+}
+
+const runStatements = new WeakMap<
+  Database.Database,
+  Map<number, Database.Statement>
+>();
+
+/**
+ * Insert runs with multi-row INSERTs. Call inside a transaction.
+ */
+export function insertRuns(
+  db: Database.Database,
+  runs: { sessionId: number; times: number[] }[]
+): void {
+  let cache = runStatements.get(db);
+  if (!cache) {
+    cache = new Map();
+    runStatements.set(db, cache);
+  }
+
+  const statement = (rows: number) => {
+    let stmt = cache!.get(rows);
+    if (!stmt) {
+      const values = Array(rows).fill("(?, ?, ?)").join(", ");
+      stmt = db.prepare(
+        `INSERT INTO benchmark_runs (session_id, run_index, time_ms) VALUES ${values}`
+      );
+      cache!.set(rows, stmt);
+    }
+    return stmt;
+  };
+
+  const params: number[] = [];
+  const flush = () => {
+    if (params.length === 0) return;
+    statement(params.length / 3).run(...params);
+    params.length = 0;
+  };
+
+  for (const { sessionId, times } of runs) {
+    times.forEach((time, index) => {
+      params.push(sessionId, index, time);
+      if (params.length === RUN_INSERT_CHUNK * 3) flush();
+    });
+  }
+  flush();
+}
+
+/**
+ * Insert the session row only (and update the leaderboard): without the
+ * samples blob, the caller is responsible for inserting the runs
+ */
+function insertSessionRow(
+  db: Database.Database,
+  input: CreateBenchmarkInput,
+  options: BenchmarkWriteOptions,
+  withBlob = options.storage === "blob"
+): CreatedBenchmark {
+  const stats = computeStats(input.times);
+  const regression = compareToBaseline(
+    getBaselineSamples(db, input),
+    input.times,
+    options.regression
+  );
+
+  const result = db
+    .prepare(
+      `
+    INSERT INTO benchmark_sessions (
+      agent, day, part, language, num_runs, answer, is_correct,
+      avg_time_ms, min_time_ms, max_time_ms, std_dev_ms,
+      p50_time_ms, p95_time_ms, p99_time_ms,
+      perf_verdict, perf_p_value, perf_delta_pct, perf_baseline_runs,
+      samples_blob, histogram_blob, build_mode
+    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+  `
+    )
+    .run(
+      input.agent,
+      input.day,
+      input.part,
+      input.language,
+      input.num_runs,
+      input.answer ?? null,
+      input.is_correct === undefined ? null : input.is_correct ? 1 : 0,
+      stats.avg,
+      stats.min,
+      stats.max,
+      stats.stdDev,
+      stats.p50,
+      stats.p95,
+      stats.p99,
+      regression.verdict,
+      regression.pValue,
+      regression.deltaPct,
+      regression.baselineRuns,
+      withBlob ? encodeSamples(input.times) : null,
+      LatencyHistogram.fromMs(input.times).encode(),
+      storedBuildMode(input)
+    );
+
+  const id = Number(result.lastInsertRowid);
+  recordPuzzleResult(db, {
+    agent: input.agent,
+    day: input.day,
+    part: input.part,
+    language: input.language,
+    ...(input.build_mode && { build_mode: input.build_mode }),
+    sessionId: id,
+    isCorrect: input.is_correct ?? null,
+    p50TimeMs: input.times.length > 0 ? stats.p50 : null,
+  });
+
+  return { id, stats, regression };
+}
+
+/**
+ * Insert a session and its runs, with stats and a regression verdict
+ * against the previous sessions of the same puzzle
+ */
+export function insertBenchmarkSession(
+  db: Database.Database,
+  input: CreateBenchmarkInput,
+  options: BenchmarkWriteOptions = {}
+): CreatedBenchmark {
+  const write = db.transaction(() => {
+    const created = insertSessionRow(db, input, options);
+    if (options.storage !== "blob") {
+      insertRuns(db, [{ sessionId: created.id, times: input.times }]);
+    }
+    return created;
+  });
+
+  return write();
+}
+
+export interface BenchmarkWriterOptions extends BenchmarkWriteOptions {
+  // Flush as soon as this many runs are pending
+  maxPendingRuns?: number;
+  // Otherwise flush this long after the first pending session
+  flushDelayMs?: number;
+}
+
+/**
+ * Buffered write path for sweeps: session rows are written right away
+ * (callers need the id and the verdict), runs are batched into large
+ * transactions off the hot path. Until then a "rows" session keeps its
+ * samples as a blob, committed with the row: a crash before the flush
+ * loses no samples, and readers (baseline included) never see it empty.
+ */
+export class BenchmarkWriter {
+  private pending: { sessionId: number; times: number[] }[] = [];
+  private pendingRuns = 0;
+  private timer: ReturnType<typeof setTimeout> | null = null;
+
+  constructor(
+    private db: Database.Database,
+    private options: BenchmarkWriterOptions = {}
+  ) {}
+
+  write(input: CreateBenchmarkInput): CreatedBenchmark {
+    // Session row, samples and leaderboard update are committed together
+    const created = this.db.transaction(() =>
+      insertSessionRow(this.db, input, this.options, true)
+    )();
+
+    if (this.options.storage === "blob") return created;
+
+    this.pending.push({ sessionId: created.id, times: input.times });
+    this.pendingRuns += input.times.length;
+
+    if (this.pendingRuns >= (this.options.maxPendingRuns ?? 20_000)) {
+      this.flush();
+    } else if (!this.timer) {
+      this.timer = setTimeout(
+        () => this.flush(),
+        this.options.flushDelayMs ?? 250
+      );
+      this.timer.unref?.();
+    }
+
+    return created;
+  }
+
+  get pendingCount(): number {
+    return this.pendingRuns;
+  }
+
+  flush(): void {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    if (this.pending.length === 0) return;
+
+    const batch = this.pending;
+    this.pending = [];
+    this.pendingRuns = 0;
+
+    // The rows replace the interim blob in the same transaction
+    const dropBlob = this.db.prepare(
+      "UPDATE benchmark_sessions SET samples_blob = NULL WHERE id = ?"
+    );
+    this.db.transaction(() => {
+      insertRuns(this.db, batch);
+      for (const { sessionId } of batch) dropBlob.run(sessionId);
+    })();
+  }
+}
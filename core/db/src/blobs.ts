@@ -0,0 +1,149 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Content Store
+ *
+ * Puzzle statements and inputs are stored once per content in `blobs`,
+ * keyed by their SHA-256. `days` only keeps the hashes, so listing days
+ * never reads the contents (day 0's input alone is ~350 KB), and clients
+ * can cache a blob forever since its hash changes with it.
+ */
+
+import type Database from "better-sqlite3";
+import { createHash } from "node:crypto";
+
+export const DAY_CONTENT_FIELDS = [
+  "puzzle1_md",
+  "puzzle2_md",
+  "sample_input",
+  "final_input",
+] as const;
+
+export type DayContentField = (typeof DAY_CONTENT_FIELDS)[number];
+
+export type DayContent = Record<DayContentField, string | null>;
+
+export function contentHashColumn(field: DayContentField): string {
+  return `${field}_hash`;
+}
+
+// days columns without any content (list endpoints)
+export const DAY_COLUMNS = [
+  "id",
+  ...DAY_CONTENT_FIELDS.map(contentHashColumn),
+  "sample_expected_p1",
+  "sample_expected_p2",
+  "answer_p1",
+  "answer_p2",
+  "published_at",
+  "created_at",
+  "updated_at",
+].join(", ");
+
+export function hashContent(content: string): string {
+  return createHash("sha256").update(content, "utf-8").digest("hex");
+}
+
+/**
+ * Store a content (no-op when already stored) and return its hash
+ */
+export function putBlob(db: Database.Database, content: string): string {
+  const hash = hashContent(content);
+  db.prepare(
+    "INSERT OR IGNORE INTO blobs (hash, content, size) VALUES (?, ?, ?)"
+  ).run(hash, content, Buffer.byteLength(content, "utf-8"));
+  return hash;
+}
+
+export function getBlob(db: Database.Database, hash: string): string | null {
+  const content = db
+    .prepare("SELECT content FROM blobs WHERE hash = ?")
+    .pluck()
+    .get(hash) as string | undefined;
+  return content ?? null;
+}
+
+/**
+ * Point a day field to a new content (null clears it)
+ */
+export function setDayContent(
+  db: Database.Database,
+  dayId: number,
+  field: DayContentField,
+  content: string | null
+): string | null {
+  const hash = content === null ? null : putBlob(db, content);
+  db.prepare(
+    `UPDATE days SET ${contentHashColumn(field)} = ? WHERE id = ?`
+  ).run(hash, dayId);
+  return hash;
+}
+
+/**
+ * Contents of a day, resolved from the store
+ */
+export function getDayContent(
+  db: Database.Database,
+  dayId: number
+): DayContent | undefined {
+  const joins = DAY_CONTENT_FIELDS.map(
+    (field, i) =>
+      `LEFT JOIN blobs b${i} ON b${i}.hash = d.${contentHashColumn(field)}`
+  ).join("\n");
+  const columns = DAY_CONTENT_FIELDS.map(
+    (field, i) => `b${i}.content AS ${field}`
+  ).join(", ");
+
+  return db
+    .prepare(`SELECT ${columns} FROM days d ${joins} WHERE d.id = ?`)
+    .get(dayId) as DayContent | undefined;
+}
+
+/**
+ * Move contents still stored inline in `days` (databases created before
+ * the store) into `blobs`, then drop the old columns
+ */
+export function migrateDayContentToBlobs(db: Database.Database): number {
+  const columns = new Set(
+    (db.prepare("PRAGMA table_info(days)").all() as { name: string }[]).map(
+      (c) => c.name
+    )
+  );
+  const legacy = DAY_CONTENT_FIELDS.filter((field) => columns.has(field));
+  if (legacy.length === 0) return 0;
+
+  let moved = 0;
+
+  db.transaction(() => {
+    const rows = db
+      .prepare(`SELECT id, ${legacy.join(", ")} FROM days`)
+      .all() as ({ id: number } & Partial<DayContent>)[];
+
+    for (const row of rows) {
+      for (const field of legacy) {
+        const content = row[field];
+        if (content === null || content === undefined) continue;
+        setDayContent(db, row.id, field, content);
+        moved++;
+      }
+    }
+
+    for (const field of legacy) {
+      db.exec(`ALTER TABLE days DROP COLUMN ${field}`);
+    }
+  })();
+
+  return moved;
+}
+
+/**
+ * Delete contents no day points to anymore
+ */
+export function deleteUnreferencedBlobs(db: Database.Database): number {
+  const referenced = DAY_CONTENT_FIELDS.map((field) => {
+    const column = contentHashColumn(field);
+    return `SELECT ${column} FROM days WHERE ${column} IS NOT NULL`;
+  }).join(" UNION ");
+
+  return db
+    .prepare(`DELETE FROM blobs WHERE hash NOT IN (${referenced})`)
+    .run().changes;
+}
@@ -0,0 +1,24 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - C Build Modes
+ *
+ * Runs and sessions remember the C build mode they were measured with:
+ * static and nostart builds skip the loader, so their timings are only
+ * compared with sessions of the same mode, and only the default mode
+ * scores on the podium.
+ */
+
+import type { BuildMode, Language } from "./types.js";
+
+// Mode of every C session recorded before modes were stored
+export const DEFAULT_BUILD_MODE: BuildMode = "dynamic";
+
+/**
+ * Value of the build_mode column: the C mode (default when not given),
+ * null for TS
+ */
+export function storedBuildMode(key: {
+  language: Language;
+  build_mode?: BuildMode | null;
+}): BuildMode | null {
+  return key.language === "c" ? key.build_mode ?? DEFAULT_BUILD_MODE : null;
+}
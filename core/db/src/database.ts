@@ -6,50 +6,136 @@ import Database from "better-sqlite3";
 import { readFileSync } from "node:fs";
 import { join, dirname } from "node:path";
 import { fileURLToPath } from "node:url";
+import { applyMigrations } from "./migrations.js";
+import {
+  getBaselineSamples,
+  insertBenchmarkSession,
+  BASELINE_SESSIONS,
+} from "./benchmarks.js";
+import type { BenchmarkWriteOptions } from "./benchmarks.js";
+import { storedBuildMode } from "./builds.js";
+import { getSessionSamples } from "./samples.js";
+import { mergeSessionHistograms } from "./histogram.js";
+import {
+  DAY_COLUMNS,
+  DAY_CONTENT_FIELDS,
+  getDayContent,
+  setDayContent,
+  migrateDayContentToBlobs,
+} from "./blobs.js";
+import type { DayContentField } from "./blobs.js";
+import { insertKernelRun, getKernelRuns } from "./kernels.js";
+import type { KernelRunFilter } from "./kernels.js";
+import {
+  ensureLeaderboard,
+  getLeaderboard,
+  getPuzzleBests,
+} from "./leaderboard.js";
+import type { LatencyHistogram } from "./histogram.js";
 import type {
   Day,
+  DayWithContent,
   Run,
   BenchmarkSession,
   BenchmarkRun,
+  BenchmarkKey,
   CreateRunInput,
   UpdateDayInput,
   CreateBenchmarkInput,
-  BenchmarkStats,
+  CreatedBenchmark,
+  CreateKernelRunInput,
+  KernelRun,
+  Agent,
+  LeaderboardEntry,
+  PuzzleBest,
 } from "./types.js";
 
 const __dirname = dirname(fileURLToPath(import.meta.url));
 
-function computeStats(times: number[]): BenchmarkStats {
-  const sorted = [...times].sort((a, b) => a - b);
-  const n = sorted.length;
-
-  const avg = times.reduce((a, b) => a + b, 0) / n;
-  const min = sorted[0]!;
-  const max = sorted[n - 1]!;
+export interface AocDatabaseOptions {
+  // Open an existing database without applying schema or seeding days
+  readonly?: boolean;
+}
 
-  const variance = times.reduce((sum, t) => sum + Math.pow(t - avg, 2), 0) / n;
-  const stdDev = Math.sqrt(variance);
+interface RunRow {
+  id: number;
+  agent: string;
+  day: number;
+  part: number;
+  language: string;
+  answer: string | null;
+  time_ms: number;
+  is_correct: number | null;
+  is_sample: number;
+  error: string | null;
+  stats: string | null;
+  build_mode: string | null;
+  created_at: string;
+}
 
-  const percentile = (p: number) => {
-    const idx = Math.ceil((p / 100) * n) - 1;
-    return sorted[Math.max(0, Math.min(n - 1, idx))]!;
+function toRun(row: RunRow): Run {
+  return {
+    ...row,
+    agent: row.agent as Run["agent"],
+    part: row.part as Run["part"],
+    language: row.language as Run["language"],
+    is_correct: row.is_correct === null ? null : row.is_correct === 1,
+    is_sample: row.is_sample === 1,
+    stats: row.stats === null ? null : (JSON.parse(row.stats) as Run["stats"]),
+    build_mode: row.build_mode as Run["build_mode"],
   };
+}
 
+interface BenchmarkSessionRow {
+  id: number;
+  agent: string;
+  day: number;
+  part: number;
+  language: string;
+  num_runs: number;
+  answer: string | null;
+  is_correct: number | null;
+  avg_time_ms: number | null;
+  min_time_ms: number | null;
+  max_time_ms: number | null;
+  std_dev_ms: number | null;
+  p50_time_ms: number | null;
+  p95_time_ms: number | null;
+  p99_time_ms: number | null;
+  perf_verdict: string | null;
+  perf_p_value: number | null;
+  perf_delta_pct: number | null;
+  perf_baseline_runs: number | null;
+  samples_blob: Buffer | null;
+  histogram_blob: Buffer | null;
+  build_mode: string | null;
+  created_at: string;
+}
+
+function toBenchmarkSession(row: BenchmarkSessionRow): BenchmarkSession {
+  // Samples are read through getBenchmarkRuns, histograms through
+  // getBenchmarkHistogram
+  const { samples_blob, histogram_blob, ...session } = row;
   return {
-    avg,
-    min,
-    max,
-    stdDev,
-    p50: percentile(50),
-    p95: percentile(95),
-    p99: percentile(99),
+    ...session,
+    agent: session.agent as BenchmarkSession["agent"],
+    part: session.part as BenchmarkSession["part"],
+    language: session.language as BenchmarkSession["language"],
+    is_correct: session.is_correct === null ? null : session.is_correct === 1,
+    perf_verdict: session.perf_verdict as BenchmarkSession["perf_verdict"],
+    build_mode: session.build_mode as BenchmarkSession["build_mode"],
   };
 }
 
 export class AocDatabase {
   private db: Database.Database;
 
-  constructor(dbPath: string) {
+  constructor(dbPath: string, options: AocDatabaseOptions = {}) {
+    if (options.readonly) {
+      this.db = new Database(dbPath, { readonly: true, fileMustExist: true });
+      return;
+    }
+
     this.db = new Database(dbPath);
     this.db.pragma("journal_mode = WAL");
     this.db.pragma("foreign_keys = ON");
@@ -61,6 +147,9 @@ export class AocDatabase {
     const schemaPath = join(__dirname, "..", "schema.sql");
     const schema = readFileSync(schemaPath, "utf-8");
     this.db.exec(schema);
+    applyMigrations(this.db);
+    migrateDayContentToBlobs(this.db);
+    ensureLeaderboard(this.db);
 
     // Initialize days 1-25 if not exist
     const insertDay = this.db.prepare(`
@@ -77,32 +166,45 @@ export class AocDatabase {
   // ═══════════════════════════════════════════════════════════════
 
   getAllDays(): Day[] {
-    return this.db.prepare("SELECT * FROM days ORDER BY id").all() as Day[];
+    return this.db
+      .prepare(`SELECT ${DAY_COLUMNS} FROM days ORDER BY id`)
+      .all() as Day[];
   }
 
-  getDay(id: number): Day | undefined {
-    return this.db.prepare("SELECT * FROM days WHERE id = ?").get(id) as
-      | Day
-      | undefined;
+  getDay(id: number): DayWithContent | undefined {
+    const day = this.db
+      .prepare(`SELECT ${DAY_COLUMNS} FROM days WHERE id = ?`)
+      .get(id) as Day | undefined;
+
+    if (!day) return undefined;
+    return { ...day, ...getDayContent(this.db, id)! };
   }
 
   updateDay(id: number, data: UpdateDayInput): void {
     const fields: string[] = [];
     const values: unknown[] = [];
-
-    for (const [key, value] of Object.entries(data)) {
-      if (value !== undefined) {
-        fields.push(`${key} = ?`);
-        values.push(value);
+    const contentFields: readonly string[] = DAY_CONTENT_FIELDS;
+
+    const update = this.db.transaction(() => {
+      for (const [key, value] of Object.entries(data)) {
+        if (value === undefined) continue;
+        if (contentFields.includes(key)) {
+          setDayContent(this.db, id, key as DayContentField, value);
+        } else {
+          fields.push(`${key} = ?`);
+          values.push(value);
+        }
       }
-    }
 
-    if (fields.length === 0) return;
+      if (fields.length === 0) return;
 
-    values.push(id);
-    this.db
-      .prepare(`UPDATE days SET ${fields.join(", ")} WHERE id = ?`)
-      .run(...values);
+      values.push(id);
+      this.db
+        .prepare(`UPDATE days SET ${fields.join(", ")} WHERE id = ?`)
+        .run(...values);
+    });
+
+    update();
   }
 
   setDayAnswer(id: number, part: 1 | 2, answer: string): void {
@@ -126,8 +228,8 @@ export class AocDatabase {
     const result = this.db
       .prepare(
         `
-      INSERT INTO runs (agent, day, part, language, answer, time_ms, is_correct, is_sample, error)
-      VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)
+      INSERT INTO runs (agent, day, part, language, answer, time_ms, is_correct, is_sample, error, stats, build_mode)
+      VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     `
       )
       .run(
@@ -139,7 +241,9 @@ export class AocDatabase {
         input.time_ms,
         input.is_correct === undefined ? null : input.is_correct ? 1 : 0,
         input.is_sample ? 1 : 0,
-        input.error ?? null
+        input.error ?? null,
+        input.stats ? JSON.stringify(input.stats) : null,
+        storedBuildMode(input)
       );
 
     return Number(result.lastInsertRowid);
@@ -147,31 +251,10 @@ export class AocDatabase {
 
   getRun(id: number): Run | undefined {
     const row = this.db.prepare("SELECT * FROM runs WHERE id = ?").get(id) as
-      | {
-          id: number;
-          agent: string;
-          day: number;
-          part: number;
-          language: string;
-          answer: string | null;
-          time_ms: number;
-          is_correct: number | null;
-          is_sample: number;
-          error: string | null;
-          created_at: string;
-        }
+      | RunRow
       | undefined;
 
-    if (!row) return undefined;
-
-    return {
-      ...row,
-      agent: row.agent as Run["agent"],
-      part: row.part as Run["part"],
-      language: row.language as Run["language"],
-      is_correct: row.is_correct === null ? null : row.is_correct === 1,
-      is_sample: row.is_sample === 1,
-    };
+    return row ? toRun(row) : undefined;
   }
 
   getRunsForDay(day: number): Run[] {
@@ -181,28 +264,9 @@ export class AocDatabase {
       SELECT * FROM runs WHERE day = ? ORDER BY created_at DESC
     `
       )
-      .all(day) as Array<{
-      id: number;
-      agent: string;
-      day: number;
-      part: number;
-      language: string;
-      answer: string | null;
-      time_ms: number;
-      is_correct: number | null;
-      is_sample: number;
-      error: string | null;
-      created_at: string;
-    }>;
-
-    return rows.map((row) => ({
-      ...row,
-      agent: row.agent as Run["agent"],
-      part: row.part as Run["part"],
-      language: row.language as Run["language"],
-      is_correct: row.is_correct === null ? null : row.is_correct === 1,
-      is_sample: row.is_sample === 1,
-    }));
+      .all(day) as RunRow[];
+
+    return rows.map(toRun);
   }
 
   getLatestRuns(limit = 50): Run[] {
@@ -212,28 +276,9 @@ export class AocDatabase {
       SELECT * FROM runs ORDER BY created_at DESC LIMIT ?
     `
       )
-      .all(limit) as Array<{
-      id: number;
-      agent: string;
-      day: number;
-      part: number;
-      language: string;
-      answer: string | null;
-      time_ms: number;
-      is_correct: number | null;
-      is_sample: number;
-      error: string | null;
-      created_at: string;
-    }>;
-
-    return rows.map((row) => ({
-      ...row,
-      agent: row.agent as Run["agent"],
-      part: row.part as Run["part"],
-      language: row.language as Run["language"],
-      is_correct: row.is_correct === null ? null : row.is_correct === 1,
-      is_sample: row.is_sample === 1,
-    }));
+      .all(limit) as RunRow[];
+
+    return rows.map(toRun);
   }
 
   // ═══════════════════════════════════════════════════════════════
@@ -241,97 +286,65 @@ export class AocDatabase {
   // ═══════════════════════════════════════════════════════════════
 
   createBenchmark(input: CreateBenchmarkInput): number {
-    const stats = computeStats(input.times);
-
-    const result = this.db
-      .prepare(
-        `
-      INSERT INTO benchmark_sessions (
-        agent, day, part, language, num_runs, answer, is_correct,
-        avg_time_ms, min_time_ms, max_time_ms, std_dev_ms,
-        p50_time_ms, p95_time_ms, p99_time_ms
-      ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
-    `
-      )
-      .run(
-        input.agent,
-        input.day,
-        input.part,
-        input.language,
-        input.num_runs,
-        input.answer ?? null,
-        input.is_correct === undefined ? null : input.is_correct ? 1 : 0,
-        stats.avg,
-        stats.min,
-        stats.max,
-        stats.stdDev,
-        stats.p50,
-        stats.p95,
-        stats.p99
-      );
-
-    const sessionId = Number(result.lastInsertRowid);
-
-    // Insert individual runs
-    const insertRun = this.db.prepare(`
-      INSERT INTO benchmark_runs (session_id, run_index, time_ms)
-      VALUES (?, ?, ?)
-    `);
-
-    const insertMany = this.db.transaction((times: number[]) => {
-      times.forEach((time, index) => {
-        insertRun.run(sessionId, index, time);
-      });
-    });
+    return this.createBenchmarkSession(input).id;
+  }
 
-    insertMany(input.times);
+  /**
+   * Same as createBenchmark, but also returns the computed stats and the
+   * regression verdict against the previous sessions
+   */
+  createBenchmarkSession(
+    input: CreateBenchmarkInput,
+    options: BenchmarkWriteOptions = {}
+  ): CreatedBenchmark {
+    return insertBenchmarkSession(this.db, input, options);
+  }
 
-    return sessionId;
+  getBaselineSamples(key: BenchmarkKey, sessions = BASELINE_SESSIONS): number[] {
+    return getBaselineSamples(this.db, key, sessions);
   }
 
   getBenchmarkSession(id: number): BenchmarkSession | undefined {
     const row = this.db
       .prepare("SELECT * FROM benchmark_sessions WHERE id = ?")
-      .get(id) as
-      | {
-          id: number;
-          agent: string;
-          day: number;
-          part: number;
-          language: string;
-          num_runs: number;
-          answer: string | null;
-          is_correct: number | null;
-          avg_time_ms: number | null;
-          min_time_ms: number | null;
-          max_time_ms: number | null;
-          std_dev_ms: number | null;
-          p50_time_ms: number | null;
-          p95_time_ms: number | null;
-          p99_time_ms: number | null;
-          created_at: string;
-        }
-      | undefined;
-
-    if (!row) return undefined;
+      .get(id) as BenchmarkSessionRow | undefined;
 
-    return {
-      ...row,
-      agent: row.agent as BenchmarkSession["agent"],
-      part: row.part as BenchmarkSession["part"],
-      language: row.language as BenchmarkSession["language"],
-      is_correct: row.is_correct === null ? null : row.is_correct === 1,
-    };
+    return row ? toBenchmarkSession(row) : undefined;
   }
 
   getBenchmarkRuns(sessionId: number): BenchmarkRun[] {
-    return this.db
+    const runs = this.db
       .prepare(
         `
       SELECT * FROM benchmark_runs WHERE session_id = ? ORDER BY run_index
     `
       )
       .all(sessionId) as BenchmarkRun[];
+
+    if (runs.length > 0) return runs;
+
+    // Sessions stored as a samples blob have no run rows (id 0)
+    return getSessionSamples(this.db, sessionId).map((time_ms, run_index) => ({
+      id: 0,
+      session_id: sessionId,
+      run_index,
+      time_ms,
+    }));
+  }
+
+  /**
+   * Latency histogram of one or several sessions merged together
+   */
+  getBenchmarkHistogram(sessionIds: number[]): LatencyHistogram {
+    return mergeSessionHistograms(this.db, sessionIds);
+  }
+
+  getLeaderboard(): LeaderboardEntry[] {
+    return getLeaderboard(this.db);
+  }
+
+  getPuzzleBests(agent?: Agent): PuzzleBest[] {
+    return getPuzzleBests(this.db, agent);
   }
 
   getLatestBenchmarks(limit = 20): BenchmarkSession[] {
@@ -341,32 +354,9 @@ export class AocDatabase {
       SELECT * FROM benchmark_sessions ORDER BY created_at DESC, id DESC LIMIT ?
     `
       )
-      .all(limit) as Array<{
-      id: number;
-      agent: string;
-      day: number;
-      part: number;
-      language: string;
-      num_runs: number;
-      answer: string | null;
-      is_correct: number | null;
-      avg_time_ms: number | null;
-      min_time_ms: number | null;
-      max_time_ms: number | null;
-      std_dev_ms: number | null;
-      p50_time_ms: number | null;
-      p95_time_ms: number | null;
-      p99_time_ms: number | null;
-      created_at: string;
-    }>;
-
-    return rows.map((row) => ({
-      ...row,
-      agent: row.agent as BenchmarkSession["agent"],
-      part: row.part as BenchmarkSession["part"],
-      language: row.language as BenchmarkSession["language"],
-      is_correct: row.is_correct === null ? null : row.is_correct === 1,
-    }));
+      .all(limit) as BenchmarkSessionRow[];
+
+    return rows.map(toBenchmarkSession);
   }
 
   getBenchmarksForDay(day: number): BenchmarkSession[] {
@@ -376,32 +366,21 @@ export class AocDatabase {
       SELECT * FROM benchmark_sessions WHERE day = ? ORDER BY created_at DESC
     `
       )
-      .all(day) as Array<{
-      id: number;
-      agent: string;
-      day: number;
-      part: number;
-      language: string;
-      num_runs: number;
-      answer: string | null;
-      is_correct: number | null;
-      avg_time_ms: number | null;
-      min_time_ms: number | null;
-      max_time_ms: number | null;
-      std_dev_ms: number | null;
-      p50_time_ms: number | null;
-      p95_time_ms: number | null;
-      p99_time_ms: number | null;
-      created_at: string;
-    }>;
-
-    return rows.map((row) => ({
-      ...row,
-      agent: row.agent as BenchmarkSession["agent"],
-      part: row.part as BenchmarkSession["part"],
-      language: row.language as BenchmarkSession["language"],
-      is_correct: row.is_correct === null ? null : row.is_correct === 1,
-    }));
+      .all(day) as BenchmarkSessionRow[];
+
+    return rows.map(toBenchmarkSession);
+  }
+
+  // ═══════════════════════════════════════════════════════════════
+  // Kernels
+  // ═══════════════════════════════════════════════════════════════
+
+  createKernelRun(input: CreateKernelRunInput): number {
+    return insertKernelRun(this.db, input);
+  }
+
+  getKernelRuns(filter: KernelRunFilter = {}): KernelRun[] {
+    return getKernelRuns(this.db, filter);
   }
 
   // ═══════════════════════════════════════════════════════════════
@@ -0,0 +1,302 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Latency Histograms
+ *
+ * HDR-style log-linear histogram of nanosecond timings: values below 2^8
+ * are exact, then every power of two is split into 128 linear buckets
+ * (relative error < 0.8%). Histograms are mergeable and percentile queries
+ * walk the buckets once, so any percentile of any set of sessions costs
+ * O(buckets) instead of sorting every run.
+ *
+ * Serialized format (v1, sparse):
+ *   u8      version (1)
+ *   u8      sub-bucket bits
+ *   varint  min ns, varint max ns
+ *   varint  number of non-empty buckets
+ *   varint  bucket index delta, varint count   (per non-empty bucket)
+ */
+
+import type Database from "better-sqlite3";
+import { getSessionSamples } from "./samples.js";
+
+const HISTOGRAM_FORMAT_V1 = 1;
+const SUB_BUCKET_BITS = 8;
+const SUB_BUCKET_COUNT = 2 ** SUB_BUCKET_BITS;
+const SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;
+
+export interface PercentileValue {
+  p: number;
+  ms: number | null;
+}
+
+export interface HistogramBucket {
+  lowMs: number;
+  highMs: number;
+  count: number;
+}
+
+function writeVarint(out: number[], value: number): void {
+  while (value >= 0x80) {
+    out.push((value % 0x80) | 0x80);
+    value = Math.floor(value / 0x80);
+  }
+  out.push(value);
+}
+
+export function bucketIndex(ns: number): number {
+  if (ns < SUB_BUCKET_COUNT) return ns;
+
+  // Exact floor(log2) for values above 2^32 as well
+  let magnitude = Math.floor(Math.log2(ns));
+  if (2 ** magnitude > ns) magnitude--;
+  else if (2 ** (magnitude + 1) <= ns) magnitude++;
+
+  const shift = magnitude - SUB_BUCKET_BITS + 1;
+  const sub = Math.floor(ns / 2 ** shift);
+  return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + sub - SUB_BUCKET_HALF;
+}
+
+/**
+ * Range of nanosecond values [low, high] counted in a bucket
+ */
+export function bucketRange(index: number): [number, number] {
+  if (index < SUB_BUCKET_COUNT) return [index, index];
+
+  const offset = index - SUB_BUCKET_COUNT;
+  const shift = Math.floor(offset / SUB_BUCKET_HALF) + 1;
+  const sub = (offset % SUB_BUCKET_HALF) + SUB_BUCKET_HALF;
+  return [sub * 2 ** shift, (sub + 1) * 2 ** shift - 1];
+}
+
+export class LatencyHistogram {
+  private counts: number[] = [];
+  totalCount = 0;
+  minNs = Infinity;
+  maxNs = 0;
+
+  static fromMs(timesMs: number[]): LatencyHistogram {
+    const histogram = new LatencyHistogram();
+    for (const ms of timesMs) histogram.recordMs(ms);
+    return histogram;
+  }
+
+  recordMs(ms: number, count = 1): void {
+    this.recordNs(Math.max(0, Math.round(ms * 1_000_000)), count);
+  }
+
+  recordNs(ns: number, count = 1): void {
+    const index = bucketIndex(ns);
+    while (this.counts.length <= index) this.counts.push(0);
+    this.counts[index]! += count;
+    this.totalCount += count;
+    if (ns < this.minNs) this.minNs = ns;
+    if (ns > this.maxNs) this.maxNs = ns;
+  }
+
+  merge(other: LatencyHistogram): this {
+    while (this.counts.length < other.counts.length) this.counts.push(0);
+    other.counts.forEach((count, index) => {
+      this.counts[index]! += count;
+    });
+    this.totalCount += other.totalCount;
+    this.minNs = Math.min(this.minNs, other.minNs);
+    this.maxNs = Math.max(this.maxNs, other.maxNs);
+    return this;
+  }
+
+  /**
+   * Value at percentile `p` (0-100) in ms: middle of the bucket holding the
+   * ceil(p% * count)-th value, clamped to the recorded min/max
+   */
+  percentileMs(p: number): number | null {
+    if (this.totalCount === 0) return null;
+
+    const target = Math.max(1, Math.ceil((p / 100) * this.totalCount));
+    let seen = 0;
+
+    for (let index = 0; index < this.counts.length; index++) {
+      seen += this.counts[index]!;
+      if (seen >= target) {
+        // The last bucket holds the max: report it exactly
+        if (seen === this.totalCount) return this.maxNs / 1_000_000;
+        const [low, high] = bucketRange(index);
+        const mid = low + Math.floor((high - low) / 2);
+        return Math.min(this.maxNs, Math.max(this.minNs, mid)) / 1_000_000;
+      }
+    }
+
+    return this.maxNs / 1_000_000;
+  }
+
+  percentiles(ps: number[]): PercentileValue[] {
+    return ps.map((p) => ({ p, ms: this.percentileMs(p) }));
+  }
+
+  get minMs(): number | null {
+    return this.totalCount === 0 ? null : this.minNs / 1_000_000;
+  }
+
+  get maxMs(): number | null {
+    return this.totalCount === 0 ? null : this.maxNs / 1_000_000;
+  }
+
+  /**
+   * Non-empty buckets, optionally regrouped into at most `maxBuckets`
+   * log-spaced bins between min and max for charts
+   */
+  buckets(maxBuckets?: number): HistogramBucket[] {
+    const raw: HistogramBucket[] = [];
+    this.counts.forEach((count, index) => {
+      if (count === 0) return;
+      const [low, high] = bucketRange(index);
+      raw.push({ lowMs: low / 1_000_000, highMs: high / 1_000_000, count });
+    });
+
+    if (!maxBuckets || raw.length <= maxBuckets) return raw;
+
+    const lo = Math.log(Math.max(this.minNs, 1));
+    const hi = Math.log(Math.max(this.maxNs, 1)) + 1e-9;
+    const width = (hi - lo) / maxBuckets;
+    const bins: HistogramBucket[] = Array.from(
+      { length: maxBuckets },
+      (_, i) => ({
+        lowMs: Math.exp(lo + i * width) / 1_000_000,
+        highMs: Math.exp(lo + (i + 1) * width) / 1_000_000,
+        count: 0,
+      })
+    );
+
+    for (const bucket of raw) {
+      const ns = Math.max(bucket.lowMs * 1_000_000, 1);
+      const bin = Math.min(
+        maxBuckets - 1,
+        Math.max(0, Math.floor((Math.log(ns) - lo) / width))
+      );
+      bins[bin]!.count += bucket.count;
+    }
+
+    return bins;
+  }
+
+  encode(): Buffer {
+    const out: number[] = [HISTOGRAM_FORMAT_V1, SUB_BUCKET_BITS];
+    writeVarint(out, this.totalCount === 0 ? 0 : this.minNs);
+    writeVarint(out, this.maxNs);
+
+    const nonEmpty = this.counts.filter((count) => count > 0).length;
+    writeVarint(out, nonEmpty);
+
+    let prev = 0;
+    this.counts.forEach((count, index) => {
+      if (count === 0) return;
+      writeVarint(out, index - prev);
+      writeVarint(out, count);
+      prev = index;
+    });
+
+    return Buffer.from(out);
+  }
+
+  static decode(blob: Uint8Array): LatencyHistogram {
+    if (blob[0] !== HISTOGRAM_FORMAT_V1 || blob[1] !== SUB_BUCKET_BITS) {
+      throw new Error(`Unknown histogram format: ${blob[0]}/${blob[1]}`);
+    }
+
+    let offset = 2;
+    const readVarint = (): number => {
+      let value = 0;
+      let scale = 1;
+      for (;;) {
+        const byte = blob[offset++];
+        if (byte === undefined) throw new Error("Truncated histogram");
+        value += (byte & 0x7f) * scale;
+        if (byte < 0x80) return value;
+        scale *= 0x80;
+      }
+    };
+
+    const histogram = new LatencyHistogram();
+    const minNs = readVarint();
+    const maxNs = readVarint();
+    const nonEmpty = readVarint();
+
+    let index = 0;
+    for (let i = 0; i < nonEmpty; i++) {
+      index += readVarint();
+      const count = readVarint();
+      while (histogram.counts.length <= index) histogram.counts.push(0);
+      histogram.counts[index] = count;
+      histogram.totalCount += count;
+    }
+
+    if (histogram.totalCount > 0) {
+      histogram.minNs = minNs;
+      histogram.maxNs = maxNs;
+    }
+
+    return histogram;
+  }
+}
+
+/**
+ * Histogram of a session, built from its samples (and stored) when the
+ * session predates the histogram column
+ */
+export function getSessionHistogram(
+  db: Database.Database,
+  sessionId: number
+): LatencyHistogram {
+  const blob = db
+    .prepare("SELECT histogram_blob FROM benchmark_sessions WHERE id = ?")
+    .pluck()
+    .get(sessionId) as Buffer | null | undefined;
+
+  if (blob) return LatencyHistogram.decode(blob);
+
+  const histogram = LatencyHistogram.fromMs(getSessionSamples(db, sessionId));
+  if (blob === null && !db.readonly) {
+    db.prepare("UPDATE benchmark_sessions SET histogram_blob = ? WHERE id = ?").run(
+      histogram.encode(),
+      sessionId
+    );
+  }
+  return histogram;
+}
+
+/**
+ * Store a histogram for every session that has none yet
+ */
+export function backfillHistograms(
+  db: Database.Database,
+  batchSize = 200
+): number {
+  const select = db
+    .prepare(
+      `SELECT id FROM benchmark_sessions
+       WHERE histogram_blob IS NULL ORDER BY id LIMIT ?`
+    )
+    .pluck();
+
+  let sessions = 0;
+  const backfillBatch = db.transaction((ids: number[]) => {
+    for (const id of ids) getSessionHistogram(db, id);
+  });
+
+  for (;;) {
+    const ids = select.all(batchSize) as number[];
+    if (ids.length === 0) return sessions;
+    backfillBatch(ids);
+    sessions += ids.length;
+  }
+}
+
+/**
+ * Merge the histograms of several sessions
+ */
+export function mergeSessionHistograms(
+  db: Database.Database,
+  sessionIds: number[]
+): LatencyHistogram {
+  const merged = new LatencyHistogram();
+  for (const id of sessionIds) merged.merge(getSessionHistogram(db, id));
+  return merged;
+}
@@ -4,3 +4,12 @@
 
 export * from "./types.js";
 export * from "./database.js";
+export * from "./stats.js";
+export * from "./migrations.js";
+export * from "./benchmarks.js";
+export * from "./samples.js";
+export * from "./histogram.js";
+export * from "./leaderboard.js";
+export * from "./blobs.js";
+export * from "./builds.js";
+export * from "./kernels.js";
@@ -0,0 +1,139 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Kernel Shootouts
+ *
+ * Results of c/kernel.h microbenchmarks: a run per `aoc kernels`
+ * invocation (agent, bench file, day of the input, build mode) and a row
+ * per kernel with its per-call times. Written by the CLI and by
+ * POST /api/kernels, which takes the `aoc kernels --json` output.
+ */
+
+import type Database from "better-sqlite3";
+import { DEFAULT_BUILD_MODE } from "./builds.js";
+import type {
+  Agent,
+  BuildMode,
+  CreateKernelRunInput,
+  KernelResult,
+  KernelRun,
+} from "./types.js";
+
+export interface KernelRunFilter {
+  agent?: Agent;
+  day?: number;
+  file?: string;
+  limit?: number;
+}
+
+interface KernelRunRow {
+  id: number;
+  agent: string;
+  day: number | null;
+  file: string;
+  build_mode: string;
+  ok: number;
+  created_at: string;
+}
+
+interface KernelResultRow extends Omit<KernelResult, "ok"> {
+  id: number;
+  run_id: number;
+  ok: number;
+}
+
+/**
+ * Insert a run and its kernels in one transaction, returns the run id
+ */
+export function insertKernelRun(
+  db: Database.Database,
+  input: CreateKernelRunInput
+): number {
+  const insertResult = db.prepare(`
+    INSERT INTO kernel_results (
+      run_id, name, iterations, samples,
+      min_ns, median_ns, mean_ns, max_ns, std_dev_ns, ok, answer
+    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+  `);
+
+  const write = db.transaction(() => {
+    const runId = Number(
+      db
+        .prepare(
+          `INSERT INTO kernel_runs (agent, day, file, build_mode, ok)
+           VALUES (?, ?, ?, ?, ?)`
+        )
+        .run(
+          input.agent,
+          input.day ?? null,
+          input.file,
+          input.build_mode ?? DEFAULT_BUILD_MODE,
+          input.kernels.length > 0 && input.kernels.every((k) => k.ok) ? 1 : 0
+        ).lastInsertRowid
+    );
+
+    for (const kernel of input.kernels) {
+      insertResult.run(
+        runId,
+        kernel.name,
+        kernel.iterations,
+        kernel.samples,
+        kernel.minNs,
+        kernel.medianNs,
+        kernel.meanNs,
+        kernel.maxNs,
+        kernel.stdDevNs,
+        kernel.ok ? 1 : 0,
+        kernel.answer
+      );
+    }
+    return runId;
+  });
+
+  return write();
+}
+
+/**
+ * Latest runs first, each with its kernels in output order
+ */
+export function getKernelRuns(
+  db: Database.Database,
+  filter: KernelRunFilter = {}
+): KernelRun[] {
+  let sql = "SELECT * FROM kernel_runs WHERE 1=1";
+  const params: unknown[] = [];
+
+  if (filter.agent) {
+    sql += " AND agent = ?";
+    params.push(filter.agent);
+  }
+  if (filter.day !== undefined) {
+    sql += " AND day = ?";
+    params.push(filter.day);
+  }
+  if (filter.file) {
+    sql += " AND file = ?";
+    params.push(filter.file);
+  }
+  sql += " ORDER BY created_at DESC, id DESC LIMIT ?";
+  params.push(filter.limit ?? 20);
+
+  const runs = db.prepare(sql).all(...params) as KernelRunRow[];
+  if (runs.length === 0) return [];
+
+  const results = db
+    .prepare(
+      `SELECT * FROM kernel_results WHERE run_id IN (${runs
+        .map(() => "?")
+        .join(", ")}) ORDER BY id`
+    )
+    .all(...runs.map((r) => r.id)) as KernelResultRow[];
+
+  return runs.map((run) => ({
+    ...run,
+    agent: run.agent as Agent,
+    build_mode: run.build_mode as BuildMode,
+    ok: run.ok === 1,
+    kernels: results
+      .filter((r) => r.run_id === run.id)
+      .map(({ run_id, id, ...kernel }) => ({ ...kernel, ok: kernel.ok === 1 })),
+  }));
+}
@@ -0,0 +1,212 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Leaderboard
+ *
+ * Podium points (3 / 2 / 1 per day × part × language, on the best median
+ * of each agent's correct sessions) kept in two small tables updated by the
+ * benchmark write path, so reads never scan benchmark_sessions:
+ *   - puzzle_best : best session per agent and puzzle, with its points
+ *   - leaderboard : totals per agent
+ * Only sessions of the default C build mode score: static and nostart
+ * builds skip the loader, which would not be a fair comparison.
+ */
+
+import type Database from "better-sqlite3";
+import type {
+  Agent,
+  BenchmarkKey,
+  LeaderboardEntry,
+  PuzzleBest,
+} from "./types.js";
+import { DEFAULT_BUILD_MODE } from "./builds.js";
+
+export const PODIUM_POINTS = [3, 2, 1];
+
+// Day 0 is the test day and does not score
+export const FIRST_SCORED_DAY = 1;
+
+export interface PuzzleResult extends BenchmarkKey {
+  sessionId: number;
+  isCorrect: boolean | null;
+  p50TimeMs: number | null;
+}
+
+const podiumPoints = (rank: number) => PODIUM_POINTS[rank] ?? 0;
+
+// Sessions that can score (TS sessions have no build mode)
+const SCORED_SESSIONS =
+  `(build_mode IS NULL OR build_mode = '${DEFAULT_BUILD_MODE}')`;
+
+/**
+ * Re-rank one puzzle: agents sharing a time share the podium step
+ */
+function rankPuzzle(
+  db: Database.Database,
+  day: number,
+  part: number,
+  language: string
+): Set<string> {
+  const bests = db
+    .prepare(
+      `SELECT agent, best_time_ms, points FROM puzzle_best
+       WHERE day = ? AND part = ? AND language = ?
+       ORDER BY best_time_ms`
+    )
+    .all(day, part, language) as {
+    agent: string;
+    best_time_ms: number;
+    points: number;
+  }[];
+
+  const update = db.prepare(
+    `UPDATE puzzle_best SET points = ?
+     WHERE day = ? AND part = ? AND language = ? AND agent = ?`
+  );
+
+  const changed = new Set<string>();
+  for (const best of bests) {
+    const rank = bests.findIndex((b) => b.best_time_ms === best.best_time_ms);
+    const points = podiumPoints(rank);
+    if (points !== best.points) {
+      update.run(points, day, part, language, best.agent);
+      changed.add(best.agent);
+    }
+  }
+
+  return changed;
+}
+
+/**
+ * Recompute the totals of some agents from their puzzle_best rows
+ */
+function refreshAgents(db: Database.Database, agents: Iterable<string>): void {
+  const upsert = db.prepare(`
+    INSERT INTO leaderboard (agent, points, gold, silver, bronze, puzzles, total_best_ms)
+    SELECT ?, COALESCE(SUM(points), 0),
+      COALESCE(SUM(points = ${PODIUM_POINTS[0]}), 0),
+      COALESCE(SUM(points = ${PODIUM_POINTS[1]}), 0),
+      COALESCE(SUM(points = ${PODIUM_POINTS[2]}), 0),
+      COUNT(*), COALESCE(SUM(best_time_ms), 0)
+    FROM puzzle_best WHERE agent = ?
+    ON CONFLICT (agent) DO UPDATE SET
+      points = excluded.points,
+      gold = excluded.gold,
+      silver = excluded.silver,
+      bronze = excluded.bronze,
+      puzzles = excluded.puzzles,
+      total_best_ms = excluded.total_best_ms
+  `);
+
+  for (const agent of agents) upsert.run(agent, agent);
+}
+
+/**
+ * Account for a new session. Only a new best for its agent touches the
+ * puzzle ranking and the totals. Call inside the session transaction.
+ */
+export function recordPuzzleResult(
+  db: Database.Database,
+  result: PuzzleResult
+): boolean {
+  if (
+    result.isCorrect !== true ||
+    result.p50TimeMs === null ||
+    result.day < FIRST_SCORED_DAY ||
+    (result.build_mode ?? DEFAULT_BUILD_MODE) !== DEFAULT_BUILD_MODE
+  ) {
+    return false;
+  }
+
+  const improved = db
+    .prepare(
+      `INSERT INTO puzzle_best (agent, day, part, language, session_id, best_time_ms)
+       VALUES (?, ?, ?, ?, ?, ?)
+       ON CONFLICT (day, part, language, agent) DO UPDATE SET
+         session_id = excluded.session_id,
+         best_time_ms = excluded.best_time_ms
+       WHERE excluded.best_time_ms < puzzle_best.best_time_ms`
+    )
+    .run(
+      result.agent,
+      result.day,
+      result.part,
+      result.language,
+      result.sessionId,
+      result.p50TimeMs
+    ).changes > 0;
+
+  if (!improved) return false;
+
+  const changed = rankPuzzle(db, result.day, result.part, result.language);
+  // The agent's total time moved even when its points did not
+  changed.add(result.agent);
+  refreshAgents(db, changed);
+  return true;
+}
+
+/**
+ * Rebuild both tables from benchmark_sessions (existing databases, or
+ * after sessions were deleted by hand)
+ */
+export function rebuildLeaderboard(db: Database.Database): void {
+  db.transaction(() => {
+    db.exec("DELETE FROM puzzle_best; DELETE FROM leaderboard;");
+
+    db.prepare(
+      `INSERT INTO puzzle_best (agent, day, part, language, session_id, best_time_ms)
+       SELECT agent, day, part, language, id, p50_time_ms FROM (
+         SELECT *, ROW_NUMBER() OVER (
+           PARTITION BY agent, day, part, language
+           ORDER BY p50_time_ms, id
+         ) AS position
+         FROM benchmark_sessions
+         WHERE is_correct = 1 AND p50_time_ms IS NOT NULL AND day >= ?
+           AND ${SCORED_SESSIONS}
+       ) WHERE position = 1`
+    ).run(FIRST_SCORED_DAY);
+
+    const puzzles = db
+      .prepare("SELECT DISTINCT day, part, language FROM puzzle_best")
+      .all() as { day: number; part: number; language: string }[];
+    for (const p of puzzles) rankPuzzle(db, p.day, p.part, p.language);
+
+    const agents = db
+      .prepare("SELECT DISTINCT agent FROM puzzle_best")
+      .pluck()
+      .all() as string[];
+    refreshAgents(db, agents);
+  })();
+}
+
+/**
+ * Build the tables once for databases that predate them
+ */
+export function ensureLeaderboard(db: Database.Database): void {
+  const hasBests = db.prepare("SELECT 1 FROM puzzle_best LIMIT 1").get();
+  if (hasBests) return;
+
+  const hasSessions = db
+    .prepare(
+      `SELECT 1 FROM benchmark_sessions
+       WHERE is_correct = 1 AND day >= ? AND ${SCORED_SESSIONS} LIMIT 1`
+    )
+    .get(FIRST_SCORED_DAY);
+  if (hasSessions) rebuildLeaderboard(db);
+}
+
+export function getLeaderboard(db: Database.Database): LeaderboardEntry[] {
+  return db
+    .prepare(
+      "SELECT * FROM leaderboard ORDER BY points DESC, gold DESC, total_best_ms"
+    )
+    .all() as LeaderboardEntry[];
+}
+
+export function getPuzzleBests(
+  db: Database.Database,
+  agent?: Agent
+): PuzzleBest[] {
+  const sql = `SELECT * FROM puzzle_best${agent ? " WHERE agent = ?" : ""}
+    ORDER BY day, part, language, points DESC`;
+  const stmt = db.prepare(sql);
+  return (agent ? stmt.all(agent) : stmt.all()) as PuzzleBest[];
+}
@@ -0,0 +1,75 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Schema Migrations
+ *
+ * schema.sql only uses CREATE ... IF NOT EXISTS, so columns added to an
+ * existing table after a database was created are applied here.
+ */
+
+import type Database from "better-sqlite3";
+
+interface ColumnMigration {
+  table: string;
+  column: string;
+  definition: string;
+  // Run once, right after the column is added to an existing table
+  backfill?: string;
+}
+
+const BUILD_MODE_DEFINITION =
+  "TEXT CHECK (build_mode IN ('dynamic', 'static', 'nostart'))";
+
+export const COLUMN_MIGRATIONS: ColumnMigration[] = [
+  // Content moved to blobs (see migrateDayContentToBlobs)
+  { table: "days", column: "puzzle1_md_hash", definition: "TEXT" },
+  { table: "days", column: "puzzle2_md_hash", definition: "TEXT" },
+  { table: "days", column: "sample_input_hash", definition: "TEXT" },
+  { table: "days", column: "final_input_hash", definition: "TEXT" },
+  {
+    table: "benchmark_sessions",
+    column: "perf_verdict",
+    definition:
+      "TEXT CHECK (perf_verdict IN ('regression', 'improvement', 'unchanged', 'insufficient'))",
+  },
+  { table: "benchmark_sessions", column: "perf_p_value", definition: "REAL" },
+  { table: "benchmark_sessions", column: "perf_delta_pct", definition: "REAL" },
+  {
+    table: "benchmark_sessions",
+    column: "perf_baseline_runs",
+    definition: "INTEGER",
+  },
+  { table: "benchmark_sessions", column: "samples_blob", definition: "BLOB" },
+  { table: "benchmark_sessions", column: "histogram_blob", definition: "BLOB" },
+  { table: "runs", column: "stats", definition: "TEXT" },
+  // C rows from before build modes were all dynamic builds
+  {
+    table: "runs",
+    column: "build_mode",
+    definition: BUILD_MODE_DEFINITION,
+    backfill: "UPDATE runs SET build_mode = 'dynamic' WHERE language = 'c'",
+  },
+  {
+    table: "benchmark_sessions",
+    column: "build_mode",
+    definition: BUILD_MODE_DEFINITION,
+    backfill:
+      "UPDATE benchmark_sessions SET build_mode = 'dynamic' WHERE language = 'c'",
+  },
+];
+
+export function applyMigrations(db: Database.Database): void {
+  for (const migration of COLUMN_MIGRATIONS) {
+    const columns = db
+      .prepare(`PRAGMA table_info(${migration.table})`)
+      .all() as { name: string }[];
+
+    // Table not created yet (nothing to migrate)
+    if (columns.length === 0) continue;
+
+    if (!columns.some((c) => c.name === migration.column)) {
+      db.exec(
+        `ALTER TABLE ${migration.table} ADD COLUMN ${migration.column} ${migration.definition}`
+      );
+      if (migration.backfill) db.exec(migration.backfill);
+    }
+  }
+}
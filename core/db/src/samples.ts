@@ -0,0 +1,146 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Benchmark Samples
+ *
+ * Compact storage for the samples of a session: one BLOB instead of one
+ * benchmark_runs row per iteration.
+ *
+ * Format (v1):
+ *   u8      version (1)
+ *   varint  count
+ *   varint  zigzag(ns[i] - ns[i - 1]) for each sample, ns[-1] = 0
+ *
+ * Consecutive timings are close, so most deltas fit in 1-3 bytes.
+ */
+
+import type Database from "better-sqlite3";
+
+export type SampleStorage = "rows" | "blob";
+
+const SAMPLES_FORMAT_V1 = 1;
+
+// Plain arithmetic rather than bitwise ops: ns values exceed 32 bits
+function writeVarint(out: number[], value: number): void {
+  while (value >= 0x80) {
+    out.push((value % 0x80) | 0x80);
+    value = Math.floor(value / 0x80);
+  }
+  out.push(value);
+}
+
+export function encodeSamples(timesMs: number[]): Buffer {
+  const out: number[] = [SAMPLES_FORMAT_V1];
+  writeVarint(out, timesMs.length);
+
+  let prev = 0;
+  for (const ms of timesMs) {
+    const ns = Math.max(0, Math.round(ms * 1_000_000));
+    const delta = ns - prev;
+    writeVarint(out, delta >= 0 ? delta * 2 : -delta * 2 - 1);
+    prev = ns;
+  }
+
+  return Buffer.from(out);
+}
+
+export function decodeSamples(blob: Uint8Array): number[] {
+  if (blob[0] !== SAMPLES_FORMAT_V1) {
+    throw new Error(`Unknown samples format: ${blob[0]}`);
+  }
+
+  let offset = 1;
+  const readVarint = (): number => {
+    let value = 0;
+    let scale = 1;
+    for (;;) {
+      const byte = blob[offset++];
+      if (byte === undefined) throw new Error("Truncated samples blob");
+      value += (byte & 0x7f) * scale;
+      if (byte < 0x80) return value;
+      scale *= 0x80;
+    }
+  };
+
+  const count = readVarint();
+  const times: number[] = new Array(count);
+
+  let ns = 0;
+  for (let i = 0; i < count; i++) {
+    const zigzag = readVarint();
+    ns += zigzag % 2 === 0 ? zigzag / 2 : -(zigzag + 1) / 2;
+    times[i] = ns / 1_000_000;
+  }
+
+  return times;
+}
+
+/**
+ * Samples of a session, whichever way they were stored
+ */
+export function getSessionSamples(
+  db: Database.Database,
+  sessionId: number
+): number[] {
+  const blob = db
+    .prepare("SELECT samples_blob FROM benchmark_sessions WHERE id = ?")
+    .pluck()
+    .get(sessionId) as Buffer | null | undefined;
+
+  if (blob) return decodeSamples(blob);
+
+  return db
+    .prepare(
+      "SELECT time_ms FROM benchmark_runs WHERE session_id = ? ORDER BY run_index"
+    )
+    .pluck()
+    .all(sessionId) as number[];
+}
+
+export interface SampleMigrationResult {
+  sessions: number;
+  runs: number;
+}
+
+/**
+ * Move the benchmark_runs rows of existing sessions into samples_blob,
+ * `batchSize` sessions per transaction
+ */
+export function migrateRunsToBlobs(
+  db: Database.Database,
+  batchSize = 200
+): SampleMigrationResult {
+  const selectSessions = db.prepare(`
+    SELECT id FROM benchmark_sessions
+    WHERE samples_blob IS NULL
+      AND EXISTS (SELECT 1 FROM benchmark_runs WHERE session_id = benchmark_sessions.id)
+    LIMIT ?
+  `);
+  const selectRuns = db.prepare(
+    "SELECT time_ms FROM benchmark_runs WHERE session_id = ? ORDER BY run_index"
+  );
+  const setBlob = db.prepare(
+    "UPDATE benchmark_sessions SET samples_blob = ? WHERE id = ?"
+  );
+  const deleteRuns = db.prepare(
+    "DELETE FROM benchmark_runs WHERE session_id = ?"
+  );
+
+  const result: SampleMigrationResult = { sessions: 0, runs: 0 };
+
+  const migrateBatch = db.transaction((): number => {
+    const ids = selectSessions.pluck().all(batchSize) as number[];
+    for (const id of ids) {
+      const times = selectRuns.pluck().all(id) as number[];
+      setBlob.run(encodeSamples(times), id);
+      deleteRuns.run(id);
+      result.sessions++;
+      result.runs += times.length;
+    }
+    return ids.length;
+  });
+
+  while (migrateBatch() === batchSize) {
+    // Next batch
+  }
+
+  return result;
+}
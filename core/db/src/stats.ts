@@ -0,0 +1,173 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Benchmark Statistics
+ *
+ * Descriptive stats for a benchmark session, plus a Mann-Whitney U test used
+ * to compare a new session against the samples of the previous sessions.
+ */
+
+import type {
+  BenchmarkStats,
+  PerfVerdict,
+  RegressionOptions,
+  RegressionResult,
+} from "./types.js";
+
+export const DEFAULT_REGRESSION_OPTIONS: Required<RegressionOptions> = {
+  alpha: 0.01,
+  minEffectPct: 5,
+  minSamples: 5,
+};
+
+export function computeStats(times: number[]): BenchmarkStats {
+  const sorted = [...times].sort((a, b) => a - b);
+  const n = sorted.length;
+
+  const avg = times.reduce((a, b) => a + b, 0) / n;
+  const min = sorted[0]!;
+  const max = sorted[n - 1]!;
+
+  const variance = times.reduce((sum, t) => sum + Math.pow(t - avg, 2), 0) / n;
+  const stdDev = Math.sqrt(variance);
+
+  const percentile = (p: number) => {
+    const idx = Math.ceil((p / 100) * n) - 1;
+    return sorted[Math.max(0, Math.min(n - 1, idx))]!;
+  };
+
+  return {
+    avg,
+    min,
+    max,
+    stdDev,
+    p50: percentile(50),
+    p95: percentile(95),
+    p99: percentile(99),
+  };
+}
+
+export function median(values: number[]): number {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 === 1
+    ? sorted[mid]!
+    : (sorted[mid - 1]! + sorted[mid]!) / 2;
+}
+
+/**
+ * Complementary error function (Numerical Recipes erfcc, |error| < 1.2e-7)
+ */
+function erfc(x: number): number {
+  const z = Math.abs(x);
+  const t = 1 / (1 + 0.5 * z);
+  const r =
+    t *
+    Math.exp(
+      -z * z -
+        1.26551223 +
+        t *
+          (1.00002368 +
+            t *
+              (0.37409196 +
+                t *
+                  (0.09678418 +
+                    t *
+                      (-0.18628806 +
+                        t *
+                          (0.27886807 +
+                            t *
+                              (-1.13520398 +
+                                t *
+                                  (1.48851587 +
+                                    t * (-0.82215223 + t * 0.17087277))))))))
+    );
+  return x >= 0 ? r : 2 - r;
+}
+
+/**
+ * Two-sided Mann-Whitney U test (normal approximation, tie and continuity
+ * corrected). `u` is the statistic for sample `a`.
+ */
+export function mannWhitneyU(
+  a: number[],
+  b: number[]
+): { u: number; z: number; pValue: number } {
+  const n1 = a.length;
+  const n2 = b.length;
+  const n = n1 + n2;
+
+  const all = [
+    ...a.map((value) => ({ value, fromA: true })),
+    ...b.map((value) => ({ value, fromA: false })),
+  ].sort((x, y) => x.value - y.value);
+
+  // Average ranks over ties, accumulating the tie correction term
+  let rankSumA = 0;
+  let tieTerm = 0;
+  for (let i = 0; i < n; ) {
+    let j = i;
+    while (j + 1 < n && all[j + 1]!.value === all[i]!.value) j++;
+    const ties = j - i + 1;
+    const rank = (i + j) / 2 + 1;
+    for (let k = i; k <= j; k++) {
+      if (all[k]!.fromA) rankSumA += rank;
+    }
+    tieTerm += ties * ties * ties - ties;
+    i = j + 1;
+  }
+
+  const u = rankSumA - (n1 * (n1 + 1)) / 2;
+  const mean = (n1 * n2) / 2;
+  const variance = ((n1 * n2) / 12) * (n + 1 - tieTerm / (n * (n - 1)));
+
+  if (variance <= 0) {
+    return { u, z: 0, pValue: 1 };
+  }
+
+  const diff = u - mean;
+  const corrected = Math.max(0, Math.abs(diff) - 0.5);
+  const z = (Math.sign(diff) * corrected) / Math.sqrt(variance);
+  const pValue = Math.min(1, erfc(Math.abs(z) / Math.SQRT2));
+
+  return { u, z, pValue };
+}
+
+/**
+ * Compare the samples of a new session against the pooled samples of the
+ * previous sessions. A shift is only flagged when it is both statistically
+ * significant and larger than `minEffectPct` of the baseline median.
+ */
+export function compareToBaseline(
+  baseline: number[],
+  current: number[],
+  options: RegressionOptions = {}
+): RegressionResult {
+  const { alpha, minEffectPct, minSamples } = {
+    ...DEFAULT_REGRESSION_OPTIONS,
+    ...options,
+  };
+
+  if (baseline.length < minSamples || current.length < minSamples) {
+    return {
+      verdict: "insufficient",
+      pValue: null,
+      deltaPct: null,
+      baselineRuns: baseline.length,
+    };
+  }
+
+  const baselineMedian = median(baseline);
+  const currentMedian = median(current);
+  const deltaPct =
+    baselineMedian > 0
+      ? ((currentMedian - baselineMedian) / baselineMedian) * 100
+      : 0;
+
+  const { pValue } = mannWhitneyU(current, baseline);
+
+  let verdict: PerfVerdict = "unchanged";
+  if (pValue < alpha && Math.abs(deltaPct) >= minEffectPct) {
+    verdict = deltaPct > 0 ? "regression" : "improvement";
+  }
+
+  return { verdict, pValue, deltaPct, baselineRuns: baseline.length };
+}
@@ -5,15 +5,23 @@
 export type Agent = "claude" | "codex" | "gemini";
 export type Language = "ts" | "c";
 export type Part = 1 | 2;
+// C build mode (see builds.ts), null for TS
+export type BuildMode = "dynamic" | "static" | "nostart";
+export type PerfVerdict =
+  | "regression"
+  | "improvement"
+  | "unchanged"
+  | "insufficient";
 
+// Statements and inputs are referenced by hash (see blobs.ts)
 export interface Day {
   id: number;
-  puzzle1_md: string | null;
-  puzzle2_md: string | null;
-  sample_input: string | null;
+  puzzle1_md_hash: string | null;
+  puzzle2_md_hash: string | null;
+  sample_input_hash: string | null;
   sample_expected_p1: string | null;
   sample_expected_p2: string | null;
-  final_input: string | null;
+  final_input_hash: string | null;
   answer_p1: string | null;
   answer_p2: string | null;
   published_at: string | null;
@@ -21,6 +29,13 @@ export interface Day {
   updated_at: string;
 }
 
+export interface DayWithContent extends Day {
+  puzzle1_md: string | null;
+  puzzle2_md: string | null;
+  sample_input: string | null;
+  final_input: string | null;
+}
+
 export interface Run {
   id: number;
   agent: Agent;
@@ -32,9 +47,24 @@ export interface Run {
   is_correct: boolean | null;
   is_sample: boolean;
   error: string | null;
+  // Work counters of an AOC_STATS build, by name
+  stats: Record<string, RunStat> | null;
+  build_mode: BuildMode | null;
   created_at: string;
 }
 
+/**
+ * One STAT: line (AOC_COUNT / AOC_HIST in common.h)
+ */
+export interface RunStat {
+  count: number;
+  sum?: number;
+  min?: number;
+  max?: number;
+  // Power-of-two bucket lower bound -> values in [bound, 2 * bound)
+  hist?: Record<string, number>;
+}
+
 export interface BenchmarkSession {
   id: number;
   agent: Agent;
@@ -51,6 +81,11 @@ export interface BenchmarkSession {
   p50_time_ms: number | null;
   p95_time_ms: number | null;
   p99_time_ms: number | null;
+  perf_verdict: PerfVerdict | null;
+  perf_p_value: number | null;
+  perf_delta_pct: number | null;
+  perf_baseline_runs: number | null;
+  build_mode: BuildMode | null;
   created_at: string;
 }
 
@@ -72,6 +107,9 @@ export interface CreateRunInput {
   is_correct?: boolean;
   is_sample?: boolean;
   error?: string;
+  stats?: Record<string, RunStat>;
+  // C only, defaults to DEFAULT_BUILD_MODE
+  build_mode?: BuildMode;
 }
 
 export interface UpdateDayInput {
@@ -95,6 +133,8 @@ export interface CreateBenchmarkInput {
   answer?: string;
   is_correct?: boolean;
   times: number[];  // Array of time_ms for each run
+  // C only, defaults to DEFAULT_BUILD_MODE
+  build_mode?: BuildMode;
 }
 
 export interface BenchmarkStats {
@@ -106,3 +146,102 @@ export interface BenchmarkStats {
   p95: number;
   p99: number;
 }
+
+export interface BenchmarkKey {
+  agent: Agent;
+  day: number;
+  part: Part;
+  language: Language;
+  // C only, defaults to DEFAULT_BUILD_MODE
+  build_mode?: BuildMode;
+}
+
+export interface RegressionOptions {
+  alpha?: number; // Significance level of the Mann-Whitney test
+  minEffectPct?: number; // Smallest median shift (%) worth flagging
+  minSamples?: number; // Below this on either side: "insufficient"
+}
+
+export interface RegressionResult {
+  verdict: PerfVerdict;
+  pValue: number | null;
+  deltaPct: number | null; // Median shift vs baseline, positive = slower
+  baselineRuns: number;
+}
+
+export interface CreatedBenchmark {
+  id: number;
+  stats: BenchmarkStats;
+  regression: RegressionResult;
+}
+
+export interface PuzzleBest {
+  agent: Agent;
+  day: number;
+  part: Part;
+  language: Language;
+  session_id: number;
+  best_time_ms: number; // Lowest p50 among correct sessions
+  points: number; // Podium points: 3 / 2 / 1
+}
+
+export interface LeaderboardEntry {
+  agent: Agent;
+  points: number;
+  gold: number;
+  silver: number;
+  bronze: number;
+  puzzles: number; // Puzzles with at least one correct session
+  total_best_ms: number;
+}
+
+/**
+ * One kernel of a c/kernel.h microbenchmark as printed by
+ * `aoc kernels --json` (the runner's KernelStats), times per call
+ */
+export interface KernelStatsInput {
+  name: string;
+  iterations: number;
+  samples: number;
+  minNs: number;
+  medianNs: number;
+  meanNs: number;
+  maxNs: number;
+  stdDevNs: number;
+  ok: boolean;
+  answer: string;
+}
+
+export interface CreateKernelRunInput {
+  agent: Agent;
+  // Benchmark source, relative to the agent directory
+  file: string;
+  // Day whose input was fed to the bench, null when it embeds its data
+  day?: number | null;
+  build_mode?: BuildMode;
+  kernels: KernelStatsInput[];
+}
+
+export interface KernelResult {
+  name: string;
+  iterations: number;
+  samples: number;
+  min_ns: number;
+  median_ns: number;
+  mean_ns: number;
+  max_ns: number;
+  std_dev_ns: number;
+  ok: boolean; // Same answer as the first (reference) kernel
+  answer: string | null;
+}
+
+export interface KernelRun {
+  id: number;
+  agent: Agent;
+  day: number | null;
+  file: string;
+  build_mode: BuildMode;
+  ok: boolean; // Every kernel agreed with the reference
+  created_at: string;
+  kernels: KernelResult[];
+}
@@ -36,6 +36,13 @@
 #include <windows.h>
 #else
 #include <sys/time.h>
+#include <pthread.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 // ═══════════════════════════════════════════════════════════════
@@ -90,6 +97,8 @@ static inline double aoc_timer_end(AocTimer* timer) {
 // ═══════════════════════════════════════════════════════════════
 
 #define AOC_MAX_INPUT (1024 * 1024 * 10)  // 10MB max input
+// Readable bytes past the end of input buffers (see aoc_parse_u64)
+#define AOC_PARSE_PAD 8
 
 static inline char* aoc_read_input(void) {
     char* buffer = (char*)malloc(AOC_MAX_INPUT);
@@ -101,9 +110,9 @@ static inline char* aoc_read_input(void) {
     size_t total = 0;
     size_t read;
 
-    while ((read = fread(buffer + total, 1, AOC_MAX_INPUT - total - 1, stdin)) > 0) {
+    while ((read = fread(buffer + total, 1, AOC_MAX_INPUT - total - AOC_PARSE_PAD, stdin)) > 0) {
         total += read;
-        if (total >= AOC_MAX_INPUT - 1) break;
+        if (total >= AOC_MAX_INPUT - AOC_PARSE_PAD) break;
     }
 
     buffer[total] = '\0';
@@ -114,6 +123,524 @@ static inline void aoc_cleanup(char* input) {
     if (input) free(input);
 }
 
+// Whole input, no size cap: NUL-terminated and followed by AOC_PARSE_PAD
+// readable bytes. When stdin is a regular file (`./part1 < input.txt`) it
+// is mapped instead of copied, so threads can start parsing their own
+// ranges right away. Pipes are read into a growing buffer.
+// Release with aoc_unmap_input.
+static size_t _aoc_mapped_size = 0;
+
+static inline const char* aoc_map_input(size_t* out_len) {
+    #ifdef __linux__
+    struct stat st;
+    int fd = fileno(stdin);
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+        lseek(fd, 0, SEEK_CUR) == 0) {
+        size_t len = (size_t)st.st_size;
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t size = (len + AOC_PARSE_PAD + page) & ~(page - 1);
+
+        // Zero pages first, then the file over their start: the bytes
+        // after the end of the file read as 0 instead of faulting
+        char* base = (char*)mmap(NULL, size, PROT_READ,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED) {
+            if (mmap(base, len, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) !=
+                MAP_FAILED) {
+                _aoc_mapped_size = size;
+                *out_len = len;
+                return base;
+            }
+            munmap(base, size);
+        }
+    }
+    #endif
+
+    size_t cap = 1024 * 1024;
+    size_t total = 0;
+    char* buffer = NULL;
+    for (;;) {
+        buffer = (char*)realloc(buffer, cap + AOC_PARSE_PAD);
+        if (!buffer) {
+            fprintf(stderr, "ERROR:Failed to allocate input buffer\n");
+            exit(1);
+        }
+        size_t read = fread(buffer + total, 1, cap - total, stdin);
+        total += read;
+        if (read == 0) break;
+        if (total == cap) cap *= 2;
+    }
+    memset(buffer + total, 0, AOC_PARSE_PAD);
+    *out_len = total;
+    return buffer;
+}
+
+static inline void aoc_unmap_input(const char* input) {
+    #ifdef __linux__
+    if (_aoc_mapped_size) {
+        munmap((void*)input, _aoc_mapped_size);
+        _aoc_mapped_size = 0;
+        return;
+    }
+    #endif
+    free((void*)input);
+}
+
+// ═══════════════════════════════════════════════════════════════
+// Streaming input (line-aligned chunks, O(chunk) memory)
+// ═══════════════════════════════════════════════════════════════
+//
+//   AocStream* stream = aoc_stream_open(AOC_STREAM_CHUNK, 1);
+//   size_t len;
+//   const char* chunk;
+//   while ((chunk = aoc_stream_next(stream, &len))) {
+//       // chunk[0..len) holds complete lines only (NUL-terminated),
+//       // a partial last line is carried over to the next chunk
+//   }
+//   aoc_stream_close(stream);
+//
+// With `threaded`, a reader thread fills the next chunk while the current
+// one is processed (double buffering). Needs glibc >= 2.34 or -pthread;
+// ignored on Windows. A line longer than the chunk size grows the buffer.
+// Chunks are followed by AOC_PARSE_PAD readable bytes.
+
+#define AOC_STREAM_CHUNK (1024 * 1024)
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    int full;  // threaded: filled, owned by the consumer until released
+} AocChunk;
+
+typedef struct {
+    size_t chunk_size;
+    AocChunk chunks[2];
+    // Partial line left over by the last fill
+    char* carry;
+    size_t carry_len;
+    size_t carry_cap;
+    int eof;
+    int threaded;
+    int current;  // chunk handed to the consumer, -1 before the first
+    int ended;    // the consumer got the end of input
+    #ifndef _WIN32
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int done;     // the reader thread has exited
+    #endif
+} AocStream;
+
+static inline void aoc_stream_reserve(char** buf, size_t* cap, size_t need) {
+    if (*cap >= need) return;
+    size_t next = *cap ? *cap : 4096;
+    while (next < need) next *= 2;
+    *buf = (char*)realloc(*buf, next);
+    if (!*buf) {
+        fprintf(stderr, "ERROR:Failed to allocate stream buffer\n");
+        exit(1);
+    }
+    *cap = next;
+}
+
+// Fill a chunk with the carry plus at least chunk_size new bytes, cut
+// after the last newline. Returns the chunk length, 0 at end of input.
+static inline size_t aoc_stream_fill(AocStream* s, AocChunk* chunk) {
+    aoc_stream_reserve(&chunk->data, &chunk->cap,
+                       s->carry_len + s->chunk_size + AOC_PARSE_PAD);
+    if (s->carry_len) memcpy(chunk->data, s->carry, s->carry_len);
+    size_t len = s->carry_len;
+    size_t scanned = 0;
+    s->carry_len = 0;
+
+    for (;;) {
+        size_t target = len + s->chunk_size;
+        aoc_stream_reserve(&chunk->data, &chunk->cap, target + AOC_PARSE_PAD);
+        while (!s->eof && len < target) {
+            size_t n = fread(chunk->data + len, 1, target - len, stdin);
+            if (n == 0) s->eof = 1;
+            len += n;
+        }
+
+        // Last newline of the new data
+        size_t cut = len;
+        while (cut > scanned && chunk->data[cut - 1] != '\n') cut--;
+
+        if (cut > scanned || s->eof) {
+            if (cut == scanned) cut = len;  // last line without newline
+            s->carry_len = len - cut;
+            aoc_stream_reserve(&s->carry, &s->carry_cap, s->carry_len + 1);
+            memcpy(s->carry, chunk->data + cut, s->carry_len);
+            chunk->len = cut;
+            chunk->data[cut] = '\0';
+            return cut;
+        }
+
+        // No newline yet: the line is longer than a chunk, keep reading
+        scanned = len;
+    }
+}
+
+#ifndef _WIN32
+static void* aoc_stream_reader(void* arg) {
+    AocStream* s = (AocStream*)arg;
+
+    for (int i = 0;; i ^= 1) {
+        AocChunk* chunk = &s->chunks[i];
+
+        pthread_mutex_lock(&s->lock);
+        while (chunk->full) pthread_cond_wait(&s->cond, &s->lock);
+        pthread_mutex_unlock(&s->lock);
+
+        size_t len = aoc_stream_fill(s, chunk);
+
+        pthread_mutex_lock(&s->lock);
+        chunk->full = 1;
+        if (len == 0) s->done = 1;
+        pthread_cond_broadcast(&s->cond);
+        pthread_mutex_unlock(&s->lock);
+
+        if (len == 0) return NULL;
+    }
+}
+#endif
+
+static inline AocStream* aoc_stream_open(size_t chunk_size, int threaded) {
+    AocStream* s = (AocStream*)calloc(1, sizeof(AocStream));
+    if (!s) {
+        fprintf(stderr, "ERROR:Failed to allocate stream\n");
+        exit(1);
+    }
+    s->chunk_size = chunk_size ? chunk_size : AOC_STREAM_CHUNK;
+    s->current = -1;
+
+    #ifndef _WIN32
+    if (threaded) {
+        pthread_mutex_init(&s->lock, NULL);
+        pthread_cond_init(&s->cond, NULL);
+        s->threaded =
+            pthread_create(&s->thread, NULL, aoc_stream_reader, s) == 0;
+    }
+    #else
+    (void)threaded;
+    #endif
+
+    return s;
+}
+
+// Next chunk of complete lines, NULL at end of input
+static inline const char* aoc_stream_next(AocStream* s, size_t* out_len) {
+    if (s->ended) return NULL;
+
+    AocChunk* chunk;
+    #ifndef _WIN32
+    if (s->threaded) {
+        pthread_mutex_lock(&s->lock);
+        if (s->current >= 0) {
+            // Hand the previous chunk back to the reader
+            s->chunks[s->current].full = 0;
+            pthread_cond_broadcast(&s->cond);
+        }
+        s->current = s->current < 0 ? 0 : s->current ^ 1;
+        chunk = &s->chunks[s->current];
+        while (!chunk->full) pthread_cond_wait(&s->cond, &s->lock);
+        pthread_mutex_unlock(&s->lock);
+    } else
+    #endif
+    {
+        chunk = &s->chunks[0];
+        aoc_stream_fill(s, chunk);
+    }
+
+    if (chunk->len == 0) {
+        s->ended = 1;
+        return NULL;
+    }
+    if (out_len) *out_len = chunk->len;
+    return chunk->data;
+}
+
+static inline void aoc_stream_close(AocStream* s) {
+    if (!s) return;
+    #ifndef _WIN32
+    if (s->threaded) {
+        if (!s->ended) {
+            // Stopped before the end: the reader may still be blocked on
+            // stdin, leave it (and its buffers) to process exit
+            pthread_detach(s->thread);
+            return;
+        }
+        pthread_join(s->thread, NULL);
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->cond);
+    }
+    #endif
+    free(s->chunks[0].data);
+    free(s->chunks[1].data);
+    free(s->carry);
+    free(s);
+}
+
+// ═══════════════════════════════════════════════════════════════
+// Large tables (huge pages)
+// ═══════════════════════════════════════════════════════════════
+//
+//   static Pair* pairs;
+//   AocPages kind;
+//   pairs = (Pair*)aoc_alloc_large(MAX_PAIRS * sizeof(Pair), &kind);
+//   AOC_REPORT_PAGES(pairs, kind);  // PERF:pages.pairs:2
+//   ...
+//   aoc_free_large(pairs, MAX_PAIRS * sizeof(Pair));
+//
+// Zeroed memory, like a static table, backed by 2 MB pages when possible:
+// reserved huge pages (MAP_HUGETLB), then transparent huge pages
+// (madvise), then normal pages. Cuts page faults and TLB misses on
+// multi-MB tables. Elsewhere than Linux: calloc.
+
+typedef enum {
+    AOC_PAGES_NORMAL = 0,
+    AOC_PAGES_THP = 1,      // transparent huge pages requested
+    AOC_PAGES_HUGETLB = 2,  // reserved huge pages
+} AocPages;
+
+#define AOC_HUGE_PAGE (2u * 1024 * 1024)
+
+static inline size_t aoc_large_size(size_t size) {
+    #ifdef __linux__
+    return (size + AOC_HUGE_PAGE - 1) & ~(size_t)(AOC_HUGE_PAGE - 1);
+    #else
+    return size;
+    #endif
+}
+
+static inline void* aoc_alloc_large(size_t size, AocPages* kind) {
+    AocPages got = AOC_PAGES_NORMAL;
+    void* ptr = NULL;
+
+    #ifdef __linux__
+    size_t rounded = aoc_large_size(size);
+
+    #ifdef MAP_HUGETLB
+    ptr = mmap(NULL, rounded, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        got = AOC_PAGES_HUGETLB;
+    } else
+    #endif
+    {
+        // Over-map to align on 2 MB, so THP can back the whole table
+        size_t mapped = rounded + AOC_HUGE_PAGE;
+        char* raw = (char*)mmap(NULL, mapped, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            fprintf(stderr, "ERROR:Failed to map %zu bytes\n", size);
+            exit(1);
+        }
+        char* aligned = (char*)(((uintptr_t)raw + AOC_HUGE_PAGE - 1) &
+                                ~(uintptr_t)(AOC_HUGE_PAGE - 1));
+        if (aligned > raw) munmap(raw, (size_t)(aligned - raw));
+        size_t tail = (size_t)(raw + mapped - (aligned + rounded));
+        if (tail) munmap(aligned + rounded, tail);
+        ptr = aligned;
+
+        #ifdef MADV_HUGEPAGE
+        if (madvise(ptr, rounded, MADV_HUGEPAGE) == 0) got = AOC_PAGES_THP;
+        #endif
+    }
+    #else
+    ptr = calloc(1, size);
+    if (!ptr) {
+        fprintf(stderr, "ERROR:Failed to allocate %zu bytes\n", size);
+        exit(1);
+    }
+    #endif
+
+    if (kind) *kind = got;
+    return ptr;
+}
+
+// `size` must be the size given to aoc_alloc_large
+static inline void aoc_free_large(void* ptr, size_t size) {
+    if (!ptr) return;
+    #ifdef __linux__
+    munmap(ptr, aoc_large_size(size));
+    #else
+    (void)size;
+    free(ptr);
+    #endif
+}
+
+// PERF:pages.<name>:<0 normal | 1 THP | 2 hugetlb>
+#define AOC_REPORT_PAGES(name, kind) \
+    printf("PERF:pages.%s:%d\n", #name, (int)(kind))
+
+// ═══════════════════════════════════════════════════════════════
+// Work counters (compiled out unless AOC_STATS is defined)
+// ═══════════════════════════════════════════════════════════════
+//
+//   AOC_COUNT(nodes);         // STAT:nodes:count=123456
+//   AOC_HIST(depth, d);       // STAT:depth:count=20,sum=51,min=0,max=9,
+//                             //   hist=0:1;1:4;2:8;4:5;8:2
+//
+// Tell "less work" from "faster work": build with -DAOC_STATS
+// (aoc run --stats) and each thread counts into its own block, with no
+// atomics on the hot path; the blocks are summed and printed at exit.
+// Without AOC_STATS the macros compile to nothing and their arguments are
+// not evaluated. Histogram buckets are powers of two: "4:n" counts the
+// values in [4, 8). Threads must be joined before main returns.
+
+#ifdef AOC_STATS
+
+#define AOC_STAT_MAX 64
+#define AOC_STAT_BUCKETS 65
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint64_t buckets[AOC_STAT_BUCKETS];
+} AocStat;
+
+typedef struct AocStatBlock {
+    AocStat stats[AOC_STAT_MAX];
+    struct AocStatBlock* next;
+} AocStatBlock;
+
+static const char* _aoc_stat_names[AOC_STAT_MAX];
+static int _aoc_stat_is_hist[AOC_STAT_MAX];
+static int _aoc_stat_count = 0;
+static AocStatBlock* _aoc_stat_blocks = NULL;
+static _Thread_local AocStatBlock* _aoc_stat_local = NULL;
+
+#ifndef _WIN32
+static pthread_mutex_t _aoc_stat_lock = PTHREAD_MUTEX_INITIALIZER;
+#define AOC_STAT_LOCK() pthread_mutex_lock(&_aoc_stat_lock)
+#define AOC_STAT_UNLOCK() pthread_mutex_unlock(&_aoc_stat_lock)
+#else
+// No pthreads: counters are single-threaded on Windows
+#define AOC_STAT_LOCK() ((void)0)
+#define AOC_STAT_UNLOCK() ((void)0)
+#endif
+
+static void aoc_stats_report(void) {
+    for (int id = 0; id < _aoc_stat_count; id++) {
+        AocStat total;
+        memset(&total, 0, sizeof(total));
+        total.min = UINT64_MAX;
+
+        for (AocStatBlock* b = _aoc_stat_blocks; b; b = b->next) {
+            const AocStat* s = &b->stats[id];
+            if (!s->count) continue;
+            total.count += s->count;
+            total.sum += s->sum;
+            if (s->min < total.min) total.min = s->min;
+            if (s->max > total.max) total.max = s->max;
+            for (int i = 0; i < AOC_STAT_BUCKETS; i++) {
+                total.buckets[i] += s->buckets[i];
+            }
+        }
+
+        const char* name = _aoc_stat_names[id];
+        if (!_aoc_stat_is_hist[id]) {
+            printf("STAT:%s:count=%llu\n", name,
+                   (unsigned long long)total.count);
+            continue;
+        }
+
+        printf("STAT:%s:count=%llu,sum=%llu,min=%llu,max=%llu,hist=", name,
+               (unsigned long long)total.count,
+               (unsigned long long)total.sum,
+               (unsigned long long)(total.count ? total.min : 0),
+               (unsigned long long)total.max);
+        const char* sep = "";
+        for (int i = 0; i < AOC_STAT_BUCKETS; i++) {
+            if (!total.buckets[i]) continue;
+            uint64_t low = i == 0 ? 0 : (uint64_t)1 << (i - 1);
+            printf("%s%llu:%llu", sep, (unsigned long long)low,
+                   (unsigned long long)total.buckets[i]);
+            sep = ";";
+        }
+        printf("\n");
+    }
+}
+
+// Slot of a stat name, registered on first use (the report is printed
+// at exit once the first stat exists)
+static int aoc_stat_id(const char* name, int is_hist) {
+    AOC_STAT_LOCK();
+    int id = 0;
+    while (id < _aoc_stat_count && strcmp(_aoc_stat_names[id], name) != 0) {
+        id++;
+    }
+    if (id == _aoc_stat_count) {
+        if (id == AOC_STAT_MAX) {
+            fprintf(stderr, "ERROR:Too many stats (max %d)\n", AOC_STAT_MAX);
+            exit(1);
+        }
+        _aoc_stat_names[id] = name;
+        _aoc_stat_is_hist[id] = is_hist;
+        if (id == 0) atexit(aoc_stats_report);
+        _aoc_stat_count++;
+    }
+    AOC_STAT_UNLOCK();
+    return id;
+}
+
+// This thread's block, kept after the thread exits so the report sees it
+static AocStatBlock* aoc_stat_block_new(void) {
+    AocStatBlock* b = (AocStatBlock*)calloc(1, sizeof(AocStatBlock));
+    if (!b) {
+        fprintf(stderr, "ERROR:Failed to allocate stats\n");
+        exit(1);
+    }
+    AOC_STAT_LOCK();
+    b->next = _aoc_stat_blocks;
+    _aoc_stat_blocks = b;
+    AOC_STAT_UNLOCK();
+    _aoc_stat_local = b;
+    return b;
+}
+
+// `site` caches the slot of one AOC_COUNT / AOC_HIST call site
+static inline AocStat* aoc_stat_at(int* site, const char* name, int is_hist) {
+    int id = __atomic_load_n(site, __ATOMIC_RELAXED);
+    if (id < 0) {
+        id = aoc_stat_id(name, is_hist);
+        __atomic_store_n(site, id, __ATOMIC_RELAXED);
+    }
+    AocStatBlock* b = _aoc_stat_local;
+    if (!b) b = aoc_stat_block_new();
+    return &b->stats[id];
+}
+
+static inline void aoc_stat_record(AocStat* s, uint64_t value) {
+    if (!s->count || value < s->min) s->min = value;
+    if (value > s->max) s->max = value;
+    s->count++;
+    s->sum += value;
+    s->buckets[value ? 64 - __builtin_clzll(value) : 0]++;
+}
+
+#define AOC_COUNT(name) do { \
+    static int _aoc_stat_site = -1; \
+    aoc_stat_at(&_aoc_stat_site, #name, 0)->count++; \
+} while (0)
+
+#define AOC_HIST(name, value) do { \
+    static int _aoc_stat_site = -1; \
+    aoc_stat_record(aoc_stat_at(&_aoc_stat_site, #name, 1), \
+                    (uint64_t)(value)); \
+} while (0)
+
+#else
+
+#define AOC_COUNT(name) ((void)0)
+#define AOC_HIST(name, value) ((void)sizeof(value))
+
+#endif // AOC_STATS
+
 // ═══════════════════════════════════════════════════════════════
 // Result output (standardized format)
 // ═══════════════════════════════════════════════════════════════
@@ -164,4 +691,46 @@ static inline long long aoc_parse_int(const char* str) {
     return strtoll(str, NULL, 10);
 }
 
+// Unsigned decimal at `p` (up to 19 digits), returns the end of the number.
+// SWAR: converts 8 digits per step with 3 multiplies instead of one per
+// digit. Reads 8 bytes at a time, so the buffer needs AOC_PARSE_PAD
+// readable bytes past the number (aoc_read_input and stream chunks have
+// them).
+static inline const char* aoc_parse_u64(const char* p, uint64_t* out) {
+    uint64_t value = 0;
+
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    static const uint64_t pow10[8] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+    };
+
+    for (;;) {
+        uint64_t x;
+        memcpy(&x, p, 8);
+        // Digit values, first digit in the low byte. A byte that is not a
+        // digit gets its high bit set (below '0': borrow, above '9': carry)
+        x -= 0x3030303030303030ull;
+        uint64_t stop =
+            (x | (x + 0x7676767676767676ull)) & 0x8080808080808080ull;
+        int len = stop ? __builtin_ctzll(stop) >> 3 : 8;
+        if (len == 0) break;
+
+        // Right-align the digits, then pair them up: 2, 4, then 8 digits
+        x <<= 8 * (8 - len);
+        x = (x * 10 + (x >> 8)) & 0x00FF00FF00FF00FFull;
+        x = (x * 100 + (x >> 16)) & 0x0000FFFF0000FFFFull;
+        x = (x * 10000 + (x >> 32)) & 0xFFFFFFFFull;
+
+        value = (len == 8 ? value * 100000000 : value * pow10[len]) + x;
+        p += len;
+        if (len < 8) break;
+    }
+    #else
+    while (*p >= '0' && *p <= '9') value = value * 10 + (uint64_t)(*p++ - '0');
+    #endif
+
+    *out = value;
+    return p;
+}
+
 #endif // AOC_COMMON_H
@@ -0,0 +1,464 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Benchmark Matrix
+ *
+ * Benchmark headless de la matrice agents × jours × parts × langages, sans
+ * dashboard ni serveur HTTP (aoc bench, jobs de nuit) :
+ *   1. build  : solvers C compilés en parallèle ; un binaire est réutilisé
+ *               tant que son source, le harness et le mode de build n'ont
+ *               pas changé (cache JSON de hashes)
+ *   2. runs   : chaque tâche tourne sur son propre cœur (CoreScheduler),
+ *               tous les cœurs pour les solvers C multi-threadés
+ *               (solverCores), même métrique que les benchmarks du
+ *               dashboard
+ *   3. sortie : le CLI écrit les sessions dans la DB SQLite et/ou un
+ *               rapport JSON / CSV (formatBenchReport)
+ */
+
+import { readFile, writeFile, readdir, mkdir } from "node:fs/promises";
+import { existsSync } from "node:fs";
+import { createHash } from "node:crypto";
+import { cpus } from "node:os";
+import { join, dirname, relative } from "node:path";
+import {
+  cBinaryPath,
+  compileCSource,
+  executePrecompiled,
+  getCBuildMode,
+  getHarnessDir,
+} from "./executor-c.js";
+import { executeTsIsolated } from "./executor-ts.js";
+import { CoreScheduler, solverCores } from "./scheduler.js";
+import { loadExpected } from "./utils.js";
+import type { CpuLease, SchedulerMode } from "./scheduler.js";
+import type { Agent, CBuildMode } from "./types.js";
+import type { BenchmarkStats, PerfVerdict } from "@aoc25/db";
+
+export const BENCH_AGENTS: readonly Agent[] = ["claude", "codex", "gemini"];
+export const DEFAULT_BENCH_RUNS = 100;
+
+const LAST_DAY = 25;
+
+export type BenchLanguage = "ts" | "c";
+
+export interface BenchTask {
+  agent: Agent;
+  day: number;
+  part: 1 | 2;
+  language: BenchLanguage;
+}
+
+export interface BenchFilter {
+  agents?: readonly Agent[];
+  days?: readonly number[];
+  parts?: readonly (1 | 2)[];
+  languages?: readonly BenchLanguage[];
+}
+
+export type BenchBuild =
+  | { binaryPath: string; mode: CBuildMode; cached: boolean }
+  | { error: string };
+
+export interface BenchBuildOptions {
+  // Defaults to getCBuildMode()
+  mode?: CBuildMode;
+  // Compilations at once (default: one per logical CPU)
+  concurrency?: number;
+  // Defaults to getBuildCachePath(rootDir)
+  cachePath?: string;
+}
+
+export interface BenchResult extends BenchTask {
+  // CPUs the task ran on
+  cpus: number[];
+  // ms per run: parse + solve for C, solve() for TS
+  times: number[];
+  answer: string;
+  // null when core/data has no answer for the puzzle
+  isCorrect: boolean | null;
+  // C only: mode of the binary that ran (nostart falls back to static)
+  buildMode?: CBuildMode;
+  error?: string;
+}
+
+export interface BenchRunOptions {
+  // From buildBenchTasks (C tasks without a build fail)
+  builds: Map<string, BenchBuild>;
+  // Runs per task (default: DEFAULT_BENCH_RUNS)
+  runs?: number;
+  // Default: isolated (one physical core per task, see solverCores)
+  mode?: SchedulerMode;
+  scheduler?: CoreScheduler;
+  // Each result as soon as its task is done
+  onResult?: (result: BenchResult) => void;
+}
+
+export interface BenchReportRow extends BenchTask {
+  runs: number;
+  answer: string;
+  isCorrect: boolean | null;
+  // null when the task failed
+  stats: BenchmarkStats | null;
+  // Set when the session was stored in the database
+  sessionId: number | null;
+  verdict: PerfVerdict | null;
+  error: string | null;
+}
+
+export type BenchReportFormat = "json" | "csv";
+
+export function benchTaskKey(task: BenchTask): string {
+  return `${task.agent}:${task.day}:${task.part}:${task.language}`;
+}
+
+export function getSolverPath(rootDir: string, task: BenchTask): string {
+  const dayStr = task.day.toString().padStart(2, "0");
+  return join(
+    rootDir,
+    "agents",
+    task.agent,
+    task.language,
+    `day${dayStr}`,
+    `part${task.part}.${task.language}`
+  );
+}
+
+function getInputPath(rootDir: string, day: number): string {
+  const dayStr = day.toString().padStart(2, "0");
+  return join(rootDir, "core", "data", `day${dayStr}`, "input.txt");
+}
+
+/**
+ * Tasks with both a solver and an input, agents innermost so that a
+ * puzzle's agents run side by side (same order as the dashboard sweeps)
+ */
+export function listBenchTasks(
+  rootDir: string,
+  filter: BenchFilter = {}
+): BenchTask[] {
+  const agents = filter.agents ?? BENCH_AGENTS;
+  const days = filter.days ?? Array.from({ length: LAST_DAY + 1 }, (_, d) => d);
+  const parts = filter.parts ?? [1, 2];
+  const languages = filter.languages ?? ["ts", "c"];
+  const tasks: BenchTask[] = [];
+
+  for (const day of days) {
+    if (!existsSync(getInputPath(rootDir, day))) continue;
+    for (const part of parts) {
+      for (const language of languages) {
+        for (const agent of agents) {
+          const task = { agent, day, part, language };
+          if (existsSync(getSolverPath(rootDir, task))) tasks.push(task);
+        }
+      }
+    }
+  }
+
+  return tasks;
+}
+
+/**
+ * Run `fn` over `items`, at most `limit` at a time
+ */
+async function forEachLimit<T>(
+  items: readonly T[],
+  limit: number,
+  fn: (item: T) => Promise<void>
+): Promise<void> {
+  let next = 0;
+  const worker = async () => {
+    while (next < items.length) await fn(items[next++]!);
+  };
+  const workers = Math.max(1, Math.min(limit, items.length));
+  await Promise.all(Array.from({ length: workers }, worker));
+}
+
+// ═══════════════════════════════════════════════════════════════
+// Build
+// ═══════════════════════════════════════════════════════════════
+
+// Binary path (relative to the root) -> hash of what it was built from
+type BuildCache = Record<string, { hash: string; mode: CBuildMode }>;
+
+export function getBuildCachePath(rootDir: string): string {
+  return join(rootDir, "core", "runner", ".build-cache.json");
+}
+
+async function loadBuildCache(path: string): Promise<BuildCache> {
+  try {
+    return JSON.parse(await readFile(path, "utf-8")) as BuildCache;
+  } catch {
+    return {};
+  }
+}
+
+/**
+ * Hash of every file of an agent's harness (common.h, kernel.h, start.c...)
+ */
+async function hashHarness(harnessDir: string): Promise<string> {
+  const hash = createHash("sha256");
+  try {
+    const entries = await readdir(harnessDir, { withFileTypes: true });
+    const files = entries
+      .filter((entry) => entry.isFile())
+      .map((entry) => entry.name)
+      .sort();
+    for (const name of files) {
+      hash.update(name);
+      hash.update(await readFile(join(harnessDir, name)));
+    }
+  } catch {
+    // No harness: the sources fail to compile anyway
+  }
+  return hash.digest("hex");
+}
+
+/**
+ * Compile the C tasks in parallel, reusing the binaries whose source,
+ * harness and build mode are unchanged. Keyed by benchTaskKey.
+ */
+export async function buildBenchTasks(
+  rootDir: string,
+  tasks: readonly BenchTask[],
+  options: BenchBuildOptions = {}
+): Promise<Map<string, BenchBuild>> {
+  const mode = options.mode ?? getCBuildMode();
+  const cachePath = options.cachePath ?? getBuildCachePath(rootDir);
+  const cache = await loadBuildCache(cachePath);
+  const harnessHashes = new Map<Agent, Promise<string>>();
+  const builds = new Map<string, BenchBuild>();
+
+  const build = async (task: BenchTask): Promise<BenchBuild> => {
+    const harnessDir = getHarnessDir(join(rootDir, "agents", task.agent));
+    if (!harnessHashes.has(task.agent)) {
+      harnessHashes.set(task.agent, hashHarness(harnessDir));
+    }
+
+    const sourcePath = getSolverPath(rootDir, task);
+    const binaryPath = cBinaryPath(dirname(sourcePath), task.part, mode);
+    const key = relative(rootDir, binaryPath);
+
+    let source: Buffer;
+    try {
+      source = await readFile(sourcePath);
+    } catch {
+      return { error: `Source not found: ${sourcePath}` };
+    }
+    const hash = createHash("sha256")
+      .update(mode)
+      .update(await harnessHashes.get(task.agent)!)
+      .update(source)
+      .digest("hex");
+
+    const cached = cache[key];
+    if (cached?.hash === hash && existsSync(binaryPath)) {
+      return { binaryPath, mode: cached.mode, cached: true };
+    }
+
+    const compiled = await compileCSource(sourcePath, binaryPath, {
+      mode,
+      harnessDir,
+    });
+    if ("error" in compiled) {
+      delete cache[key];
+      return compiled;
+    }
+
+    cache[key] = { hash, mode: compiled.mode };
+    return { binaryPath, mode: compiled.mode, cached: false };
+  };
+
+  const cTasks = tasks.filter((task) => task.language === "c");
+  await forEachLimit(
+    cTasks,
+    options.concurrency ?? cpus().length,
+    async (task) => {
+      builds.set(benchTaskKey(task), await build(task));
+    }
+  );
+
+  await mkdir(dirname(cachePath), { recursive: true });
+  await writeFile(cachePath, `${JSON.stringify(cache, null, 2)}\n`);
+  return builds;
+}
+
+// ═══════════════════════════════════════════════════════════════
+// Runs
+// ═══════════════════════════════════════════════════════════════
+
+async function runBenchTask(
+  rootDir: string,
+  task: BenchTask,
+  runs: number,
+  build: BenchBuild | undefined,
+  input: string | null,
+  lease: CpuLease
+): Promise<BenchResult> {
+  const times: number[] = [];
+  let answer = "";
+  const result = (error?: string): BenchResult => ({
+    ...task,
+    cpus: lease.cpus,
+    times,
+    answer,
+    isCorrect: null,
+    ...(build && "mode" in build && { buildMode: build.mode }),
+    ...(error !== undefined && { error }),
+  });
+
+  if (input === null) return result("Input file not found");
+  if (task.language === "c" && !build) return result("Not built");
+  if (build && "error" in build) return result(build.error);
+
+  for (let i = 0; i < runs; i++) {
+    let run: { answer: string; timeMs: number; error?: string | undefined };
+
+    if (build) {
+      const output = await executePrecompiled(
+        build.binaryPath,
+        input,
+        undefined,
+        lease
+      );
+      // parse + solve like the dashboard, process startup left out
+      const internal = (output.parseTimeMs ?? 0) + (output.solveTimeMs ?? 0);
+      run = {
+        answer: output.answer,
+        timeMs: internal > 0 ? internal : output.timeMs,
+        error: output.error,
+      };
+    } else {
+      run = await executeTsIsolated(getSolverPath(rootDir, task), input, lease);
+    }
+
+    if (run.error) return result(run.error);
+    times.push(run.timeMs);
+    if (i === 0) answer = run.answer;
+  }
+
+  const agentDir = join(rootDir, "agents", task.agent);
+  const expected = await loadExpected(agentDir, task.day, false);
+  const expectedAnswer = task.part === 1 ? expected.part1 : expected.part2;
+
+  return {
+    ...result(),
+    isCorrect: expectedAnswer === null ? null : answer === expectedAnswer,
+  };
+}
+
+/**
+ * Benchmark the tasks, as many at once as the scheduler has room for in
+ * `mode`. Results come back (and through onResult) in completion order.
+ */
+export async function runBenchMatrix(
+  rootDir: string,
+  tasks: readonly BenchTask[],
+  options: BenchRunOptions
+): Promise<BenchResult[]> {
+  const runs = options.runs ?? DEFAULT_BENCH_RUNS;
+  const mode = options.mode ?? "isolated";
+  const scheduler = options.scheduler ?? new CoreScheduler();
+  const inputs = new Map<number, Promise<string | null>>();
+  const results: BenchResult[] = [];
+
+  const readInput = (day: number) => {
+    if (!inputs.has(day)) {
+      inputs.set(
+        day,
+        readFile(getInputPath(rootDir, day), "utf-8").catch(() => null)
+      );
+    }
+    return inputs.get(day)!;
+  };
+
+  // Threaded C solvers size their pool from the CPUs they are pinned to
+  const leaseCores = async (task: BenchTask) => {
+    if (task.language !== "c") return 1;
+    const source = await readFile(getSolverPath(rootDir, task), "utf-8");
+    return solverCores(source);
+  };
+
+  await forEachLimit(tasks, scheduler.capacity(mode), async (task) => {
+    const input = await readInput(task.day);
+    const cores = await leaseCores(task).catch(() => 1);
+    const result = await scheduler.run(
+      mode,
+      (lease) =>
+        runBenchTask(
+          rootDir,
+          task,
+          runs,
+          options.builds.get(benchTaskKey(task)),
+          input,
+          lease
+        ),
+      cores
+    );
+    results.push(result);
+    options.onResult?.(result);
+  });
+
+  return results;
+}
+
+// ═══════════════════════════════════════════════════════════════
+// Report
+// ═══════════════════════════════════════════════════════════════
+
+const CSV_COLUMNS = [
+  "agent",
+  "day",
+  "part",
+  "language",
+  "runs",
+  "answer",
+  "is_correct",
+  "avg_ms",
+  "min_ms",
+  "p50_ms",
+  "p95_ms",
+  "p99_ms",
+  "max_ms",
+  "std_dev_ms",
+  "session_id",
+  "perf_verdict",
+  "error",
+];
+
+function csvField(value: string | number | boolean | null): string {
+  if (value === null) return "";
+  const text = String(value);
+  return /[",\r\n]/.test(text) ? `"${text.replace(/"/g, '""')}"` : text;
+}
+
+export function formatBenchReport(
+  rows: readonly BenchReportRow[],
+  format: BenchReportFormat
+): string {
+  if (format === "json") return `${JSON.stringify(rows, null, 2)}\n`;
+
+  const lines = rows.map((row) =>
+    [
+      row.agent,
+      row.day,
+      row.part,
+      row.language,
+      row.runs,
+      row.answer,
+      row.isCorrect,
+      row.stats?.avg ?? null,
+      row.stats?.min ?? null,
+      row.stats?.p50 ?? null,
+      row.stats?.p95 ?? null,
+      row.stats?.p99 ?? null,
+      row.stats?.max ?? null,
+      row.stats?.stdDev ?? null,
+      row.sessionId,
+      row.verdict,
+      row.error,
+    ]
+      .map(csvField)
+      .join(",")
+  );
+
+  return `${[CSV_COLUMNS.join(","), ...lines].join("\n")}\n`;
+}
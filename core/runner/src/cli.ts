@@ -3,20 +3,51 @@
  * 🏆 AoC 2025 Battle Royale - CLI
  *
  * Usage:
- *   aoc run <day> <part> [--sample] [--lang c]
- *   aoc check <day> <part> [--sample] [--lang c]
+ *   aoc run <day> <part> [--sample] [--lang c] [--build static] [--stats]
+ *   aoc check <day> <part> [--sample] [--lang c] [--perf [runs]]
+ *   aoc startup [runs]
+ *   aoc kernels <file.c> [day] [--sample] [--samples n] [--json] [--no-db]
+ *   aoc bench [--all] [--days 0-12] [--runs n] [--json f] [--csv f] [--no-db]
  */
 
 import { Command } from "commander";
+import { readFile, writeFile } from "node:fs/promises";
+import { existsSync } from "node:fs";
+import { join, relative, resolve } from "node:path";
 import { executeTs } from "./executor-ts.js";
-import { executeC } from "./executor-c.js";
+import {
+  executeC,
+  getCBuildMode,
+  getCStats,
+  getHarnessDir,
+  parseCBuildMode,
+  C_BUILD_MODES,
+} from "./executor-c.js";
+import { AocDatabase, computeStats } from "@aoc25/db";
+import { checkPerf, getRootDbPath, DEFAULT_PERF_RUNS } from "./perf.js";
+import { measureStartup, DEFAULT_STARTUP_RUNS } from "./startup.js";
+import { runKernelBench } from "./kernels.js";
+import { formatStatLine } from "./output.js";
+import { CoreScheduler, parseCpuList } from "./scheduler.js";
+import type { SchedulerMode } from "./scheduler.js";
+import {
+  listBenchTasks,
+  buildBenchTasks,
+  runBenchMatrix,
+  formatBenchReport,
+  benchTaskKey,
+  BENCH_AGENTS,
+  DEFAULT_BENCH_RUNS,
+} from "./bench.js";
+import type { BenchLanguage, BenchReportRow } from "./bench.js";
 import {
   detectAgent,
   getCoreDataDir,
   loadExpected,
   formatResult,
+  formatTime,
 } from "./utils.js";
-import type { RunConfig, RunResult } from "./types.js";
+import type { Agent, RunConfig, RunResult, CBuildMode } from "./types.js";
 
 const program = new Command();
 
@@ -29,6 +60,37 @@ program
 interface RunOptions {
   sample?: boolean;
   lang?: "ts" | "c";
+  build?: string;
+  stats?: boolean;
+}
+
+interface CheckOptions extends RunOptions {
+  perf?: boolean | string;
+}
+
+interface BenchOptions {
+  all?: boolean;
+  agents?: string;
+  days?: string;
+  parts?: string;
+  lang?: string;
+  runs?: string;
+  mode: string;
+  build?: string;
+  jobs?: string;
+  json?: string;
+  csv?: string;
+  // false with --no-db
+  db: boolean;
+}
+
+interface KernelOptions {
+  sample?: boolean;
+  build?: string;
+  samples?: string;
+  json?: boolean;
+  // false with --no-db
+  db: boolean;
 }
 
 function validateDayPart(
@@ -51,11 +113,52 @@ function validateDayPart(
   return { day, part: part as 1 | 2 };
 }
 
+const BUILD_OPTION_HELP = `C build mode: ${C_BUILD_MODES.join(
+  ", "
+)} (default: AOC_C_BUILD or dynamic)`;
+
+function resolveBuildMode(options: { build?: string }): CBuildMode {
+  if (options.build === undefined) return getCBuildMode();
+
+  const mode = parseCBuildMode(options.build);
+  if (!mode) {
+    console.error(
+      `❌ Invalid build mode: ${options.build} (${C_BUILD_MODES.join(", ")})`
+    );
+    process.exit(1);
+  }
+  return mode;
+}
+
+const STATS_OPTION_HELP =
+  "C only: build with the AOC_COUNT / AOC_HIST work counters (default: AOC_STATS=1)";
+
+/**
+ * Echo the counters as STAT: lines (parsed back by the dashboard)
+ */
+function logStats(result: RunResult): void {
+  if (!result.stats) return;
+  console.log("📈 Stats:");
+  for (const [name, stat] of Object.entries(result.stats)) {
+    console.log(formatStatLine(name, stat));
+  }
+}
+
+function logBuildMode(requested: CBuildMode, result: RunResult): void {
+  if (result.buildMode && result.buildMode !== requested) {
+    console.log(
+      `⚠️  ${requested} build failed (solver uses libc?), ran the ${result.buildMode} build`
+    );
+  }
+}
+
 program
   .command("run <day> <part>")
   .description("Run a solver")
   .option("-s, --sample", "Use sample input instead of final input")
   .option("-l, --lang <lang>", "Language: ts or c", "ts")
+  .option("-b, --build <mode>", BUILD_OPTION_HELP)
+  .option("--stats", STATS_OPTION_HELP)
   .action(async (dayStr: string, partStr: string, options: RunOptions) => {
     const validated = validateDayPart(dayStr, partStr);
     if (!validated) return;
@@ -63,6 +166,7 @@ program
     const { day, part } = validated;
     const lang = (options.lang as "ts" | "c") || "ts";
     const useSample = options.sample ?? false;
+    const build = resolveBuildMode(options);
 
     // Detect agent
     const agentInfo = detectAgent(process.cwd());
@@ -81,6 +185,9 @@ program
     );
     console.log(`🤖 Agent: ${agent}`);
     console.log(`📝 Language: ${lang.toUpperCase()}`);
+    if (lang === "c" && build !== "dynamic") {
+      console.log(`🔧 Build: ${build}`);
+    }
     console.log(`📁 Input: ${useSample ? "sample" : "final"}`);
     console.log("─".repeat(40));
 
@@ -91,6 +198,8 @@ program
       useSample,
       agentDir,
       coreDataDir,
+      build,
+      stats: options.stats ?? getCStats(),
     };
 
     // Execute
@@ -99,6 +208,7 @@ program
       result = await executeTs(config);
     } else {
       result = await executeC(config);
+      logBuildMode(build, result);
     }
 
     // Load expected for comparison
@@ -118,6 +228,7 @@ program
         result.error
       )
     );
+    logStats(result);
     console.log("");
   });
 
@@ -126,13 +237,20 @@ program
   .description("Run solver and verify against expected answer")
   .option("-s, --sample", "Use sample input")
   .option("-l, --lang <lang>", "Language: ts or c", "ts")
-  .action(async (dayStr: string, partStr: string, options: RunOptions) => {
+  .option("-b, --build <mode>", BUILD_OPTION_HELP)
+  .option("--stats", STATS_OPTION_HELP)
+  .option(
+    "-p, --perf [runs]",
+    `Also fail on a perf regression vs recent benchmarks (default ${DEFAULT_PERF_RUNS} runs)`
+  )
+  .action(async (dayStr: string, partStr: string, options: CheckOptions) => {
     const validated = validateDayPart(dayStr, partStr);
     if (!validated) return;
 
     const { day, part } = validated;
     const lang = (options.lang as "ts" | "c") || "ts";
     const useSample = options.sample ?? false;
+    const build = resolveBuildMode(options);
 
     const agentInfo = detectAgent(process.cwd());
     if (!agentInfo) {
@@ -173,6 +291,8 @@ program
       useSample,
       agentDir,
       coreDataDir,
+      build,
+      stats: options.stats ?? getCStats(),
     };
 
     let result: RunResult;
@@ -180,6 +300,7 @@ program
       result = await executeTs(config);
     } else {
       result = await executeC(config);
+      logBuildMode(build, result);
     }
 
     if (result.error) {
@@ -196,12 +317,387 @@ program
         expectedAnswer
       )
     );
+    logStats(result);
 
     if (!result.isCorrect) {
       process.exit(1);
     }
 
+    if (options.perf) {
+      const runs =
+        typeof options.perf === "string"
+          ? parseInt(options.perf, 10) || DEFAULT_PERF_RUNS
+          : DEFAULT_PERF_RUNS;
+
+      if (useSample) {
+        console.log("⚠️  Perf check skipped (sample input)");
+      } else {
+        console.log(`⏱️  Perf check: ${runs} runs vs recent benchmarks...`);
+        const perf = await checkPerf(config, agent, runs);
+
+        if (!perf) {
+          console.log("⚠️  Perf check skipped (no dashboard database)");
+        } else if (perf.error) {
+          console.log(`❌ Perf check error: ${perf.error}`);
+          process.exit(1);
+        } else {
+          const { verdict, pValue, deltaPct, baselineRuns } = perf.regression;
+          const detail =
+            deltaPct !== null && pValue !== null
+              ? ` (${deltaPct > 0 ? "+" : ""}${deltaPct.toFixed(1)}% median, p=${pValue.toExponential(2)}, ${baselineRuns} baseline runs)`
+              : ` (${baselineRuns} baseline runs)`;
+
+          if (verdict === "regression") {
+            console.log(`❌ Perf regression${detail}`);
+            process.exit(1);
+          } else if (verdict === "improvement") {
+            console.log(`🚀 Perf improvement${detail}`);
+          } else if (verdict === "insufficient") {
+            console.log(`⚠️  Not enough benchmark history${detail}`);
+          } else {
+            console.log(`✅ Perf unchanged${detail}`);
+          }
+        }
+      }
+    }
+
+    console.log("");
+  });
+
+program
+  .command("startup [runs]")
+  .description("Measure the startup cost of an empty C solver per build mode")
+  .action(async (runsStr: string | undefined) => {
+    const runs = runsStr
+      ? parseInt(runsStr, 10) || DEFAULT_STARTUP_RUNS
+      : DEFAULT_STARTUP_RUNS;
+
+    const agentInfo = detectAgent(process.cwd());
+    if (!agentInfo) {
+      console.error("❌ Not in an agent directory.");
+      process.exit(1);
+    }
+
+    console.log(`\n⏱️  C startup cost (empty solver, ${runs} runs)`);
+    console.log("─".repeat(40));
+
+    const results = await measureStartup(
+      getHarnessDir(agentInfo.agentDir),
+      runs
+    );
+
+    for (const cost of results) {
+      const mode = cost.mode.padEnd(8);
+      if (cost.error) {
+        console.log(`❌ ${mode} ${cost.error.split("\n")[0]}`);
+        continue;
+      }
+      console.log(
+        `🚀 ${mode} exec→main ${cost.execToMainUs.toFixed(1)}µs (min ${cost.execToMainMinUs.toFixed(1)}) | exec→exit ${cost.execToExitUs.toFixed(1)}µs (min ${cost.execToExitMinUs.toFixed(1)})`
+      );
+    }
+
     console.log("");
   });
 
+program
+  .command("kernels <file> [day]")
+  .description("Compare the kernels of a c/kernel.h microbenchmark")
+  .option("-s, --sample", "Use sample input")
+  .option("-b, --build <mode>", BUILD_OPTION_HELP)
+  .option("-n, --samples <n>", "Timed samples per kernel (default 20)")
+  .option("--json", "Print the results as JSON")
+  .option("--no-db", "Don't store the results in the dashboard database")
+  .action(
+    async (file: string, dayStr: string | undefined, options: KernelOptions) => {
+      const agentInfo = detectAgent(process.cwd());
+      if (!agentInfo) {
+        console.error("❌ Not in an agent directory.");
+        process.exit(1);
+      }
+      const { agent, agentDir } = agentInfo;
+
+      // Input of a day, or nothing when the bench embeds its data
+      let input = "";
+      let day: number | null = null;
+      if (dayStr !== undefined) {
+        const validated = validateDayPart(dayStr, "1");
+        if (!validated) process.exit(1);
+        day = validated.day;
+        const dayDir = `day${validated.day.toString().padStart(2, "0")}`;
+        const inputPath = options.sample
+          ? join(agentDir, "data", dayDir, "sample.txt")
+          : join(getCoreDataDir(agentDir, validated.day), "input.txt");
+        try {
+          input = await readFile(inputPath, "utf-8");
+        } catch {
+          console.error(`❌ Failed to read input: ${inputPath}`);
+          process.exit(1);
+        }
+      }
+
+      const samples = options.samples ? parseInt(options.samples, 10) : NaN;
+      const result = await runKernelBench(resolve(file), input, {
+        harnessDir: getHarnessDir(agentDir),
+        mode: resolveBuildMode(options),
+        ...(samples > 0 ? { samples } : {}),
+      });
+
+      // Sample-input runs are not kept, like `aoc run --sample`
+      let storedId: number | null = null;
+      const dbPath = getRootDbPath(resolve(agentDir, "..", ".."));
+      if (
+        options.db !== false &&
+        !options.sample &&
+        result.kernels.length > 0 &&
+        existsSync(dbPath)
+      ) {
+        const db = new AocDatabase(dbPath);
+        storedId = db.createKernelRun({
+          agent,
+          file: relative(agentDir, resolve(file)).replaceAll("\\", "/"),
+          day,
+          ...(result.buildMode && { build_mode: result.buildMode }),
+          kernels: result.kernels,
+        });
+        db.close();
+      }
+
+      if (options.json) {
+        console.log(JSON.stringify(result, null, 2));
+      } else {
+        console.log(`\n⚡ Kernels: ${file}`);
+        console.log("─".repeat(40));
+
+        const reference = result.kernels[0];
+        const width = Math.max(0, ...result.kernels.map((k) => k.name.length));
+        const byMedian = [...result.kernels].sort(
+          (a, b) => a.medianNs - b.medianNs
+        );
+
+        for (const kernel of byMedian) {
+          const speedup = reference
+            ? ` x${(reference.medianNs / kernel.medianNs).toFixed(2)}`
+            : "";
+          console.log(
+            `${kernel.ok ? "✅" : "❌"} ${kernel.name.padEnd(width)} ${formatNs(kernel.medianNs)} ±${formatNs(kernel.stdDevNs)} (min ${formatNs(kernel.minNs)})${speedup}${kernel.ok ? "" : ` answer ${kernel.answer}`}`
+          );
+        }
+
+        if (reference) {
+          console.log(`🎯 Reference: ${reference.name} = ${result.answer}`);
+        }
+        if (storedId !== null) {
+          console.log(`💾 Stored as kernel run #${storedId}`);
+        }
+        if (result.error) console.log(`❌ Error: ${result.error}`);
+        console.log("");
+      }
+
+      if (result.error || !result.ok) process.exit(1);
+    }
+  );
+
+program
+  .command("bench")
+  .description("Benchmark the solver matrix without the dashboard")
+  .option("-a, --all", "Every agent (default: the current one)")
+  .option("--agents <list>", "Agents, comma-separated")
+  .option("-d, --days <list>", "Days, e.g. 0-12 (default: all with an input)")
+  .option("-p, --parts <list>", "Parts (default: 1,2)")
+  .option("-l, --lang <list>", "Languages (default: ts,c)")
+  .option("-n, --runs <n>", `Runs per puzzle (default ${DEFAULT_BENCH_RUNS})`)
+  .option("-m, --mode <mode>", "Scheduling: isolated or throughput", "isolated")
+  .option("-b, --build <mode>", BUILD_OPTION_HELP)
+  .option("-j, --jobs <n>", "Parallel C builds (default: one per CPU)")
+  .option("--json <file>", "Write a JSON report")
+  .option("--csv <file>", "Write a CSV report")
+  .option("--no-db", "Don't store the sessions in the dashboard database")
+  .action(async (options: BenchOptions) => {
+    const agentInfo = detectAgent(process.cwd());
+    const rootDir = agentInfo
+      ? resolve(agentInfo.agentDir, "..", "..")
+      : process.cwd();
+
+    let agents: Agent[];
+    if (options.agents) {
+      agents = options.agents.split(",") as Agent[];
+    } else if (options.all) {
+      agents = [...BENCH_AGENTS];
+    } else if (agentInfo) {
+      agents = [agentInfo.agent];
+    } else {
+      console.error("❌ Not in an agent directory (use --all).");
+      process.exit(1);
+    }
+
+    const days = options.days ? parseCpuList(options.days) : undefined;
+    const parts = (
+      options.parts ? parseCpuList(options.parts) : [1, 2]
+    ) as (1 | 2)[];
+    const languages = (options.lang ?? "ts,c").split(",") as BenchLanguage[];
+    const runs = options.runs
+      ? parseInt(options.runs, 10) || DEFAULT_BENCH_RUNS
+      : DEFAULT_BENCH_RUNS;
+    const jobs = options.jobs ? parseInt(options.jobs, 10) : NaN;
+    const build = resolveBuildMode(options);
+
+    if (agents.some((a) => !BENCH_AGENTS.includes(a))) {
+      console.error(`❌ Invalid agents: ${options.agents}`);
+      process.exit(1);
+    }
+    if (parts.some((p) => p !== 1 && p !== 2)) {
+      console.error(`❌ Invalid parts: ${options.parts} (must be 1 or 2)`);
+      process.exit(1);
+    }
+    if (languages.some((l) => l !== "ts" && l !== "c")) {
+      console.error(`❌ Invalid languages: ${options.lang} (ts, c)`);
+      process.exit(1);
+    }
+    if (options.mode !== "isolated" && options.mode !== "throughput") {
+      console.error(`❌ Invalid mode: ${options.mode} (isolated, throughput)`);
+      process.exit(1);
+    }
+    const mode: SchedulerMode = options.mode;
+
+    const tasks = listBenchTasks(rootDir, {
+      agents,
+      ...(days ? { days } : {}),
+      parts,
+      languages,
+    });
+    if (tasks.length === 0) {
+      console.error("❌ No solver with an input matches the filters.");
+      process.exit(1);
+    }
+
+    let db: AocDatabase | null = null;
+    if (options.db !== false) {
+      const dbPath = getRootDbPath(rootDir);
+      if (existsSync(dbPath)) {
+        db = new AocDatabase(dbPath);
+      } else {
+        console.log(
+          `⚠️  No dashboard database (${dbPath}), sessions not stored`
+        );
+      }
+    }
+
+    console.log(
+      `\n📊 Benchmark: ${tasks.length} puzzles × ${runs} runs (${agents.join(", ")})`
+    );
+    console.log("─".repeat(40));
+
+    const cCount = tasks.filter((t) => t.language === "c").length;
+    const builds = await buildBenchTasks(rootDir, tasks, {
+      mode: build,
+      ...(jobs > 0 ? { concurrency: jobs } : {}),
+    });
+    const built = [...builds.values()];
+    const cached = built.filter((b) => "cached" in b && b.cached).length;
+    const failed = built.filter((b) => "error" in b).length;
+    console.log(
+      `🔨 ${cCount} C builds: ${cCount - cached - failed} compiled, ${cached} cached, ${failed} failed`
+    );
+
+    const scheduler = new CoreScheduler();
+    console.log(
+      `🏁 Running ${mode}, ${scheduler.capacity(mode)} puzzles at a time`
+    );
+
+    const order = new Map(tasks.map((task, i) => [benchTaskKey(task), i]));
+    const rows: BenchReportRow[] = [];
+
+    await runBenchMatrix(rootDir, tasks, {
+      builds,
+      runs,
+      mode,
+      scheduler,
+      onResult: (result) => {
+        const row: BenchReportRow = {
+          agent: result.agent,
+          day: result.day,
+          part: result.part,
+          language: result.language,
+          runs: result.times.length,
+          answer: result.answer,
+          isCorrect: result.isCorrect,
+          stats: null,
+          sessionId: null,
+          verdict: null,
+          error: result.error ?? null,
+        };
+
+        if (!result.error && result.times.length > 0) {
+          if (db) {
+            const created = db.createBenchmarkSession({
+              agent: result.agent,
+              day: result.day,
+              part: result.part,
+              language: result.language,
+              num_runs: result.times.length,
+              answer: result.answer,
+              ...(result.isCorrect !== null && {
+                is_correct: result.isCorrect,
+              }),
+              ...(result.buildMode && { build_mode: result.buildMode }),
+              times: result.times,
+            });
+            row.stats = created.stats;
+            row.sessionId = created.id;
+            row.verdict = created.regression.verdict;
+          } else {
+            row.stats = computeStats(result.times);
+          }
+        }
+
+        rows.push(row);
+
+        const name = `Day ${result.day.toString().padStart(2, "0")} P${result.part} ${result.language.padEnd(2)} ${result.agent.padEnd(6)}`;
+        if (row.error) {
+          console.log(`❌ ${name} ${row.error.split("\n")[0]}`);
+        } else {
+          const icon =
+            row.isCorrect === false ? "❌" : row.isCorrect ? "✅" : "❔";
+          const verdict =
+            row.verdict === "regression" || row.verdict === "improvement"
+              ? ` ${row.verdict}`
+              : "";
+          const wrong = row.isCorrect === false ? ` answer ${row.answer}` : "";
+          console.log(
+            `${icon} ${name} p50 ${formatTime(row.stats!.p50)} (min ${formatTime(row.stats!.min)})${verdict}${wrong}`
+          );
+        }
+      },
+    });
+
+    db?.close();
+    rows.sort(
+      (a, b) => order.get(benchTaskKey(a))! - order.get(benchTaskKey(b))!
+    );
+
+    for (const [path, format] of [
+      [options.json, "json"],
+      [options.csv, "csv"],
+    ] as const) {
+      if (!path) continue;
+      await writeFile(path, formatBenchReport(rows, format));
+      console.log(`📝 ${format.toUpperCase()} report: ${path}`);
+    }
+
+    const errors = rows.filter((r) => r.error).length;
+    const wrong = rows.filter((r) => r.isCorrect === false).length;
+    console.log(
+      `\n🏆 ${rows.length - errors - wrong}/${rows.length} ok, ${wrong} wrong, ${errors} errors\n`
+    );
+
+    if (errors > 0 || wrong > 0) process.exit(1);
+  });
+
+function formatNs(ns: number): string {
+  if (ns >= 1e6) return `${(ns / 1e6).toFixed(2)}ms`;
+  if (ns >= 1e3) return `${(ns / 1e3).toFixed(2)}µs`;
+  return `${ns.toFixed(1)}ns`;
+}
+
 program.parse();
@@ -9,12 +9,17 @@
  */
 
 import { readFile, access } from "node:fs/promises";
-import { join } from "node:path";
+import { join, delimiter } from "node:path";
 import { spawn } from "node:child_process";
-import { constants } from "node:fs";
-import type { RunResult, RunConfig } from "./types.js";
+import { constants, existsSync } from "node:fs";
+import { OutputParser, CappedText } from "./output.js";
+import { pinCommand } from "./scheduler.js";
+import type { CpuLease } from "./scheduler.js";
+import type { OutputRecord, ParsedOutput } from "./output.js";
+import type { RunResult, RunConfig, CBuildMode } from "./types.js";
 
 const COMPILER = "clang";
+const STATIC_COMPILER = "musl-gcc";
 const EXE_EXT = process.platform === "win32" ? ".exe" : "";
 
 interface ParsedCOutput {
@@ -25,57 +30,175 @@ interface ParsedCOutput {
   error: string | undefined;
 }
 
-function parseCOutput(stdout: string, totalTimeMs: number): ParsedCOutput {
-  const lines = stdout.trim().split("\n");
-
-  let answer = "";
-  let parseTimeMs: number | null = null;
-  let solveTimeMs: number | null = null;
-  let error: string | undefined;
-
-  for (const line of lines) {
-    if (line.startsWith("TIME:")) {
-      // Format: TIME:name:milliseconds
-      const parts = line.substring(5).split(":");
-      if (parts.length >= 2) {
-        const name = parts[0];
-        const ms = parseFloat(parts[1]!);
-        if (name === "parse") parseTimeMs = ms;
-        else if (name === "solve") solveTimeMs = ms;
-      }
-    } else if (line.startsWith("ANSWER:")) {
-      answer = line.substring(7);
-    } else if (line.startsWith("ERROR:")) {
-      error = line.substring(6);
-    }
-  }
+function parseCOutput(
+  output: ParsedOutput,
+  totalTimeMs: number
+): ParsedCOutput {
+  let answer = output.answer ?? "";
+  const error = output.error ?? undefined;
 
   // Fallback: if no standardized output, use the raw output as answer
-  if (!answer && !error && stdout.trim()) {
-    answer = stdout.trim().split("\n")[0] || "";
+  if (!answer && !error && output.text.trim()) {
+    answer = output.text.trim().split("\n")[0] || "";
   }
 
   return {
     answer,
-    parseTimeMs,
-    solveTimeMs,
+    parseTimeMs: output.times.parse ?? null,
+    solveTimeMs: output.times.solve ?? null,
     totalTimeMs,
     error,
   };
 }
 
+export const C_BUILD_MODES: readonly CBuildMode[] = [
+  "dynamic",
+  "static",
+  "nostart",
+];
+
+export function parseCBuildMode(value: string | undefined): CBuildMode | null {
+  return C_BUILD_MODES.find((mode) => mode === value) ?? null;
+}
+
+/**
+ * Build mode from AOC_C_BUILD (dynamic when unset or unknown)
+ */
+export function getCBuildMode(): CBuildMode {
+  return parseCBuildMode(process.env.AOC_C_BUILD) ?? "dynamic";
+}
+
+let muslAvailable: boolean | null = null;
+
+function hasMusl(): boolean {
+  if (muslAvailable === null) {
+    muslAvailable = (process.env.PATH ?? "")
+      .split(delimiter)
+      .some((dir) => dir && existsSync(join(dir, STATIC_COMPILER)));
+  }
+  return muslAvailable;
+}
+
+/**
+ * Whether C solvers are built with their work counters (AOC_STATS=1)
+ */
+export function getCStats(): boolean {
+  return process.env.AOC_STATS === "1";
+}
+
+/**
+ * Binary path for a build mode, so the modes (and the counter builds)
+ * don't overwrite each other
+ */
+export function cBinaryPath(
+  sourceDir: string,
+  part: 1 | 2,
+  mode: CBuildMode = "dynamic",
+  stats = false
+): string {
+  const suffix =
+    (mode === "dynamic" ? "" : `.${mode}`) + (stats ? ".stats" : "");
+  return join(sourceDir, `part${part}${suffix}${EXE_EXT}`);
+}
+
+/**
+ * Compiler command line for a build mode. `harnessDir` is the directory
+ * holding start.c (the agent's tools/runner/c), `defines` are passed as -D.
+ */
+export function cCompileCommand(
+  mode: CBuildMode,
+  sourcePath: string,
+  outputPath: string,
+  harnessDir: string,
+  defines: string[] = []
+): { command: string; args: string[] } {
+  const flags = ["-O2", ...defines.map((d) => `-D${d}`)];
+
+  switch (mode) {
+    case "dynamic":
+      return {
+        command: COMPILER,
+        args: [...flags, "-o", outputPath, sourcePath],
+      };
+    case "static":
+      return {
+        command: hasMusl() ? STATIC_COMPILER : COMPILER,
+        args: [...flags, "-static", "-o", outputPath, sourcePath],
+      };
+    case "nostart":
+      // No TLS without libc: the stack protector canary would fault
+      return {
+        command: COMPILER,
+        args: [
+          ...flags,
+          "-static",
+          "-nostdlib",
+          "-fno-stack-protector",
+          "-o",
+          outputPath,
+          sourcePath,
+          join(harnessDir, "start.c"),
+        ],
+      };
+  }
+}
+
+export interface CompileCOptions {
+  // Defaults to getCBuildMode()
+  mode?: CBuildMode;
+  // Directory holding start.c (the agent's tools/runner/c)
+  harnessDir: string;
+  // Build the AOC_COUNT / AOC_HIST counters in (-DAOC_STATS)
+  stats?: boolean;
+  // Wraps the compiler command line (e.g. pinCommand)
+  wrap?: (
+    command: string,
+    args: string[]
+  ) => { command: string; args: string[] };
+}
+
+/**
+ * Compile a C source. A nostart build that fails to link (the solver uses
+ * libc) is retried as a static build; the mode actually used is returned.
+ */
+export async function compileCSource(
+  sourcePath: string,
+  outputPath: string,
+  options: CompileCOptions
+): Promise<{ mode: CBuildMode } | { error: string }> {
+  const mode = options.mode ?? getCBuildMode();
+  const error = await compile(sourcePath, outputPath, mode, options);
+  if (!error) return { mode };
+
+  if (mode === "nostart") {
+    const retry = await compile(sourcePath, outputPath, "static", options);
+    if (!retry) return { mode: "static" };
+  }
+
+  return { error };
+}
+
 async function compile(
   sourcePath: string,
-  outputPath: string
+  outputPath: string,
+  mode: CBuildMode,
+  options: CompileCOptions
 ): Promise<string | null> {
   return new Promise((resolve) => {
-    const args = ["-O2", "-o", outputPath, sourcePath];
-    const proc = spawn(COMPILER, args);
-
-    let stderr = "";
-    proc.stderr.on("data", (data) => {
-      stderr += data.toString();
-    });
+    const base = cCompileCommand(
+      mode,
+      sourcePath,
+      outputPath,
+      options.harnessDir,
+      options.stats ? ["AOC_STATS"] : []
+    );
+    const { command, args } = options.wrap
+      ? options.wrap(base.command, base.args)
+      : base;
+    const proc = spawn(command, args);
+
+    const stderr = new CappedText();
+    proc.stderr.on("data", (data: Buffer) => stderr.write(data));
 
     proc.on("close", (code) => {
       if (code === 0) {
@@ -91,18 +214,32 @@ async function compile(
   });
 }
 
+interface ExecuteResult {
+  output: ParsedOutput | null;
+  stderr: string;
+  timeMs: number;
+  error?: string;
+}
+
+/**
+ * Run a binary, parsing stdout line by line as it arrives (bounded memory).
+ * `onRecord` sees each TIME:/PERF:/ANSWER:/ERROR: line before exit.
+ */
 async function execute(
   binaryPath: string,
-  input: string
-): Promise<{ stdout: string; stderr: string; timeMs: number; error?: string }> {
+  input: string,
+  onRecord?: (record: OutputRecord) => void,
+  lease?: CpuLease
+): Promise<ExecuteResult> {
   return new Promise((resolve) => {
     const startTime = process.hrtime.bigint();
-    const proc = spawn(binaryPath, [], {
+    const { command, args } = pinCommand(lease, binaryPath, []);
+    const proc = spawn(command, args, {
       stdio: ["pipe", "pipe", "pipe"],
     });
 
-    let stdout = "";
-    let stderr = "";
+    const stdout = new OutputParser(onRecord ? { onRecord } : {});
+    const stderr = new CappedText();
     let killed = false;
 
     // Timeout after 60 seconds
@@ -111,44 +248,46 @@ async function execute(
       proc.kill("SIGKILL");
     }, 60_000);
 
-    proc.stdout.on("data", (data) => {
-      stdout += data.toString();
-    });
-
-    proc.stderr.on("data", (data) => {
-      stderr += data.toString();
-    });
+    proc.stdout.on("data", (data: Buffer) => stdout.write(data));
+    proc.stderr.on("data", (data: Buffer) => stderr.write(data));
 
     proc.on("close", (code) => {
       clearTimeout(timeout);
       const endTime = process.hrtime.bigint();
       const timeMs = Number(endTime - startTime) / 1_000_000;
+      const output = stdout.end();
 
       if (killed) {
         resolve({
-          stdout: "",
+          output: null,
           stderr: "",
           timeMs,
           error: "Execution timed out (60s)",
         });
       } else if (code !== 0) {
-        resolve({ stdout, stderr, timeMs, error: `Exit code ${code}` });
+        resolve({
+          output,
+          stderr: stderr.toString(),
+          timeMs,
+          error: `Exit code ${code}`,
+        });
       } else {
-        resolve({ stdout, stderr, timeMs });
+        resolve({ output, stderr: stderr.toString(), timeMs });
       }
     });
 
     proc.on("error", (err) => {
       clearTimeout(timeout);
       resolve({
-        stdout: "",
+        output: null,
         stderr: "",
         timeMs: 0,
         error: `Process error: ${err.message}`,
       });
     });
 
-    // Write input to stdin
+    // Write input to stdin (EPIPE if the binary exits without reading it)
+    proc.stdin.on("error", () => {});
     proc.stdin.write(input);
     proc.stdin.end();
   });
@@ -157,6 +296,8 @@ async function execute(
 export async function executeC(config: RunConfig): Promise<RunResult> {
   const { day, part, useSample, agentDir, coreDataDir } = config;
   const dayStr = day.toString().padStart(2, "0");
+  const mode = config.build ?? getCBuildMode();
+  const withStats = config.stats ?? getCStats();
 
   // Load input
   const inputDir = useSample
@@ -180,7 +321,7 @@ export async function executeC(config: RunConfig): Promise<RunResult> {
   // Paths
   const sourceDir = join(agentDir, "c", `day${dayStr}`);
   const sourcePath = join(sourceDir, `part${part}.c`);
-  const binaryPath = join(sourceDir, `part${part}${EXE_EXT}`);
+  const binaryPath = cBinaryPath(sourceDir, part, mode, withStats);
 
   // Check if source exists
   try {
@@ -195,13 +336,17 @@ export async function executeC(config: RunConfig): Promise<RunResult> {
   }
 
   // Compile
-  const compileError = await compile(sourcePath, binaryPath);
-  if (compileError) {
+  const compiled = await compileCSource(sourcePath, binaryPath, {
+    mode,
+    harnessDir: getHarnessDir(agentDir),
+    stats: withStats,
+  });
+  if ("error" in compiled) {
     return {
       answer: "",
       timeMs: 0,
       isCorrect: null,
-      error: compileError,
+      error: compiled.error,
     };
   }
 
@@ -218,12 +363,14 @@ export async function executeC(config: RunConfig): Promise<RunResult> {
   }
 
   // Parse standardized output
-  const parsed = parseCOutput(result.stdout, result.timeMs);
+  const parsed = parseCOutput(result.output!, result.timeMs);
 
   // Use internal timing if available, otherwise use external timing
   // Sum parse + solve times for accurate measurement
   const internalTimeMs = (parsed.parseTimeMs ?? 0) + (parsed.solveTimeMs ?? 0);
   const timeMs = internalTimeMs > 0 ? internalTimeMs : parsed.totalTimeMs;
+  const stats = result.output!.stats;
+  const extra = Object.keys(stats).length > 0 ? { stats } : {};
 
   if (parsed.error) {
     return {
@@ -231,6 +378,8 @@ export async function executeC(config: RunConfig): Promise<RunResult> {
       timeMs,
       isCorrect: null,
       error: parsed.error,
+      buildMode: compiled.mode,
+      ...extra,
     };
   }
 
@@ -238,9 +387,18 @@ export async function executeC(config: RunConfig): Promise<RunResult> {
     answer: parsed.answer,
     timeMs,
     isCorrect: null,
+    buildMode: compiled.mode,
+    ...extra,
   };
 }
 
+/**
+ * The agent's copy of core/runner/c (common.h, start.c, nolibc.h)
+ */
+export function getHarnessDir(agentDir: string): string {
+  return join(agentDir, "tools", "runner", "c");
+}
+
 /**
  * Pre-compile a C solution without executing it
  * Useful for benchmarks where we want to compile once and run many times
@@ -248,28 +406,32 @@ export async function executeC(config: RunConfig): Promise<RunResult> {
 export async function precompileC(
   agentDir: string,
   day: number,
-  part: 1 | 2
-): Promise<{ binaryPath: string } | { error: string }> {
+  part: 1 | 2,
+  mode: CBuildMode = getCBuildMode()
+): Promise<{ binaryPath: string; mode: CBuildMode } | { error: string }> {
   const dayStr = day.toString().padStart(2, "0");
   const sourceDir = join(agentDir, "c", `day${dayStr}`);
   const sourcePath = join(sourceDir, `part${part}.c`);
-  const binaryPath = join(sourceDir, `part${part}${EXE_EXT}`);
+  const binaryPath = cBinaryPath(sourceDir, part, mode);
 
-  const compileError = await compile(sourcePath, binaryPath);
-  if (compileError) {
-    return { error: compileError };
-  }
+  const compiled = await compileCSource(sourcePath, binaryPath, {
+    mode,
+    harnessDir: getHarnessDir(agentDir),
+  });
+  if ("error" in compiled) return compiled;
 
-  return { binaryPath };
+  return { binaryPath, mode: compiled.mode };
 }
 
 /**
  * Execute a pre-compiled binary and parse standardized output
- * Used for benchmarks
+ * Used for benchmarks (pinned to the lease's CPUs when given)
  */
 export async function executePrecompiled(
   binaryPath: string,
-  input: string
+  input: string,
+  onRecord?: (record: OutputRecord) => void,
+  lease?: CpuLease
 ): Promise<{
   answer: string;
   timeMs: number;
@@ -277,7 +439,7 @@ export async function executePrecompiled(
   solveTimeMs: number | undefined;
   error: string | undefined;
 }> {
-  const result = await execute(binaryPath, input);
+  const result = await execute(binaryPath, input, onRecord, lease);
 
   if (result.error) {
     return {
@@ -289,7 +451,7 @@ export async function executePrecompiled(
     };
   }
 
-  const parsed = parseCOutput(result.stdout, result.timeMs);
+  const parsed = parseCOutput(result.output!, result.timeMs);
 
   return {
     answer: parsed.answer,
@@ -5,6 +5,9 @@
 import { readFile } from "node:fs/promises";
 import { join } from "node:path";
 import { pathToFileURL } from "node:url";
+import { spawn } from "node:child_process";
+import { pinCommand } from "./scheduler.js";
+import type { CpuLease } from "./scheduler.js";
 import type { ISolver, RunResult, RunConfig } from "./types.js";
 
 export async function executeTs(config: RunConfig): Promise<RunResult> {
@@ -81,3 +84,77 @@ export async function executeTs(config: RunConfig): Promise<RunResult> {
     isCorrect: null, // Will be checked later
   };
 }
+
+/**
+ * Run a TS solver in a fresh process, timing only solve() like the
+ * dashboard benchmarks do (pinned to the lease's CPUs when given)
+ */
+export async function executeTsIsolated(
+  solverPath: string,
+  input: string,
+  lease?: CpuLease
+): Promise<{ answer: string; timeMs: number; error?: string }> {
+  const runnerCode = `
+(async () => {
+  const { pathToFileURL } = await import('url');
+  const { readFileSync } = await import('fs');
+  const solver = (await import(pathToFileURL(${JSON.stringify(
+    solverPath
+  )}).href)).solver;
+  const input = readFileSync(0, 'utf-8');
+  const start = process.hrtime.bigint();
+  const result = solver.solve(input);
+  const end = process.hrtime.bigint();
+  console.log(JSON.stringify({ answer: String(result), timeNs: Number(end - start) }));
+})();
+`;
+
+  return new Promise((resolvePromise) => {
+    // Reuse the current loader flags (tsx) so the child can import .ts
+    const { command, args } = pinCommand(lease, process.execPath, [
+      ...process.execArgv,
+      "-e",
+      runnerCode,
+    ]);
+    const proc = spawn(command, args, { stdio: ["pipe", "pipe", "pipe"] });
+
+    let stdout = "";
+    let stderr = "";
+    proc.stdout.on("data", (data) => {
+      stdout += data.toString();
+    });
+    proc.stderr.on("data", (data) => {
+      stderr += data.toString();
+    });
+
+    proc.on("close", (code) => {
+      if (code !== 0) {
+        resolvePromise({
+          answer: "",
+          timeMs: 0,
+          error: stderr || `Exit ${code}`,
+        });
+        return;
+      }
+      try {
+        const result = JSON.parse(stdout.trim()) as {
+          answer: string;
+          timeNs: number;
+        };
+        resolvePromise({
+          answer: result.answer,
+          timeMs: result.timeNs / 1_000_000,
+        });
+      } catch (e) {
+        resolvePromise({ answer: "", timeMs: 0, error: `Parse error: ${e}` });
+      }
+    });
+
+    proc.on("error", (err) => {
+      resolvePromise({ answer: "", timeMs: 0, error: err.message });
+    });
+
+    proc.stdin.write(input);
+    proc.stdin.end();
+  });
+}
@@ -6,3 +6,9 @@ export * from "./types.js";
 export * from "./executor-ts.js";
 export * from "./executor-c.js";
 export * from "./utils.js";
+export * from "./scheduler.js";
+export * from "./jobs.js";
+export * from "./output.js";
+export * from "./startup.js";
+export * from "./kernels.js";
+export * from "./bench.js";
@@ -0,0 +1,233 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Job Queue
+ *
+ * One queue for every solver execution launched by the dashboard:
+ *   - identical requests in flight share a single job (same kind + key)
+ *   - each kind has its own concurrency limit, extra jobs wait in FIFO
+ *   - finished jobs stay queryable in a bounded history
+ */
+
+export type JobStatus = "queued" | "running" | "done" | "failed";
+
+export interface JobProgress {
+  completed: number;
+  total: number;
+}
+
+export interface JobInfo {
+  id: number;
+  kind: string;
+  key: string;
+  status: JobStatus;
+  // Requests sharing this job (1 + deduplicated submissions)
+  subscribers: number;
+  progress: JobProgress | null;
+  // Epoch ms
+  createdAt: number;
+  startedAt: number | null;
+  finishedAt: number | null;
+  error?: string;
+}
+
+export interface JobContext {
+  progress(completed: number, total: number, detail?: unknown): void;
+}
+
+export type JobListener = (progress: JobProgress, detail?: unknown) => void;
+
+export interface Job<T> {
+  readonly info: JobInfo;
+  readonly promise: Promise<T>;
+  // Returns an unsubscribe function
+  onProgress(listener: JobListener): () => void;
+}
+
+export interface JobQueueOptions {
+  // Max jobs running at once per kind (kinds not listed are unlimited)
+  concurrency?: Record<string, number>;
+  // Finished jobs kept for status queries (default: 200)
+  historySize?: number;
+}
+
+class JobEntry<T> implements Job<T> {
+  promise!: Promise<T>;
+  private listeners = new Set<JobListener>();
+
+  constructor(readonly info: JobInfo) {}
+
+  onProgress(listener: JobListener): () => void {
+    this.listeners.add(listener);
+    return () => this.listeners.delete(listener);
+  }
+
+  emit(progress: JobProgress, detail?: unknown): void {
+    this.info.progress = progress;
+    for (const listener of this.listeners) listener(progress, detail);
+  }
+}
+
+export class JobQueue {
+  private nextId = 1;
+  private jobs = new Map<number, JobEntry<unknown>>();
+  private inFlight = new Map<string, JobEntry<unknown>>();
+  private running = new Map<string, number>();
+  private waiting = new Map<string, Array<() => void>>();
+  private readonly concurrency: Record<string, number>;
+  private readonly historySize: number;
+
+  constructor(options: JobQueueOptions = {}) {
+    this.concurrency = options.concurrency ?? {};
+    this.historySize = options.historySize ?? 200;
+  }
+
+  /**
+   * Queue a job, or join the identical one already queued/running
+   */
+  submit<T>(
+    kind: string,
+    key: string,
+    task: (context: JobContext) => Promise<T>
+  ): Job<T> {
+    const existing = this.inFlight.get(`${kind}:${key}`);
+    if (existing) {
+      existing.info.subscribers++;
+      return existing as JobEntry<T>;
+    }
+
+    const job = new JobEntry<T>({
+      id: this.nextId++,
+      kind,
+      key,
+      status: "queued",
+      subscribers: 1,
+      progress: null,
+      createdAt: Date.now(),
+      startedAt: null,
+      finishedAt: null,
+    });
+
+    this.jobs.set(job.info.id, job as JobEntry<unknown>);
+    this.inFlight.set(`${kind}:${key}`, job as JobEntry<unknown>);
+    job.promise = this.execute(job, task);
+    // Failures are reported through the promise and the job status
+    job.promise.catch(() => {});
+
+    return job;
+  }
+
+  get(id: number): JobInfo | undefined {
+    return this.jobs.get(id)?.info;
+  }
+
+  /**
+   * Newest first
+   */
+  list(): JobInfo[] {
+    return [...this.jobs.values()].map((job) => job.info).reverse();
+  }
+
+  status(): Record<JobStatus, number> {
+    const counts = { queued: 0, running: 0, done: 0, failed: 0 };
+    for (const job of this.jobs.values()) counts[job.info.status]++;
+    return counts;
+  }
+
+  private async execute<T>(
+    job: JobEntry<T>,
+    task: (context: JobContext) => Promise<T>
+  ): Promise<T> {
+    const { kind } = job.info;
+    await this.acquire(kind);
+
+    job.info.status = "running";
+    job.info.startedAt = Date.now();
+
+    try {
+      const result = await task({
+        progress: (completed, total, detail) =>
+          job.emit({ completed, total }, detail),
+      });
+      job.info.status = "done";
+      return result;
+    } catch (e) {
+      job.info.status = "failed";
+      job.info.error = e instanceof Error ? e.message : String(e);
+      throw e;
+    } finally {
+      job.info.finishedAt = Date.now();
+      this.inFlight.delete(`${kind}:${job.info.key}`);
+      this.release(kind);
+      this.trimHistory();
+    }
+  }
+
+  private acquire(kind: string): Promise<void> {
+    const limit = this.concurrency[kind] ?? Infinity;
+    const running = this.running.get(kind) ?? 0;
+
+    if (running < limit) {
+      this.running.set(kind, running + 1);
+      return Promise.resolve();
+    }
+
+    return new Promise((resolve) => {
+      const queue = this.waiting.get(kind) ?? [];
+      queue.push(resolve);
+      this.waiting.set(kind, queue);
+    });
+  }
+
+  // The slot goes straight to the next waiter of the same kind
+  private release(kind: string): void {
+    const next = this.waiting.get(kind)?.shift();
+    if (next) {
+      next();
+    } else {
+      this.running.set(kind, (this.running.get(kind) ?? 1) - 1);
+    }
+  }
+
+  private trimHistory(): void {
+    let excess = this.jobs.size - this.historySize;
+    for (const [id, job] of this.jobs) {
+      if (excess <= 0) break;
+      if (job.info.finishedAt === null) continue;
+      this.jobs.delete(id);
+      excess--;
+    }
+  }
+}
+
+/**
+ * Small LRU map, used to remember verified answers
+ */
+export class ResultCache<T> {
+  private entries = new Map<string, T>();
+
+  constructor(readonly maxEntries = 1000) {}
+
+  get size(): number {
+    return this.entries.size;
+  }
+
+  get(key: string): T | undefined {
+    const value = this.entries.get(key);
+    if (value === undefined) return undefined;
+    // Move to the most recent end
+    this.entries.delete(key);
+    this.entries.set(key, value);
+    return value;
+  }
+
+  set(key: string, value: T): void {
+    this.entries.delete(key);
+    this.entries.set(key, value);
+    if (this.entries.size > this.maxEntries) {
+      this.entries.delete(this.entries.keys().next().value!);
+    }
+  }
+
+  delete(key: string): void {
+    this.entries.delete(key);
+  }
+}
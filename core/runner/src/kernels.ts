@@ -0,0 +1,100 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Kernel Shootouts
+ *
+ * Compile et lance un microbenchmark c/kernel.h : plusieurs implémentations
+ * du même noyau (d'un ou plusieurs agents) mesurées sur le même input,
+ * réponses vérifiées contre la première. Les résultats (KERNEL:) sont lus
+ * par le même OutputParser que les solvers, puis stockés dans la base du
+ * dashboard (tables kernel_runs / kernel_results) par `aoc kernels` ou
+ * POST /api/kernels, qui prend la sortie de `aoc kernels --json`.
+ */
+
+import { join, dirname, basename } from "node:path";
+import { spawn } from "node:child_process";
+import { compileCSource } from "./executor-c.js";
+import { OutputParser, CappedText } from "./output.js";
+import type { KernelStats } from "./output.js";
+import type { CBuildMode } from "./types.js";
+
+export interface KernelBenchOptions {
+  // Directory holding kernel.h / common.h (the agent's tools/runner/c)
+  harnessDir: string;
+  mode?: CBuildMode;
+  // Overrides AOC_KERNEL_SAMPLES / AOC_KERNEL_SAMPLE_MS
+  samples?: number;
+  sampleMs?: number;
+}
+
+export interface KernelBenchResult {
+  kernels: KernelStats[];
+  // Answer of the reference (first) kernel
+  answer: string | null;
+  // Every kernel agrees with the reference
+  ok: boolean;
+  // Build that actually ran (static may fall back to dynamic)
+  buildMode?: CBuildMode;
+  error?: string;
+}
+
+/**
+ * Compile a kernel benchmark (next to its source) and run it on `input`
+ */
+export async function runKernelBench(
+  sourcePath: string,
+  input: string,
+  options: KernelBenchOptions
+): Promise<KernelBenchResult> {
+  const binaryPath = join(
+    dirname(sourcePath),
+    basename(sourcePath, ".c") + (process.platform === "win32" ? ".exe" : "")
+  );
+
+  const compiled = await compileCSource(sourcePath, binaryPath, {
+    harnessDir: options.harnessDir,
+    ...(options.mode ? { mode: options.mode } : {}),
+  });
+  if ("error" in compiled) {
+    return { kernels: [], answer: null, ok: false, error: compiled.error };
+  }
+
+  const env: NodeJS.ProcessEnv = { ...process.env };
+  if (options.samples) env.AOC_KERNEL_SAMPLES = String(options.samples);
+  if (options.sampleMs) env.AOC_KERNEL_SAMPLE_MS = String(options.sampleMs);
+
+  return new Promise((resolve) => {
+    const proc = spawn(binaryPath, [], { env });
+    const stdout = new OutputParser();
+    const stderr = new CappedText();
+
+    proc.stdout.on("data", (data: Buffer) => stdout.write(data));
+    proc.stderr.on("data", (data: Buffer) => stderr.write(data));
+
+    proc.on("close", (code) => {
+      const output = stdout.end();
+      const result: KernelBenchResult = {
+        kernels: output.kernels,
+        answer: output.answer,
+        ok: output.kernels.length > 0 && output.kernels.every((k) => k.ok),
+        buildMode: compiled.mode,
+      };
+
+      // Exit code 1 with results is an answer mismatch, not a crash
+      if (output.error) {
+        result.error = output.error;
+      } else if (output.kernels.length === 0) {
+        result.error = `No kernel results (exit code ${code})\n${stderr}`;
+      } else if (code !== 0 && result.ok) {
+        result.error = `Exit code ${code}\n${stderr}`;
+      }
+      resolve(result);
+    });
+
+    proc.on("error", (err) => {
+      resolve({ kernels: [], answer: null, ok: false, error: err.message });
+    });
+
+    proc.stdin.on("error", () => {});
+    proc.stdin.write(input);
+    proc.stdin.end();
+  });
+}
@@ -0,0 +1,358 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Solver Output Parser
+ *
+ * Incremental parser for the standardized C output, fed with stdout chunks
+ * as they arrive:
+ *   TIME:name:ms      timing (repeats once per iteration for in-process loops)
+ *   PERF:name:value   numeric metric
+ *   ANSWER:value
+ *   ERROR:message
+ *   KERNEL:name:iters=..,median_ns=..,...,ok=1,answer=..  (c/kernel.h)
+ *   STAT:name:count=..[,sum=..,min=..,max=..,hist=..]   (AOC_STATS builds)
+ * Any other line is kept as text within a fixed budget, so a chatty solver
+ * cannot grow the runner's memory.
+ */
+
+export type OutputRecord =
+  | { type: "time"; name: string; ms: number }
+  | { type: "perf"; name: string; value: number }
+  | { type: "answer"; value: string }
+  | { type: "error"; message: string }
+  | { type: "kernel"; kernel: KernelStats }
+  | { type: "stat"; name: string; stat: SolverStat }
+  | { type: "text"; line: string };
+
+/**
+ * One kernel of a c/kernel.h microbenchmark, times per call
+ */
+export interface KernelStats {
+  name: string;
+  iterations: number;
+  samples: number;
+  minNs: number;
+  medianNs: number;
+  meanNs: number;
+  maxNs: number;
+  stdDevNs: number;
+  // Same answer as the first (reference) kernel
+  ok: boolean;
+  answer: string;
+}
+
+/**
+ * Work counter of an AOC_STATS build (AOC_COUNT / AOC_HIST in common.h)
+ */
+export interface SolverStat {
+  count: number;
+  // AOC_HIST only
+  sum?: number;
+  min?: number;
+  max?: number;
+  // Power-of-two bucket lower bound -> values in [bound, 2 * bound)
+  hist?: Record<string, number>;
+}
+
+export interface OutputParserOptions {
+  // Free text kept, in bytes (default: 64 KiB)
+  maxTextBytes?: number;
+  // Longer lines are cut (default: 64 KiB)
+  maxLineBytes?: number;
+  // Called for each record as soon as its line is complete
+  onRecord?: (record: OutputRecord) => void;
+}
+
+export interface ParsedOutput {
+  answer: string | null;
+  error: string | null;
+  // Last value of each timer / metric
+  times: Record<string, number>;
+  perf: Record<string, number>;
+  // TIME: records seen per timer
+  timeCounts: Record<string, number>;
+  kernels: KernelStats[];
+  // STAT: records by name (last one wins)
+  stats: Record<string, SolverStat>;
+  text: string;
+  // Some text or part of a line was dropped
+  truncated: boolean;
+}
+
+export const DEFAULT_MAX_OUTPUT_BYTES = 64 * 1024;
+
+// Same as AOC_KERNEL_MAX in c/kernel.h
+const MAX_KERNELS = 64;
+// Same as AOC_STAT_MAX in c/common.h
+const MAX_STATS = 64;
+
+const NEWLINE = 0x0a;
+
+/**
+ * Parse "name:number" (TIME: / PERF: payload), null when malformed
+ */
+function parseNamedValue(
+  payload: string
+): { name: string; value: number } | null {
+  const sep = payload.indexOf(":");
+  if (sep <= 0) return null;
+  const value = parseFloat(payload.substring(sep + 1));
+  return isNaN(value) ? null : { name: payload.substring(0, sep), value };
+}
+
+/**
+ * Parse "name:key=value,...,answer=value" (KERNEL: payload). The answer
+ * comes last and runs to the end of the line.
+ */
+function parseKernel(payload: string): KernelStats | null {
+  const sep = payload.indexOf(":");
+  const answerAt = payload.indexOf(",answer=");
+  if (sep <= 0 || answerAt < sep) return null;
+
+  const fields: Record<string, number> = {};
+  for (const field of payload.substring(sep + 1, answerAt).split(",")) {
+    const [key, value] = field.split("=");
+    if (key && value !== undefined) fields[key] = parseFloat(value);
+  }
+
+  const stats = {
+    iterations: fields.iters,
+    samples: fields.samples,
+    minNs: fields.min_ns,
+    medianNs: fields.median_ns,
+    meanNs: fields.mean_ns,
+    maxNs: fields.max_ns,
+    stdDevNs: fields.stddev_ns,
+  };
+  if (Object.values(stats).some((v) => v === undefined || isNaN(v))) {
+    return null;
+  }
+
+  return {
+    name: payload.substring(0, sep),
+    ...(stats as Record<keyof typeof stats, number>),
+    ok: fields.ok === 1,
+    answer: payload.substring(answerAt + 8),
+  };
+}
+
+/**
+ * Parse "name:count=..,sum=..,min=..,max=..,hist=0:3;1:5" (STAT: payload)
+ */
+function parseStat(
+  payload: string
+): { name: string; stat: SolverStat } | null {
+  const sep = payload.indexOf(":");
+  if (sep <= 0) return null;
+
+  const stat: SolverStat = { count: NaN };
+  for (const field of payload.substring(sep + 1).split(",")) {
+    const [key, value] = field.split("=");
+    if (value === undefined) return null;
+
+    if (key === "hist") {
+      stat.hist = {};
+      for (const bucket of value.split(";")) {
+        const [bound, count] = bucket.split(":");
+        if (bound && count !== undefined) stat.hist[bound] = Number(count);
+      }
+    } else if (
+      key === "count" ||
+      key === "sum" ||
+      key === "min" ||
+      key === "max"
+    ) {
+      stat[key] = Number(value);
+    }
+  }
+
+  return isNaN(stat.count) ? null : { name: payload.substring(0, sep), stat };
+}
+
+/**
+ * Back to the STAT: line a solver prints (the CLI echoes them)
+ */
+export function formatStatLine(name: string, stat: SolverStat): string {
+  const fields = [`count=${stat.count}`];
+  for (const key of ["sum", "min", "max"] as const) {
+    if (stat[key] !== undefined) fields.push(`${key}=${stat[key]}`);
+  }
+  if (stat.hist) {
+    const buckets = Object.entries(stat.hist)
+      .map(([bound, count]) => `${bound}:${count}`)
+      .join(";");
+    fields.push(`hist=${buckets}`);
+  }
+  return `STAT:${name}:${fields.join(",")}`;
+}
+
+export function parseOutputLine(line: string): OutputRecord {
+  if (line.startsWith("TIME:")) {
+    const parsed = parseNamedValue(line.substring(5));
+    if (parsed) return { type: "time", name: parsed.name, ms: parsed.value };
+  } else if (line.startsWith("PERF:")) {
+    const parsed = parseNamedValue(line.substring(5));
+    if (parsed) return { type: "perf", ...parsed };
+  } else if (line.startsWith("ANSWER:")) {
+    return { type: "answer", value: line.substring(7) };
+  } else if (line.startsWith("ERROR:")) {
+    return { type: "error", message: line.substring(6) };
+  } else if (line.startsWith("KERNEL:")) {
+    const kernel = parseKernel(line.substring(7));
+    if (kernel) return { type: "kernel", kernel };
+  } else if (line.startsWith("STAT:")) {
+    const parsed = parseStat(line.substring(5));
+    if (parsed) return { type: "stat", ...parsed };
+  }
+  return { type: "text", line };
+}
+
+export class OutputParser {
+  private readonly maxTextBytes: number;
+  private readonly maxLineBytes: number;
+  private readonly onRecord: ((record: OutputRecord) => void) | undefined;
+
+  // Current incomplete line
+  private pending: Buffer[] = [];
+  private pendingBytes = 0;
+
+  private textParts: string[] = [];
+  private textBytes = 0;
+  private output: ParsedOutput = {
+    answer: null,
+    error: null,
+    times: {},
+    perf: {},
+    timeCounts: {},
+    kernels: [],
+    stats: {},
+    text: "",
+    truncated: false,
+  };
+
+  constructor(options: OutputParserOptions = {}) {
+    this.maxTextBytes = options.maxTextBytes ?? DEFAULT_MAX_OUTPUT_BYTES;
+    this.maxLineBytes = options.maxLineBytes ?? DEFAULT_MAX_OUTPUT_BYTES;
+    this.onRecord = options.onRecord;
+  }
+
+  write(chunk: Buffer | string): void {
+    const buffer = typeof chunk === "string" ? Buffer.from(chunk) : chunk;
+    let start = 0;
+
+    while (start < buffer.length) {
+      const newline = buffer.indexOf(NEWLINE, start);
+      const end = newline === -1 ? buffer.length : newline;
+      this.append(buffer.subarray(start, end));
+      if (newline === -1) break;
+      this.flushLine();
+      start = newline + 1;
+    }
+  }
+
+  /**
+   * Flush the last unterminated line and return the result
+   */
+  end(): ParsedOutput {
+    if (this.pendingBytes > 0) this.flushLine();
+    this.output.text = this.textParts.join("");
+    return this.output;
+  }
+
+  private append(segment: Buffer): void {
+    const room = this.maxLineBytes - this.pendingBytes;
+    if (segment.length > room) {
+      this.output.truncated = true;
+      segment = segment.subarray(0, Math.max(0, room));
+    }
+    if (segment.length === 0) return;
+    // Copy: the chunk itself must not be retained
+    this.pending.push(Buffer.from(segment));
+    this.pendingBytes += segment.length;
+  }
+
+  private flushLine(): void {
+    const bytes = Buffer.concat(this.pending, this.pendingBytes);
+    let line = bytes.toString("utf-8");
+    this.pending = [];
+    this.pendingBytes = 0;
+    if (line.endsWith("\r")) line = line.slice(0, -1);
+
+    const record = parseOutputLine(line);
+    const output = this.output;
+
+    switch (record.type) {
+      case "time":
+        output.times[record.name] = record.ms;
+        output.timeCounts[record.name] =
+          (output.timeCounts[record.name] ?? 0) + 1;
+        break;
+      case "perf":
+        output.perf[record.name] = record.value;
+        break;
+      case "answer":
+        output.answer = record.value;
+        break;
+      case "error":
+        output.error = record.message;
+        break;
+      case "kernel":
+        if (output.kernels.length < MAX_KERNELS) {
+          output.kernels.push(record.kernel);
+        } else {
+          output.truncated = true;
+        }
+        break;
+      case "stat":
+        if (
+          record.name in output.stats ||
+          Object.keys(output.stats).length < MAX_STATS
+        ) {
+          output.stats[record.name] = record.stat;
+        } else {
+          output.truncated = true;
+        }
+        break;
+      case "text":
+        this.keepText(line);
+        break;
+    }
+
+    this.onRecord?.(record);
+  }
+
+  private keepText(line: string): void {
+    const bytes = Buffer.byteLength(line) + 1;
+    if (this.textBytes + bytes > this.maxTextBytes) {
+      this.output.truncated = true;
+      return;
+    }
+    this.textParts.push(`${line}\n`);
+    this.textBytes += bytes;
+  }
+}
+
+/**
+ * Keeps the beginning of a stream (stderr, compiler output) up to a budget
+ */
+export class CappedText {
+  private parts: Buffer[] = [];
+  private bytes = 0;
+  truncated = false;
+
+  constructor(readonly maxBytes = DEFAULT_MAX_OUTPUT_BYTES) {}
+
+  write(chunk: Buffer | string): void {
+    const buffer = typeof chunk === "string" ? Buffer.from(chunk) : chunk;
+    const room = this.maxBytes - this.bytes;
+    if (buffer.length > room) this.truncated = true;
+    if (room <= 0) return;
+
+    const kept = buffer.subarray(0, room);
+    this.parts.push(Buffer.from(kept));
+    this.bytes += kept.length;
+  }
+
+  toString(): string {
+    const text = Buffer.concat(this.parts, this.bytes).toString("utf-8");
+    return this.truncated ? `${text}\n[output truncated]` : text;
+  }
+}
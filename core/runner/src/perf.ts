@@ -0,0 +1,120 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Perf Check
+ *
+ * Mesure N runs d'un solver et les compare aux dernières sessions de
+ * benchmark enregistrées par le dashboard (test de Mann-Whitney U).
+ * Même métrique que les benchmarks : parse + solve pour C, solve() dans
+ * un process neuf pour TS.
+ */
+
+import { readFile } from "node:fs/promises";
+import { existsSync } from "node:fs";
+import { join, resolve } from "node:path";
+import { AocDatabase, compareToBaseline } from "@aoc25/db";
+import type { RegressionResult } from "@aoc25/db";
+import {
+  precompileC,
+  executePrecompiled,
+  getCBuildMode,
+} from "./executor-c.js";
+import { executeTsIsolated } from "./executor-ts.js";
+import type { Agent, RunConfig } from "./types.js";
+
+export const DEFAULT_PERF_RUNS = 20;
+
+export interface PerfCheckResult {
+  samples: number[];
+  regression: RegressionResult;
+  error?: string;
+}
+
+/**
+ * Chemin de la DB du dashboard (surchargeable via AOC_DB_PATH)
+ */
+export function getDashboardDbPath(agentDir: string): string {
+  return getRootDbPath(resolve(agentDir, "..", ".."));
+}
+
+/**
+ * Même chose depuis la racine du repo (aoc bench)
+ */
+export function getRootDbPath(rootDir: string): string {
+  if (process.env.AOC_DB_PATH) return process.env.AOC_DB_PATH;
+  return join(rootDir, "core", "dashboard", "data", "aoc25.db");
+}
+
+/**
+ * Collecte `runs` mesures sur l'input final
+ */
+export async function collectSamples(
+  config: RunConfig,
+  runs: number
+): Promise<{ samples: number[]; error?: string }> {
+  const { day, part, lang, agentDir, coreDataDir } = config;
+  const dayStr = day.toString().padStart(2, "0");
+
+  let input: string;
+  try {
+    input = await readFile(join(coreDataDir, "input.txt"), "utf-8");
+  } catch {
+    return { samples: [], error: `Failed to read input: ${coreDataDir}` };
+  }
+
+  const samples: number[] = [];
+
+  if (lang === "c") {
+    const compiled = await precompileC(agentDir, day, part, config.build);
+    if ("error" in compiled) return { samples, error: compiled.error };
+
+    for (let i = 0; i < runs; i++) {
+      const result = await executePrecompiled(compiled.binaryPath, input);
+      if (result.error) return { samples, error: result.error };
+      const internal = (result.parseTimeMs ?? 0) + (result.solveTimeMs ?? 0);
+      samples.push(internal > 0 ? internal : result.timeMs);
+    }
+  } else {
+    const solverPath = join(agentDir, "ts", `day${dayStr}`, `part${part}.ts`);
+    for (let i = 0; i < runs; i++) {
+      const result = await executeTsIsolated(solverPath, input);
+      if (result.error) return { samples, error: result.error };
+      samples.push(result.timeMs);
+    }
+  }
+
+  return { samples };
+}
+
+/**
+ * Mesure le solver et le compare aux sessions précédentes du dashboard.
+ * Retourne null si aucune DB n'est disponible.
+ */
+export async function checkPerf(
+  config: RunConfig,
+  agent: Agent,
+  runs = DEFAULT_PERF_RUNS
+): Promise<PerfCheckResult | null> {
+  const dbPath = getDashboardDbPath(config.agentDir);
+  if (!existsSync(dbPath)) return null;
+
+  const db = new AocDatabase(dbPath, { readonly: true });
+  let baseline: number[];
+  try {
+    baseline = db.getBaselineSamples({
+      agent,
+      day: config.day,
+      part: config.part,
+      language: config.lang,
+      // Only sessions of the same C build mode are comparable
+      ...(config.lang === "c" && {
+        build_mode: config.build ?? getCBuildMode(),
+      }),
+    });
+  } finally {
+    db.close();
+  }
+
+  const { samples, error } = await collectSamples(config, runs);
+  const regression = compareToBaseline(baseline, samples);
+
+  return error ? { samples, regression, error } : { samples, regression };
+}
@@ -0,0 +1,261 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Core Scheduler
+ *
+ * Places benchmark tasks on CPU cores so that concurrent runs don't steal
+ * cycles from each other:
+ *   - isolated   : one task per physical core, SMT siblings left idle
+ *   - throughput : one task per logical CPU (faster sweeps, noisier)
+ * Tasks beyond the free capacity wait in a FIFO queue.
+ *
+ * A lease is pinned with taskset, and the parallel C solvers size their
+ * thread pool from the CPUs they may run on (sched_getaffinity): on a
+ * one-core lease they fall back to a single worker. Such solvers ask for
+ * several cores (solverCores) and get that many whole cores in isolated
+ * mode, or logical CPUs in throughput mode, capped at the capacity.
+ */
+
+import { readFileSync, existsSync } from "node:fs";
+import { join } from "node:path";
+import { cpus } from "node:os";
+
+export type SchedulerMode = "isolated" | "throughput";
+
+export const SYS_CPU_DIR = "/sys/devices/system/cpu";
+
+export interface PhysicalCore {
+  // Logical CPUs sharing the core (SMT siblings), sorted
+  cpus: number[];
+}
+
+export interface CpuLease {
+  mode: SchedulerMode;
+  // Logical CPUs the task may run on
+  cpus: number[];
+}
+
+export interface CoreSchedulerOptions {
+  // Defaults to detectCpuTopology()
+  cores?: PhysicalCore[];
+  // Cores left to the server and the OS (default: 1 when there are several)
+  reserveCores?: number;
+}
+
+/**
+ * Parse a sysfs CPU list ("0-3,8,10-11")
+ */
+export function parseCpuList(list: string): number[] {
+  const result: number[] = [];
+
+  for (const chunk of list.trim().split(",")) {
+    if (!chunk) continue;
+    const [start, end] = chunk.split("-").map((n) => parseInt(n, 10));
+    if (start === undefined || isNaN(start)) continue;
+    const last = end === undefined || isNaN(end) ? start : end;
+    for (let cpu = start; cpu <= last; cpu++) result.push(cpu);
+  }
+
+  return result;
+}
+
+/**
+ * CPUs this process is allowed to run on (cgroup cpuset / taskset),
+ * or null when unknown
+ */
+export function readAllowedCpus(
+  statusPath = "/proc/self/status"
+): number[] | null {
+  try {
+    const status = readFileSync(statusPath, "utf-8");
+    const match = status.match(/^Cpus_allowed_list:\s*(.+)$/m);
+    return match ? parseCpuList(match[1]!) : null;
+  } catch {
+    return null;
+  }
+}
+
+/**
+ * Group online CPUs by physical core using sysfs. Without sysfs (macOS,
+ * Windows), every logical CPU is treated as its own core.
+ */
+export function detectCpuTopology(
+  sysDir = SYS_CPU_DIR,
+  allowed: number[] | null = readAllowedCpus()
+): PhysicalCore[] {
+  const onlinePath = join(sysDir, "online");
+  if (!existsSync(onlinePath)) {
+    return cpus().map((_, cpu) => ({ cpus: [cpu] }));
+  }
+
+  const online = new Set(parseCpuList(readFileSync(onlinePath, "utf-8")));
+  if (allowed) {
+    const allowedSet = new Set(allowed);
+    for (const cpu of online) {
+      if (!allowedSet.has(cpu)) online.delete(cpu);
+    }
+  }
+
+  const cores = new Map<string, PhysicalCore>();
+
+  for (const cpu of [...online].sort((a, b) => a - b)) {
+    const topology = join(sysDir, `cpu${cpu}`, "topology");
+    // core_cpus_list replaces thread_siblings_list on recent kernels
+    const siblingsPath = existsSync(join(topology, "core_cpus_list"))
+      ? join(topology, "core_cpus_list")
+      : join(topology, "thread_siblings_list");
+
+    let siblings = [cpu];
+    try {
+      siblings = parseCpuList(readFileSync(siblingsPath, "utf-8")).filter(
+        (c) => online.has(c)
+      );
+    } catch {
+      // No topology info: standalone core
+    }
+
+    const key = siblings.join(",");
+    if (!cores.has(key)) cores.set(key, { cpus: siblings });
+  }
+
+  return [...cores.values()];
+}
+
+/**
+ * Cores a solver should be leased: every core the scheduler has for C
+ * sources that start threads, one otherwise (capped by acquire)
+ */
+export function solverCores(source: string): number {
+  return /\bpthread_create\s*\(/.test(source) ? Infinity : 1;
+}
+
+let tasksetAvailable: boolean | null = null;
+
+/**
+ * Wrap a command so it only runs on the leased CPUs (Linux + taskset).
+ * Elsewhere the command is returned unchanged.
+ */
+export function pinCommand(
+  lease: CpuLease | undefined,
+  command: string,
+  args: string[]
+): { command: string; args: string[] } {
+  if (tasksetAvailable === null) {
+    tasksetAvailable =
+      process.platform === "linux" &&
+      (existsSync("/usr/bin/taskset") || existsSync("/bin/taskset"));
+  }
+
+  if (!lease || !tasksetAvailable) return { command, args };
+
+  return {
+    command: "taskset",
+    args: ["-c", lease.cpus.join(","), command, ...args],
+  };
+}
+
+interface Waiter {
+  mode: SchedulerMode;
+  cores: number;
+  resolve: (lease: CpuLease) => void;
+}
+
+export class CoreScheduler {
+  readonly cores: PhysicalCore[];
+  private busy = new Set<number>();
+  private queue: Waiter[] = [];
+
+  constructor(options: CoreSchedulerOptions = {}) {
+    const all = options.cores ?? detectCpuTopology();
+    const reserve = options.reserveCores ?? (all.length > 1 ? 1 : 0);
+    // Always keep at least one core to run on
+    this.cores = all.slice(Math.min(reserve, Math.max(0, all.length - 1)));
+  }
+
+  /**
+   * Number of tasks that can run at the same time in a given mode
+   */
+  capacity(mode: SchedulerMode): number {
+    return mode === "isolated"
+      ? this.cores.length
+      : this.cores.reduce((sum, core) => sum + core.cpus.length, 0);
+  }
+
+  status(): { busyCpus: number[]; queued: number } {
+    return {
+      busyCpus: [...this.busy].sort((a, b) => a - b),
+      queued: this.queue.length,
+    };
+  }
+
+  /**
+   * Lease `cores` physical cores (isolated) or logical CPUs (throughput),
+   * at most the mode's capacity so that the request can always be served
+   */
+  acquire(mode: SchedulerMode, cores = 1): Promise<CpuLease> {
+    const count = Math.max(1, Math.min(cores, this.capacity(mode)));
+
+    if (this.queue.length === 0) {
+      const lease = this.tryLease(mode, count);
+      if (lease) return Promise.resolve(lease);
+    }
+
+    return new Promise((resolve) => {
+      this.queue.push({ mode, cores: count, resolve });
+    });
+  }
+
+  release(lease: CpuLease): void {
+    for (const cpu of lease.cpus) this.busy.delete(cpu);
+    this.drain();
+  }
+
+  /**
+   * Run a task on its own core(s), waiting for them to free up if needed
+   */
+  async run<T>(
+    mode: SchedulerMode,
+    task: (lease: CpuLease) => Promise<T>,
+    cores = 1
+  ): Promise<T> {
+    const lease = await this.acquire(mode, cores);
+    try {
+      return await task(lease);
+    } finally {
+      this.release(lease);
+    }
+  }
+
+  private tryLease(mode: SchedulerMode, cores: number): CpuLease | null {
+    const idleCores = this.cores.filter((core) =>
+      core.cpus.every((cpu) => !this.busy.has(cpu))
+    );
+
+    let leased: number[];
+
+    if (mode === "isolated") {
+      // Whole cores, so no other task lands on an SMT sibling
+      if (idleCores.length < cores) return null;
+      leased = idleCores.slice(0, cores).flatMap((core) => core.cpus);
+    } else {
+      // Spread over idle cores first, then fill the siblings
+      const spread = idleCores.map((core) => core.cpus[0]!);
+      const siblings = this.cores
+        .flatMap((core) => core.cpus)
+        .filter((c) => !this.busy.has(c) && !spread.includes(c));
+      leased = [...spread, ...siblings].slice(0, cores);
+      if (leased.length < cores) return null;
+    }
+
+    for (const cpu of leased) this.busy.add(cpu);
+    return { mode, cpus: leased.sort((a, b) => a - b) };
+  }
+
+  // Strict FIFO: a waiting isolated task is not overtaken by smaller ones
+  private drain(): void {
+    while (this.queue.length > 0) {
+      const { mode, cores } = this.queue[0]!;
+      const lease = this.tryLease(mode, cores);
+      if (!lease) return;
+      this.queue.shift()!.resolve(lease);
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/**
+ * 🏆 AoC 2025 Battle Royale - Startup Cost
+ *
+ * Mesure le coût de démarrage d'un solver C vide (c/startup.c) dans chaque
+ * mode de build, avec c/startup-bench.c qui le lance via posix_spawn :
+ *   - exec → main : loader dynamique + init de la libc
+ *   - exec → exit : process complet, jusqu'au waitpid
+ * Les benchmarks C chronomètrent parse + solve en interne, ce coût n'y
+ * apparaît pas ; il pèse sur le temps externe (solvers sans TIME:).
+ */
+
+import { mkdtemp, rm } from "node:fs/promises";
+import { join } from "node:path";
+import { tmpdir } from "node:os";
+import { spawn } from "node:child_process";
+import { C_BUILD_MODES, compileCSource } from "./executor-c.js";
+import { OutputParser, CappedText } from "./output.js";
+import type { ParsedOutput } from "./output.js";
+import type { CBuildMode } from "./types.js";
+
+export const DEFAULT_STARTUP_RUNS = 200;
+
+export interface StartupCost {
+  mode: CBuildMode;
+  // Medians and minimums over the runs, in µs
+  execToMainUs: number;
+  execToMainMinUs: number;
+  execToExitUs: number;
+  execToExitMinUs: number;
+  error?: string;
+}
+
+function runLauncher(
+  launcher: string,
+  binary: string,
+  runs: number
+): Promise<{ output: ParsedOutput; error?: string }> {
+  return new Promise((resolve) => {
+    const proc = spawn(launcher, [binary, String(runs)]);
+    const stdout = new OutputParser();
+    const stderr = new CappedText();
+
+    proc.stdout.on("data", (data: Buffer) => stdout.write(data));
+    proc.stderr.on("data", (data: Buffer) => stderr.write(data));
+
+    proc.on("close", (code) => {
+      const output = stdout.end();
+      const error =
+        output.error ?? (code !== 0 ? `Exit code ${code}\n${stderr}` : null);
+      resolve(error ? { output, error } : { output });
+    });
+
+    proc.on("error", (err) => {
+      resolve({ output: stdout.end(), error: err.message });
+    });
+  });
+}
+
+/**
+ * Build the empty solver in each mode and measure its startup cost.
+ * `harnessDir` is a copy of core/runner/c (the agent's tools/runner/c).
+ */
+export async function measureStartup(
+  harnessDir: string,
+  runs = DEFAULT_STARTUP_RUNS,
+  modes: readonly CBuildMode[] = C_BUILD_MODES
+): Promise<StartupCost[]> {
+  const workDir = await mkdtemp(join(tmpdir(), "aoc-startup-"));
+  const failed = (mode: CBuildMode, error: string): StartupCost => ({
+    mode,
+    execToMainUs: 0,
+    execToMainMinUs: 0,
+    execToExitUs: 0,
+    execToExitMinUs: 0,
+    error,
+  });
+
+  try {
+    const launcher = join(workDir, "startup-bench");
+    const built = await compileCSource(
+      join(harnessDir, "startup-bench.c"),
+      launcher,
+      { mode: "dynamic", harnessDir }
+    );
+    if ("error" in built) {
+      return modes.map((mode) => failed(mode, built.error));
+    }
+
+    const results: StartupCost[] = [];
+
+    for (const mode of modes) {
+      const binary = join(workDir, `startup.${mode}`);
+      const compiled = await compileCSource(
+        join(harnessDir, "startup.c"),
+        binary,
+        { mode, harnessDir }
+      );
+      if ("error" in compiled) {
+        results.push(failed(mode, compiled.error));
+        continue;
+      }
+      if (compiled.mode !== mode) {
+        results.push(failed(mode, `Built as ${compiled.mode}`));
+        continue;
+      }
+
+      const { output, error } = await runLauncher(launcher, binary, runs);
+      if (error) {
+        results.push(failed(mode, error));
+        continue;
+      }
+
+      results.push({
+        mode,
+        execToMainUs: output.perf.exec_to_main_us ?? 0,
+        execToMainMinUs: output.perf.exec_to_main_min_us ?? 0,
+        execToExitUs: output.perf.exec_to_exit_us ?? 0,
+        execToExitMinUs: output.perf.exec_to_exit_min_us ?? 0,
+      });
+    }
+
+    return results;
+  } finally {
+    await rm(workDir, { recursive: true, force: true });
+  }
+}
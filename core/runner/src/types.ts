@@ -2,6 +2,8 @@
  * 🏆 AoC 2025 Battle Royale - Runner Types
  */
 
+import type { SolverStat } from "./output.js";
+
 export interface ISolver {
   solve(input: string): string;
 }
@@ -11,6 +13,10 @@ export interface RunResult {
   timeMs: number;
   isCorrect: boolean | null; // null = pas encore vérifié
   error?: string;
+  // C only: build mode actually used (nostart falls back to static)
+  buildMode?: CBuildMode;
+  // C only: AOC_COUNT / AOC_HIST counters of an AOC_STATS build
+  stats?: Record<string, SolverStat>;
 }
 
 export interface RunConfig {
@@ -20,6 +26,18 @@ export interface RunConfig {
   useSample: boolean;
   agentDir: string;
   coreDataDir: string;
+  // C only, defaults to AOC_C_BUILD or "dynamic"
+  build?: CBuildMode;
+  // C only: compile with -DAOC_STATS (defaults to AOC_STATS=1 in the env)
+  stats?: boolean;
 }
 
+/**
+ * C build modes:
+ *   - dynamic : clang -O2 (default)
+ *   - static  : fully static, with musl-gcc when installed
+ *   - nostart : static, no libc, minimal _start from the harness (start.c)
+ */
+export type CBuildMode = "dynamic" | "static" | "nostart";
+
 export type Agent = "claude" | "codex" | "gemini";
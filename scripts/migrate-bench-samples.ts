@@ -0,0 +1,83 @@
+#!/usr/bin/env tsx
+/**
+ * 🗜️ AoC 2025 Battle Royale - Migrate Benchmark Samples
+ *
+ * Convertit les benchmark_runs existants en un blob compact par session
+ * (samples_blob), à utiliser avec benchSampleStorage=blob dans le dashboard,
+ * et calcule l'histogramme de latence des sessions qui n'en ont pas.
+ *
+ * Usage: npm run migrate-bench-samples [-- --dry-run] [-- --vacuum]
+ *   --dry-run: Affiche ce qui serait migré sans rien modifier
+ *   --vacuum:  Récupère l'espace disque libéré après la migration
+ */
+
+import Database from "better-sqlite3";
+import { existsSync } from "node:fs";
+import { join } from "node:path";
+import { applyMigrations } from "../core/db/src/migrations.js";
+import { migrateRunsToBlobs } from "../core/db/src/samples.js";
+import { backfillHistograms } from "../core/db/src/histogram.js";
+
+const ROOT = process.cwd();
+const DB_PATH =
+  process.env.AOC_DB_PATH ?? join(ROOT, "core", "dashboard", "data", "aoc25.db");
+
+function migrate(dryRun: boolean, vacuum: boolean): void {
+  console.log("🗜️  AoC 2025 Battle Royale - Benchmark Samples Migration\n");
+  console.log("═".repeat(50));
+
+  if (!existsSync(DB_PATH)) {
+    console.error(`\n❌ Database not found: ${DB_PATH}`);
+    process.exit(1);
+  }
+
+  console.log(`\n📝 Opening database: ${DB_PATH}`);
+  const db = new Database(DB_PATH);
+  db.pragma("journal_mode = WAL");
+  db.pragma("foreign_keys = ON");
+
+  // Make sure samples_blob / histogram_blob exist
+  applyMigrations(db);
+
+  const before = db
+    .prepare(
+      `SELECT COUNT(DISTINCT session_id) AS sessions, COUNT(*) AS runs
+       FROM benchmark_runs`
+    )
+    .get() as { sessions: number; runs: number };
+
+  console.log(
+    `\n📊 ${before.runs} runs in ${before.sessions} sessions stored as rows`
+  );
+
+  if (dryRun) {
+    console.log("\n🔍 Dry run: nothing changed");
+    db.close();
+    return;
+  }
+
+  const start = Date.now();
+  const result = migrateRunsToBlobs(db);
+  console.log(
+    `\n✅ Migrated ${result.runs} runs from ${result.sessions} sessions in ${
+      Date.now() - start
+    }ms`
+  );
+
+  const histograms = backfillHistograms(db);
+  console.log(`📈 Built ${histograms} latency histograms`);
+
+  if (vacuum) {
+    console.log("\n🧹 Vacuuming...");
+    db.exec("VACUUM");
+  }
+
+  db.close();
+
+  console.log("\n" + "═".repeat(50));
+  console.log("✨ Done! Set NUXT_BENCH_SAMPLE_STORAGE=blob for new sessions.");
+}
+
+// CLI
+const args = process.argv.slice(2);
+migrate(args.includes("--dry-run"), args.includes("--vacuum"));
@@ -892,12 +892,10 @@ async function syncTools(): Promise<boolean> {
       `// Re-export types for solver imports\nexport * from "./dist/types.js";\n`
     );
 
-    // Copy C common header
-    const cHeaderSrc = join(runnerSrcDir, "c", "common.h");
-    if (existsSync(cHeaderSrc)) {
-      const cHeaderDir = join(runnerDestDir, "c");
-      await mkdir(cHeaderDir, { recursive: true });
-      await copyFile(cHeaderSrc, join(cHeaderDir, "common.h"));
+    // Copy C harness (common.h, nolibc.h, start.c, startup benchmark)
+    const cHarnessSrc = join(runnerSrcDir, "c");
+    if (existsSync(cHarnessSrc)) {
+      await copyDir(cHarnessSrc, join(runnerDestDir, "c"));
     }
 
     // Create shell wrapper (Unix)
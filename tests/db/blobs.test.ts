@@ -0,0 +1,120 @@
+/**
+ * 🧪 Tests - Content Store
+ */
+
+import { describe, it, expect, beforeAll, afterAll, beforeEach } from "vitest";
+import { mkdir, rm } from "node:fs/promises";
+import { join } from "node:path";
+import Database from "better-sqlite3";
+import { AocDatabase } from "../core/db/src/database.js";
+import {
+  hashContent,
+  putBlob,
+  getBlob,
+  getDayContent,
+  setDayContent,
+  deleteUnreferencedBlobs,
+} from "../core/db/src/blobs.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-blobs");
+const DB_PATH = join(TEST_ROOT, "blobs.db");
+
+describe("blobs", () => {
+  beforeAll(async () => {
+    await mkdir(TEST_ROOT, { recursive: true });
+  });
+
+  afterAll(async () => {
+    await rm(TEST_ROOT, { recursive: true, force: true });
+  });
+
+  beforeEach(async () => {
+    await rm(DB_PATH, { force: true });
+    await rm(`${DB_PATH}-wal`, { force: true });
+    await rm(`${DB_PATH}-shm`, { force: true });
+  });
+
+  const blobCount = (db: Database.Database) =>
+    db.prepare("SELECT COUNT(*) FROM blobs").pluck().get();
+
+  it("should store each content once", () => {
+    new AocDatabase(DB_PATH).close();
+    const db = new Database(DB_PATH);
+
+    const hash = putBlob(db, "1 2 3\n");
+    expect(hash).toBe(hashContent("1 2 3\n"));
+    expect(hash).toMatch(/^[0-9a-f]{64}$/);
+
+    setDayContent(db, 1, "sample_input", "1 2 3\n");
+    setDayContent(db, 2, "final_input", "1 2 3\n");
+    expect(blobCount(db)).toBe(1);
+    expect(getBlob(db, hash)).toBe("1 2 3\n");
+    expect(getBlob(db, "0".repeat(64))).toBeNull();
+    db.close();
+  });
+
+  it("should list days without their contents", () => {
+    const aoc = new AocDatabase(DB_PATH);
+    aoc.updateDay(3, { final_input: "x".repeat(1000), answer_p1: "42" });
+
+    const day = aoc.getAllDays().find((d) => d.id === 3)!;
+    expect(day).not.toHaveProperty("final_input");
+    expect(day.final_input_hash).toBe(hashContent("x".repeat(1000)));
+    expect(day.answer_p1).toBe("42");
+
+    expect(aoc.getDay(3)?.final_input).toBe("x".repeat(1000));
+    expect(aoc.getDay(3)?.puzzle1_md).toBeNull();
+    aoc.close();
+  });
+
+  it("should delete contents no day points to", () => {
+    new AocDatabase(DB_PATH).close();
+    const db = new Database(DB_PATH);
+
+    setDayContent(db, 1, "puzzle1_md", "# v1");
+    setDayContent(db, 1, "puzzle1_md", "# v2");
+    expect(blobCount(db)).toBe(2);
+
+    expect(deleteUnreferencedBlobs(db)).toBe(1);
+    expect(getDayContent(db, 1)?.puzzle1_md).toBe("# v2");
+    db.close();
+  });
+
+  it("should migrate inline contents of older databases", () => {
+    const legacy = new Database(DB_PATH);
+    legacy.exec(`
+      CREATE TABLE days (
+        id INTEGER PRIMARY KEY,
+        puzzle1_md TEXT,
+        puzzle2_md TEXT,
+        sample_input TEXT,
+        sample_expected_p1 TEXT,
+        sample_expected_p2 TEXT,
+        final_input TEXT,
+        answer_p1 TEXT,
+        answer_p2 TEXT,
+        published_at DATETIME,
+        created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+        updated_at DATETIME DEFAULT CURRENT_TIMESTAMP
+      );
+      INSERT INTO days (id, puzzle1_md, final_input, answer_p1)
+      VALUES (1, '# Day 1', '12\n34', '46');
+    `);
+    legacy.close();
+
+    const aoc = new AocDatabase(DB_PATH);
+    const day = aoc.getDay(1);
+    expect(day?.puzzle1_md).toBe("# Day 1");
+    expect(day?.final_input).toBe("12\n34");
+    expect(day?.answer_p1).toBe("46");
+    aoc.close();
+
+    const db = new Database(DB_PATH);
+    const columns = (
+      db.prepare("PRAGMA table_info(days)").all() as { name: string }[]
+    ).map((c) => c.name);
+    expect(columns).not.toContain("final_input");
+    expect(columns).toContain("final_input_hash");
+    db.close();
+  });
+});
@@ -4,6 +4,7 @@
 
 import { describe, it, expect, beforeAll, afterAll, beforeEach } from "vitest";
 import { mkdir, rm, copyFile } from "node:fs/promises";
+import Database from "better-sqlite3";
 import { join } from "node:path";
 import { AocDatabase } from "../core/db/src/database.js";
 
@@ -117,6 +118,25 @@ describe("database", () => {
       const run = db.getRun(runId);
       expect(run?.error).toBe("Compilation failed");
       expect(run?.is_correct).toBeNull();
+      expect(run?.stats).toBeNull();
+    });
+
+    it("should store work counters", () => {
+      const stats = {
+        nodes: { count: 1234 },
+        depth: { count: 3, sum: 7, min: 1, max: 4, hist: { 1: 1, 2: 1, 4: 1 } },
+      };
+      const runId = db.createRun({
+        agent: "gemini",
+        day: 1,
+        part: 1,
+        language: "c",
+        answer: "42",
+        time_ms: 2,
+        stats,
+      });
+
+      expect(db.getRun(runId)?.stats).toEqual(stats);
     });
 
     it("should get runs for a day", () => {
@@ -389,4 +409,134 @@ describe("database", () => {
       expect(runs.map((r) => r.run_index)).toEqual([0, 1, 2, 3, 4]);
     });
   });
+
+  describe("perf regression", () => {
+    const puzzle = {
+      agent: "claude" as const,
+      day: 10,
+      part: 1 as const,
+      language: "c" as const,
+    };
+    const around = (center: number) =>
+      Array.from({ length: 20 }, (_, i) => center + (i % 5) * 0.1);
+
+    it("should mark the first session as insufficient", () => {
+      const created = db.createBenchmarkSession({
+        ...puzzle,
+        num_runs: 20,
+        times: around(10),
+      });
+
+      expect(created.regression.verdict).toBe("insufficient");
+      expect(db.getBenchmarkSession(created.id)?.perf_verdict).toBe(
+        "insufficient"
+      );
+    });
+
+    it("should flag a slower session as a regression", () => {
+      db.createBenchmark({ ...puzzle, num_runs: 20, times: around(10) });
+      const created = db.createBenchmarkSession({
+        ...puzzle,
+        num_runs: 20,
+        times: around(15),
+      });
+
+      const session = db.getBenchmarkSession(created.id);
+      expect(session?.perf_verdict).toBe("regression");
+      expect(session?.perf_delta_pct).toBeCloseTo(50, 0);
+      expect(session?.perf_p_value).toBeLessThan(0.01);
+      expect(session?.perf_baseline_runs).toBe(20);
+    });
+
+    it("should flag a faster session as an improvement", () => {
+      db.createBenchmark({ ...puzzle, num_runs: 20, times: around(10) });
+      const created = db.createBenchmarkSession({
+        ...puzzle,
+        num_runs: 20,
+        times: around(5),
+      });
+
+      expect(created.regression.verdict).toBe("improvement");
+    });
+
+    it("should not compare against other puzzles or wrong answers", () => {
+      db.createBenchmark({
+        ...puzzle,
+        language: "ts",
+        num_runs: 20,
+        times: around(10),
+      });
+      db.createBenchmark({
+        ...puzzle,
+        num_runs: 20,
+        times: around(10),
+        is_correct: false,
+      });
+
+      expect(db.getBaselineSamples(puzzle)).toEqual([]);
+    });
+
+    it("should not pool sessions of another C build mode", () => {
+      db.createBenchmark({
+        ...puzzle,
+        build_mode: "nostart",
+        num_runs: 20,
+        times: around(5),
+      });
+      db.createBenchmark({ ...puzzle, num_runs: 2, times: [10, 10] });
+
+      expect(db.getBaselineSamples(puzzle)).toEqual([10, 10]);
+      expect(
+        db.getBaselineSamples({ ...puzzle, build_mode: "nostart" })
+      ).toHaveLength(20);
+    });
+
+    it("should pool only the last sessions", () => {
+      for (let i = 0; i < 7; i++) {
+        db.createBenchmark({ ...puzzle, num_runs: 2, times: [i, i] });
+      }
+
+      expect(db.getBaselineSamples(puzzle, 3).sort()).toEqual([
+        4, 4, 5, 5, 6, 6,
+      ]);
+    });
+
+    it("should migrate a database created before the perf columns", () => {
+      db.close();
+      const raw = new Database(DB_PATH);
+      raw.exec(`
+        DROP TABLE benchmark_runs;
+        DROP TABLE benchmark_sessions;
+        CREATE TABLE benchmark_sessions (
+          id INTEGER PRIMARY KEY AUTOINCREMENT,
+          agent TEXT NOT NULL, day INTEGER NOT NULL, part INTEGER NOT NULL,
+          language TEXT NOT NULL, num_runs INTEGER NOT NULL DEFAULT 100,
+          answer TEXT, is_correct INTEGER,
+          avg_time_ms REAL, min_time_ms REAL, max_time_ms REAL,
+          std_dev_ms REAL, p50_time_ms REAL, p95_time_ms REAL,
+          p99_time_ms REAL, created_at DATETIME DEFAULT CURRENT_TIMESTAMP
+        );
+      `);
+      raw.close();
+
+      db = new AocDatabase(DB_PATH);
+      const id = db.createBenchmark({
+        ...puzzle,
+        num_runs: 5,
+        times: around(1),
+      });
+      expect(db.getBenchmarkSession(id)?.perf_verdict).toBe("insufficient");
+    });
+
+    it("should backfill the build mode of older C sessions", () => {
+      const old = db.createBenchmark({ ...puzzle, num_runs: 2, times: [1, 1] });
+      db.close();
+      const raw = new Database(DB_PATH);
+      raw.exec("ALTER TABLE benchmark_sessions DROP COLUMN build_mode");
+      raw.close();
+
+      db = new AocDatabase(DB_PATH);
+      expect(db.getBenchmarkSession(old)?.build_mode).toBe("dynamic");
+    });
+  });
 });
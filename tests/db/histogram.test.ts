@@ -0,0 +1,176 @@
+/**
+ * 🧪 Tests - Latency Histograms
+ */
+
+import { describe, it, expect, beforeAll, afterAll, beforeEach } from "vitest";
+import { mkdir, rm } from "node:fs/promises";
+import { join } from "node:path";
+import Database from "better-sqlite3";
+import { AocDatabase } from "../core/db/src/database.js";
+import { insertBenchmarkSession } from "../core/db/src/benchmarks.js";
+import {
+  LatencyHistogram,
+  bucketIndex,
+  bucketRange,
+  backfillHistograms,
+  getSessionHistogram,
+  mergeSessionHistograms,
+} from "../core/db/src/histogram.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-histogram");
+const DB_PATH = join(TEST_ROOT, "histogram.db");
+
+const puzzle = {
+  agent: "claude" as const,
+  day: 2,
+  part: 1 as const,
+  language: "c" as const,
+};
+
+describe("histogram", () => {
+  describe("buckets", () => {
+    it("should cover every value without gaps", () => {
+      let previousHigh = -1;
+      for (let index = 0; index < 5000; index++) {
+        const [low, high] = bucketRange(index);
+        expect(low).toBe(previousHigh + 1);
+        previousHigh = high;
+      }
+    });
+
+    it("should keep the relative error below 1%", () => {
+      for (const ns of [0, 255, 256, 1_234_567, 2 ** 32 + 5, 6e10]) {
+        const [low, high] = bucketRange(bucketIndex(ns));
+        expect(ns).toBeGreaterThanOrEqual(low);
+        expect(ns).toBeLessThanOrEqual(high);
+        expect((high - low) / Math.max(low, 1)).toBeLessThan(0.01);
+      }
+    });
+  });
+
+  describe("LatencyHistogram", () => {
+    const times = Array.from({ length: 10_000 }, (_, i) => 0.5 + i / 10_000);
+
+    it("should answer percentiles within bucket precision", () => {
+      const histogram = LatencyHistogram.fromMs(times);
+
+      expect(histogram.totalCount).toBe(10_000);
+      expect(histogram.minMs).toBe(0.5);
+      expect(histogram.maxMs).toBeCloseTo(1.4999, 6);
+
+      const [p50, p99, p100] = histogram.percentiles([50, 99, 100]);
+      expect(p50!.ms! / 0.9999).toBeCloseTo(1, 2);
+      expect(p99!.ms! / 1.4899).toBeCloseTo(1, 2);
+      expect(p100!.ms).toBeCloseTo(1.4999, 6);
+    });
+
+    it("should round-trip through a compact blob", () => {
+      const histogram = LatencyHistogram.fromMs(times);
+      const blob = histogram.encode();
+      const decoded = LatencyHistogram.decode(blob);
+
+      expect(blob.length).toBeLessThan(4096);
+      expect(decoded.totalCount).toBe(histogram.totalCount);
+      expect(decoded.percentileMs(90)).toBe(histogram.percentileMs(90));
+      expect(decoded.buckets()).toEqual(histogram.buckets());
+    });
+
+    it("should merge histograms", () => {
+      const merged = LatencyHistogram.fromMs([1, 2]).merge(
+        LatencyHistogram.fromMs([3, 4])
+      );
+
+      expect(merged.totalCount).toBe(4);
+      expect(merged.minMs).toBe(1);
+      expect(merged.maxMs).toBe(4);
+      expect(merged.percentileMs(75)).toBeCloseTo(3, 1);
+    });
+
+    it("should regroup buckets for charts", () => {
+      const buckets = LatencyHistogram.fromMs(times).buckets(20);
+
+      expect(buckets).toHaveLength(20);
+      expect(buckets.reduce((sum, b) => sum + b.count, 0)).toBe(10_000);
+    });
+
+    it("should handle empty histograms", () => {
+      const empty = LatencyHistogram.decode(new LatencyHistogram().encode());
+
+      expect(empty.totalCount).toBe(0);
+      expect(empty.percentileMs(50)).toBeNull();
+      expect(empty.buckets()).toEqual([]);
+    });
+
+    it("should reject unknown formats", () => {
+      expect(() => LatencyHistogram.decode(Buffer.from([9, 8]))).toThrow();
+    });
+  });
+
+  describe("storage", () => {
+    let db: Database.Database;
+
+    beforeAll(async () => {
+      await mkdir(TEST_ROOT, { recursive: true });
+    });
+
+    afterAll(async () => {
+      db?.close();
+      await rm(TEST_ROOT, { recursive: true, force: true });
+    });
+
+    beforeEach(async () => {
+      db?.close();
+      await rm(DB_PATH, { force: true });
+      await rm(`${DB_PATH}-wal`, { force: true });
+      await rm(`${DB_PATH}-shm`, { force: true });
+
+      new AocDatabase(DB_PATH).close();
+      db = new Database(DB_PATH);
+    });
+
+    it("should store a histogram with each session", () => {
+      const { id } = insertBenchmarkSession(db, {
+        ...puzzle,
+        num_runs: 3,
+        times: [1, 2, 3],
+      });
+
+      const blob = db
+        .prepare("SELECT histogram_blob FROM benchmark_sessions WHERE id = ?")
+        .pluck()
+        .get(id);
+      expect(blob).toBeInstanceOf(Buffer);
+      expect(getSessionHistogram(db, id).totalCount).toBe(3);
+    });
+
+    it("should merge sessions", () => {
+      const a = insertBenchmarkSession(db, {
+        ...puzzle,
+        num_runs: 2,
+        times: [1, 2],
+      });
+      const b = insertBenchmarkSession(
+        db,
+        { ...puzzle, num_runs: 2, times: [3, 4] },
+        { storage: "blob" }
+      );
+
+      const merged = mergeSessionHistograms(db, [a.id, b.id]);
+      expect(merged.totalCount).toBe(4);
+      expect(merged.maxMs).toBe(4);
+    });
+
+    it("should backfill sessions without a histogram", () => {
+      const { id } = insertBenchmarkSession(db, {
+        ...puzzle,
+        num_runs: 3,
+        times: [5, 6, 7],
+      });
+      db.prepare("UPDATE benchmark_sessions SET histogram_blob = NULL").run();
+
+      expect(backfillHistograms(db, 1)).toBe(1);
+      expect(backfillHistograms(db)).toBe(0);
+      expect(getSessionHistogram(db, id).percentileMs(100)).toBe(7);
+    });
+  });
+});
@@ -0,0 +1,126 @@
+/**
+ * 🧪 Tests - Kernel Shootouts Storage
+ */
+
+import { describe, it, expect, beforeAll, afterAll, beforeEach } from "vitest";
+import { mkdir, rm } from "node:fs/promises";
+import { join } from "node:path";
+import { AocDatabase } from "../core/db/src/database.js";
+import type { KernelStatsInput } from "../core/db/src/types.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-kernels");
+const DB_PATH = join(TEST_ROOT, "kernels.db");
+
+const kernel = (
+  name: string,
+  medianNs: number,
+  ok = true
+): KernelStatsInput => ({
+  name,
+  iterations: 1000,
+  samples: 20,
+  minNs: medianNs - 1,
+  medianNs,
+  meanNs: medianNs + 0.5,
+  maxNs: medianNs + 3,
+  stdDevNs: 0.8,
+  ok,
+  answer: ok ? "42" : "41",
+});
+
+describe("kernel runs", () => {
+  let db: AocDatabase;
+
+  beforeAll(async () => {
+    await mkdir(TEST_ROOT, { recursive: true });
+  });
+
+  afterAll(async () => {
+    db?.close();
+    await rm(TEST_ROOT, { recursive: true, force: true });
+  });
+
+  beforeEach(async () => {
+    db?.close();
+    await rm(DB_PATH, { force: true });
+    await rm(`${DB_PATH}-wal`, { force: true });
+    await rm(`${DB_PATH}-shm`, { force: true });
+    db = new AocDatabase(DB_PATH);
+  });
+
+  it("should store a run with its kernels in output order", () => {
+    const id = db.createKernelRun({
+      agent: "claude",
+      file: "c/day03/kernel_pick.c",
+      day: 3,
+      build_mode: "static",
+      kernels: [kernel("scalar", 120), kernel("avx2", 35)],
+    });
+
+    const [run] = db.getKernelRuns();
+    expect(run).toMatchObject({
+      id,
+      agent: "claude",
+      day: 3,
+      file: "c/day03/kernel_pick.c",
+      build_mode: "static",
+      ok: true,
+    });
+    expect(run!.kernels.map((k) => k.name)).toEqual(["scalar", "avx2"]);
+    expect(run!.kernels[1]).toEqual({
+      name: "avx2",
+      iterations: 1000,
+      samples: 20,
+      min_ns: 34,
+      median_ns: 35,
+      mean_ns: 35.5,
+      max_ns: 38,
+      std_dev_ns: 0.8,
+      ok: true,
+      answer: "42",
+    });
+  });
+
+  it("should mark a run with a wrong kernel as not ok", () => {
+    db.createKernelRun({
+      agent: "codex",
+      file: "c/kernels/sum.c",
+      kernels: [kernel("ref", 10), kernel("fast", 5, false)],
+    });
+
+    const [run] = db.getKernelRuns();
+    expect(run).toMatchObject({ day: null, build_mode: "dynamic", ok: false });
+  });
+
+  it("should filter by agent, day and file, latest first", () => {
+    db.createKernelRun({
+      agent: "claude",
+      file: "c/a.c",
+      day: 1,
+      kernels: [kernel("a", 1)],
+    });
+    db.createKernelRun({
+      agent: "claude",
+      file: "c/b.c",
+      day: 2,
+      kernels: [kernel("b", 1)],
+    });
+    const last = db.createKernelRun({
+      agent: "claude",
+      file: "c/a.c",
+      day: 1,
+      kernels: [kernel("a", 2)],
+    });
+    db.createKernelRun({
+      agent: "gemini",
+      file: "c/a.c",
+      day: 1,
+      kernels: [kernel("a", 3)],
+    });
+
+    const runs = db.getKernelRuns({ agent: "claude", day: 1, file: "c/a.c" });
+    expect(runs.map((r) => r.id)[0]).toBe(last);
+    expect(runs).toHaveLength(2);
+    expect(db.getKernelRuns({ limit: 1 })).toHaveLength(1);
+  });
+});
@@ -0,0 +1,147 @@
+/**
+ * 🧪 Tests - Leaderboard
+ */
+
+import { describe, it, expect, beforeAll, afterAll, beforeEach } from "vitest";
+import { mkdir, rm } from "node:fs/promises";
+import { join } from "node:path";
+import Database from "better-sqlite3";
+import { AocDatabase } from "../core/db/src/database.js";
+import { BenchmarkWriter } from "../core/db/src/benchmarks.js";
+import {
+  getLeaderboard,
+  getPuzzleBests,
+  rebuildLeaderboard,
+} from "../core/db/src/leaderboard.js";
+import type { Agent, BuildMode } from "../core/db/src/types.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-leaderboard");
+const DB_PATH = join(TEST_ROOT, "leaderboard.db");
+
+describe("leaderboard", () => {
+  let db: Database.Database;
+
+  beforeAll(async () => {
+    await mkdir(TEST_ROOT, { recursive: true });
+  });
+
+  afterAll(async () => {
+    db?.close();
+    await rm(TEST_ROOT, { recursive: true, force: true });
+  });
+
+  beforeEach(async () => {
+    db?.close();
+    await rm(DB_PATH, { force: true });
+    await rm(`${DB_PATH}-wal`, { force: true });
+    await rm(`${DB_PATH}-shm`, { force: true });
+
+    new AocDatabase(DB_PATH).close();
+    db = new Database(DB_PATH);
+  });
+
+  const bench = (
+    agent: Agent,
+    timeMs: number,
+    overrides: {
+      day?: number;
+      part?: 1 | 2;
+      is_correct?: boolean;
+      build_mode?: BuildMode;
+    } = {}
+  ) =>
+    new BenchmarkWriter(db, { storage: "blob" }).write({
+      agent,
+      day: overrides.day ?? 1,
+      part: overrides.part ?? 1,
+      language: "c",
+      ...(overrides.build_mode && { build_mode: overrides.build_mode }),
+      num_runs: 1,
+      is_correct: overrides.is_correct ?? true,
+      times: [timeMs],
+    });
+
+  const points = () =>
+    Object.fromEntries(getLeaderboard(db).map((e) => [e.agent, e.points]));
+
+  it("should award 3/2/1 points on the best correct session", () => {
+    bench("claude", 5);
+    bench("codex", 3);
+    bench("gemini", 4);
+
+    expect(points()).toEqual({ codex: 3, gemini: 2, claude: 1 });
+
+    // Slower or wrong sessions do not change anything
+    bench("codex", 10);
+    bench("claude", 1, { is_correct: false });
+    expect(points()).toEqual({ codex: 3, gemini: 2, claude: 1 });
+
+    // A new best re-ranks the puzzle
+    bench("claude", 2);
+    expect(points()).toEqual({ claude: 3, codex: 2, gemini: 1 });
+  });
+
+  it("should total points and medals across puzzles", () => {
+    bench("claude", 1);
+    bench("codex", 2);
+    bench("codex", 1, { part: 2 });
+    bench("claude", 2, { part: 2 });
+
+    const claude = getLeaderboard(db).find((e) => e.agent === "claude")!;
+    expect(claude).toMatchObject({
+      points: 5,
+      gold: 1,
+      silver: 1,
+      bronze: 0,
+      puzzles: 2,
+      total_best_ms: 3,
+    });
+    expect(getPuzzleBests(db, "codex")).toHaveLength(2);
+  });
+
+  it("should share a podium step on ties", () => {
+    bench("claude", 2);
+    bench("codex", 2);
+    bench("gemini", 3);
+
+    expect(points()).toEqual({ claude: 3, codex: 3, gemini: 1 });
+  });
+
+  it("should not score day 0", () => {
+    bench("claude", 1, { day: 0 });
+    expect(getLeaderboard(db)).toEqual([]);
+  });
+
+  it("should only score the default build mode", () => {
+    bench("claude", 2);
+    bench("codex", 3);
+    bench("codex", 1, { build_mode: "nostart" });
+    bench("gemini", 1, { build_mode: "static" });
+
+    expect(points()).toEqual({ claude: 3, codex: 2 });
+
+    db.exec("DELETE FROM leaderboard; DELETE FROM puzzle_best;");
+    rebuildLeaderboard(db);
+    expect(points()).toEqual({ claude: 3, codex: 2 });
+  });
+
+  it("should rebuild from benchmark sessions", () => {
+    bench("claude", 5);
+    bench("codex", 3);
+    const before = getLeaderboard(db);
+
+    db.exec("DELETE FROM leaderboard; DELETE FROM puzzle_best;");
+    rebuildLeaderboard(db);
+
+    expect(getLeaderboard(db)).toEqual(before);
+  });
+
+  it("should build the tables for older databases on open", () => {
+    bench("gemini", 1);
+    db.exec("DELETE FROM leaderboard; DELETE FROM puzzle_best;");
+
+    const aoc = new AocDatabase(DB_PATH);
+    expect(aoc.getLeaderboard().map((e) => e.agent)).toEqual(["gemini"]);
+    aoc.close();
+  });
+});
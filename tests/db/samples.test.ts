@@ -0,0 +1,234 @@
+/**
+ * 🧪 Tests - Benchmark Samples Storage
+ */
+
+import { describe, it, expect, beforeAll, afterAll, beforeEach } from "vitest";
+import { mkdir, rm } from "node:fs/promises";
+import { join } from "node:path";
+import Database from "better-sqlite3";
+import { AocDatabase } from "../core/db/src/database.js";
+import {
+  encodeSamples,
+  decodeSamples,
+  getSessionSamples,
+  migrateRunsToBlobs,
+} from "../core/db/src/samples.js";
+import {
+  BenchmarkWriter,
+  insertBenchmarkSession,
+  getBaselineSamples,
+} from "../core/db/src/benchmarks.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-samples");
+const DB_PATH = join(TEST_ROOT, "samples.db");
+
+const puzzle = {
+  agent: "codex" as const,
+  day: 3,
+  part: 2 as const,
+  language: "c" as const,
+};
+
+describe("samples", () => {
+  describe("codec", () => {
+    it("should round-trip timings at ns precision", () => {
+      const times = [1.234567, 1.2301, 0.000001, 59_999.5, 0, 1.25];
+      const decoded = decodeSamples(encodeSamples(times));
+
+      expect(decoded.length).toBe(times.length);
+      decoded.forEach((t, i) => expect(t).toBeCloseTo(times[i]!, 6));
+    });
+
+    it("should handle empty sessions", () => {
+      expect(decodeSamples(encodeSamples([]))).toEqual([]);
+    });
+
+    it("should be much smaller than one row per run", () => {
+      // ~1.2ms runs with up to 100µs jitter: at most 3 bytes per run
+      const times = Array.from(
+        { length: 1000 },
+        (_, i) => 1.2 + ((i * 7919) % 100) / 1000
+      );
+      expect(encodeSamples(times).length).toBeLessThanOrEqual(3 * 1000 + 3);
+    });
+
+    it("should reject unknown formats", () => {
+      expect(() => decodeSamples(Buffer.from([9, 0]))).toThrow();
+    });
+  });
+
+  describe("storage", () => {
+    let db: Database.Database;
+
+    beforeAll(async () => {
+      await mkdir(TEST_ROOT, { recursive: true });
+    });
+
+    afterAll(async () => {
+      await rm(TEST_ROOT, { recursive: true, force: true });
+    });
+
+    beforeEach(async () => {
+      db?.close();
+      await rm(DB_PATH, { force: true });
+      await rm(`${DB_PATH}-wal`, { force: true });
+      await rm(`${DB_PATH}-shm`, { force: true });
+
+      // Create the schema, then work on a raw connection like the dashboard
+      new AocDatabase(DB_PATH).close();
+      db = new Database(DB_PATH);
+    });
+
+    const runCount = () =>
+      db.prepare("SELECT COUNT(*) FROM benchmark_runs").pluck().get();
+
+    it("should store blob sessions without run rows", () => {
+      const { id } = insertBenchmarkSession(
+        db,
+        { ...puzzle, num_runs: 3, times: [1, 2, 3] },
+        { storage: "blob" }
+      );
+
+      expect(runCount()).toBe(0);
+      expect(getSessionSamples(db, id)).toEqual([1, 2, 3]);
+    });
+
+    it("should build baselines from rows and blobs", () => {
+      insertBenchmarkSession(db, { ...puzzle, num_runs: 2, times: [1, 2] });
+      insertBenchmarkSession(
+        db,
+        { ...puzzle, num_runs: 2, times: [3, 4] },
+        { storage: "blob" }
+      );
+
+      expect(getBaselineSamples(db, puzzle).sort()).toEqual([1, 2, 3, 4]);
+    });
+
+    it("should expose blob samples as benchmark runs", () => {
+      const { id } = insertBenchmarkSession(
+        db,
+        { ...puzzle, num_runs: 2, times: [5, 6] },
+        { storage: "blob" }
+      );
+
+      const aoc = new AocDatabase(DB_PATH);
+      expect(aoc.getBenchmarkRuns(id).map((r) => r.time_ms)).toEqual([5, 6]);
+      expect(aoc.getBenchmarkSession(id)).not.toHaveProperty("samples_blob");
+      aoc.close();
+    });
+
+    it("should insert more runs than one INSERT chunk", () => {
+      const times = Array.from({ length: 1234 }, (_, i) => i);
+      const { id } = insertBenchmarkSession(db, {
+        ...puzzle,
+        num_runs: times.length,
+        times,
+      });
+
+      expect(getSessionSamples(db, id)).toEqual(times);
+    });
+
+    it("should migrate existing runs to blobs", () => {
+      const a = insertBenchmarkSession(db, {
+        ...puzzle,
+        num_runs: 3,
+        times: [1.5, 2.5, 3.5],
+      });
+      const b = insertBenchmarkSession(db, {
+        ...puzzle,
+        day: 4,
+        num_runs: 2,
+        times: [7, 8],
+      });
+
+      const result = migrateRunsToBlobs(db, 1);
+
+      expect(result).toEqual({ sessions: 2, runs: 5 });
+      expect(runCount()).toBe(0);
+      expect(getSessionSamples(db, a.id)).toEqual([1.5, 2.5, 3.5]);
+      expect(getSessionSamples(db, b.id)).toEqual([7, 8]);
+      expect(migrateRunsToBlobs(db)).toEqual({ sessions: 0, runs: 0 });
+    });
+
+    describe("BenchmarkWriter", () => {
+      it("should buffer runs until flushed", () => {
+        const writer = new BenchmarkWriter(db, { flushDelayMs: 60_000 });
+        const { id } = writer.write({
+          ...puzzle,
+          num_runs: 3,
+          times: [1, 2, 3],
+        });
+
+        const sessions = db
+          .prepare("SELECT id FROM benchmark_sessions")
+          .pluck()
+          .all();
+        expect(sessions).toEqual([id]);
+        expect(runCount()).toBe(0);
+        expect(writer.pendingCount).toBe(3);
+
+        writer.flush();
+        expect(runCount()).toBe(3);
+        expect(writer.pendingCount).toBe(0);
+      });
+
+      it("should commit a session with its samples before the flush", () => {
+        const writer = new BenchmarkWriter(db, { flushDelayMs: 60_000 });
+        const { id } = writer.write({
+          ...puzzle,
+          num_runs: 3,
+          times: [1, 2, 3],
+        });
+        const blob = () =>
+          db
+            .prepare("SELECT samples_blob FROM benchmark_sessions WHERE id = ?")
+            .pluck()
+            .get(id);
+
+        // A crash here keeps a complete session
+        expect(getSessionSamples(db, id)).toEqual([1, 2, 3]);
+
+        writer.flush();
+        expect(blob()).toBeNull();
+        expect(getSessionSamples(db, id)).toEqual([1, 2, 3]);
+      });
+
+      it("should flush when too many runs are pending", () => {
+        const writer = new BenchmarkWriter(db, {
+          maxPendingRuns: 4,
+          flushDelayMs: 60_000,
+        });
+
+        writer.write({ ...puzzle, num_runs: 2, times: [1, 2] });
+        expect(runCount()).toBe(0);
+        writer.write({ ...puzzle, day: 5, num_runs: 2, times: [3, 4] });
+        expect(runCount()).toBe(4);
+      });
+
+      it("should pool a puzzle's pending runs into its next baseline", () => {
+        const writer = new BenchmarkWriter(db, { flushDelayMs: 60_000 });
+        const times = Array.from({ length: 10 }, (_, i) => 10 + i * 0.01);
+
+        writer.write({ ...puzzle, num_runs: 10, times });
+        const second = writer.write({
+          ...puzzle,
+          num_runs: 10,
+          times: times.map((t) => t * 2),
+        });
+
+        expect(second.regression.verdict).toBe("regression");
+        expect(second.regression.baselineRuns).toBe(10);
+        expect(runCount()).toBe(0);
+        writer.flush();
+      });
+
+      it("should flush on a timer", async () => {
+        const writer = new BenchmarkWriter(db, { flushDelayMs: 10 });
+        writer.write({ ...puzzle, num_runs: 2, times: [1, 2] });
+
+        await new Promise((resolve) => setTimeout(resolve, 50));
+        expect(runCount()).toBe(2);
+      });
+    });
+  });
+});
@@ -0,0 +1,88 @@
+/**
+ * 🧪 Tests - Benchmark Statistics
+ */
+
+import { describe, it, expect } from "vitest";
+import {
+  computeStats,
+  median,
+  mannWhitneyU,
+  compareToBaseline,
+} from "../core/db/src/stats.js";
+
+describe("stats", () => {
+  describe("computeStats", () => {
+    it("should compute basic stats", () => {
+      const stats = computeStats([4, 2, 6, 8]);
+      expect(stats.avg).toBe(5);
+      expect(stats.min).toBe(2);
+      expect(stats.max).toBe(8);
+      expect(stats.stdDev).toBeCloseTo(Math.sqrt(5));
+    });
+  });
+
+  describe("median", () => {
+    it("should handle odd and even lengths", () => {
+      expect(median([3, 1, 2])).toBe(2);
+      expect(median([4, 1, 3, 2])).toBe(2.5);
+    });
+  });
+
+  describe("mannWhitneyU", () => {
+    it("should give p=1 for identical samples", () => {
+      const { pValue } = mannWhitneyU([1, 1, 1, 1], [1, 1, 1, 1]);
+      expect(pValue).toBe(1);
+    });
+
+    it("should detect fully separated samples", () => {
+      const a = [11, 12, 13, 14, 15, 16, 17, 18, 19, 20];
+      const b = [1, 2, 3, 4, 5, 6, 7, 8, 9, 10];
+      const { u, z, pValue } = mannWhitneyU(a, b);
+
+      expect(u).toBe(100);
+      expect(z).toBeGreaterThan(0);
+      // Exact normal approximation: z = 49.5 / sqrt(175) ≈ 3.74
+      expect(pValue).toBeCloseTo(0.00018, 4);
+    });
+
+    it("should not flag interleaved samples", () => {
+      const a = [1, 3, 5, 7, 9, 11, 13, 15];
+      const b = [2, 4, 6, 8, 10, 12, 14, 16];
+      expect(mannWhitneyU(a, b).pValue).toBeGreaterThan(0.5);
+    });
+  });
+
+  describe("compareToBaseline", () => {
+    const baseline = [10, 10.2, 9.9, 10.1, 10, 9.8, 10.3, 10, 10.1, 9.9];
+
+    it("should need enough samples on both sides", () => {
+      const result = compareToBaseline([1, 2], [1, 2, 3, 4, 5]);
+      expect(result.verdict).toBe("insufficient");
+      expect(result.pValue).toBeNull();
+      expect(result.baselineRuns).toBe(2);
+    });
+
+    it("should flag a regression", () => {
+      const current = baseline.map((t) => t * 1.2);
+      const result = compareToBaseline(baseline, current);
+      expect(result.verdict).toBe("regression");
+      expect(result.deltaPct).toBeCloseTo(20, 0);
+    });
+
+    it("should flag an improvement", () => {
+      const current = baseline.map((t) => t * 0.7);
+      expect(compareToBaseline(baseline, current).verdict).toBe("improvement");
+    });
+
+    it("should ignore significant but tiny shifts", () => {
+      const current = baseline.map((t) => t * 1.02);
+      const result = compareToBaseline(baseline, current, { alpha: 0.5 });
+      expect(result.verdict).toBe("unchanged");
+    });
+
+    it("should ignore large but noisy shifts", () => {
+      const noisy = [5, 30, 8, 12, 25, 7, 11, 40, 9, 10];
+      expect(compareToBaseline(baseline, noisy).verdict).toBe("unchanged");
+    });
+  });
+});
@@ -0,0 +1,221 @@
+/**
+ * 🧪 Tests - Benchmark Matrix
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from "vitest";
+import { mkdir, rm, writeFile, copyFile, readFile } from "node:fs/promises";
+import { join } from "node:path";
+import {
+  listBenchTasks,
+  buildBenchTasks,
+  runBenchMatrix,
+  formatBenchReport,
+  benchTaskKey,
+  getBuildCachePath,
+} from "../core/runner/src/bench.js";
+import type {
+  BenchTask,
+  BenchReportRow,
+} from "../core/runner/src/bench.js";
+import { CoreScheduler } from "../core/runner/src/scheduler.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-bench");
+
+// Sum of the numbers of the input
+const SOLVER = `
+#include "../../tools/runner/c/common.h"
+
+int main(void) {
+    char* input = aoc_read_input();
+    AOC_TIMER_START(solve);
+    long long sum = 0;
+    for (char* p = input; *p;) {
+        sum += strtol(p, &p, 10);
+        while (*p == '\\n') p++;
+    }
+    AOC_TIMER_END(solve);
+    AOC_RESULT_INT(sum);
+    aoc_cleanup(input);
+    return 0;
+}
+`;
+
+async function writeSolver(agent: string, day: string, source: string) {
+  const dir = join(TEST_ROOT, "agents", agent, "c", day);
+  await mkdir(dir, { recursive: true });
+  await writeFile(join(dir, "part1.c"), source);
+}
+
+describe("bench", () => {
+  const claudeDay01: BenchTask = {
+    agent: "claude",
+    day: 1,
+    part: 1,
+    language: "c",
+  };
+
+  beforeAll(async () => {
+    for (const agent of ["claude", "codex"]) {
+      const harness = join(TEST_ROOT, "agents", agent, "tools", "runner", "c");
+      await mkdir(harness, { recursive: true });
+      await copyFile(
+        join(process.cwd(), "core", "runner", "c", "common.h"),
+        join(harness, "common.h")
+      );
+      await writeSolver(agent, "day01", SOLVER);
+    }
+    // Wrong answer for codex, no input for day 2, no C part 2
+    await writeSolver(
+      "codex",
+      "day01",
+      SOLVER.replace("AOC_RESULT_INT(sum)", "AOC_RESULT_INT(sum + 1)")
+    );
+    await writeSolver("claude", "day02", SOLVER);
+    await writeSolver("claude", "day03", "int main(void) { syntax error }");
+
+    for (const day of ["day01", "day03"]) {
+      const data = join(TEST_ROOT, "core", "data", day);
+      await mkdir(data, { recursive: true });
+      await writeFile(join(data, "input.txt"), "1\n2\n3\n");
+      await writeFile(
+        join(data, "answers.json"),
+        JSON.stringify({ part1: "6", part2: null })
+      );
+    }
+  });
+
+  afterAll(async () => {
+    await rm(TEST_ROOT, { recursive: true, force: true });
+  });
+
+  describe("listBenchTasks", () => {
+    it("should only list solvers with an input, agents innermost", () => {
+      expect(listBenchTasks(TEST_ROOT).map(benchTaskKey)).toEqual([
+        "claude:1:1:c",
+        "codex:1:1:c",
+        "claude:3:1:c",
+      ]);
+    });
+
+    it("should apply the filters", () => {
+      const tasks = listBenchTasks(TEST_ROOT, {
+        agents: ["codex"],
+        days: [1, 2, 3],
+      });
+      expect(tasks.map(benchTaskKey)).toEqual(["codex:1:1:c"]);
+      expect(listBenchTasks(TEST_ROOT, { languages: ["ts"] })).toEqual([]);
+    });
+  });
+
+  describe("buildBenchTasks", () => {
+    it("should reuse binaries until the source changes", async () => {
+      const tasks = listBenchTasks(TEST_ROOT);
+
+      const first = await buildBenchTasks(TEST_ROOT, tasks);
+      expect(first.get(benchTaskKey(claudeDay01))).toMatchObject({
+        cached: false,
+      });
+      expect(first.get("claude:3:1:c")).toHaveProperty("error");
+
+      const second = await buildBenchTasks(TEST_ROOT, tasks);
+      expect(second.get(benchTaskKey(claudeDay01))).toMatchObject({
+        cached: true,
+      });
+      // Failed builds are retried
+      expect(second.get("claude:3:1:c")).toHaveProperty("error");
+
+      await writeSolver("claude", "day01", `${SOLVER}\n// edited\n`);
+      const third = await buildBenchTasks(TEST_ROOT, tasks);
+      expect(third.get(benchTaskKey(claudeDay01))).toMatchObject({
+        cached: false,
+      });
+
+      const cache = JSON.parse(
+        await readFile(getBuildCachePath(TEST_ROOT), "utf-8")
+      );
+      expect(Object.keys(cache)).toHaveLength(2);
+    });
+  });
+
+  describe("runBenchMatrix", () => {
+    it("should run every task and check the answers", async () => {
+      const tasks = listBenchTasks(TEST_ROOT);
+      const builds = await buildBenchTasks(TEST_ROOT, tasks);
+      const seen: string[] = [];
+
+      const results = await runBenchMatrix(TEST_ROOT, tasks, {
+        builds,
+        runs: 3,
+        scheduler: new CoreScheduler({ reserveCores: 0 }),
+        onResult: (result) => seen.push(benchTaskKey(result)),
+      });
+
+      expect(seen.sort()).toEqual(tasks.map(benchTaskKey).sort());
+
+      const byKey = new Map(results.map((r) => [benchTaskKey(r), r]));
+      expect(byKey.get("claude:1:1:c")).toMatchObject({
+        answer: "6",
+        isCorrect: true,
+      });
+      expect(byKey.get("claude:1:1:c")!.times).toHaveLength(3);
+      expect(byKey.get("codex:1:1:c")).toMatchObject({
+        answer: "7",
+        isCorrect: false,
+      });
+      expect(byKey.get("claude:3:1:c")!.error).toContain(
+        "Compilation failed"
+      );
+      expect(byKey.get("claude:1:1:c")!.cpus.length).toBeGreaterThan(0);
+    });
+  });
+
+  describe("formatBenchReport", () => {
+    const rows: BenchReportRow[] = [
+      {
+        ...claudeDay01,
+        runs: 2,
+        answer: "6",
+        isCorrect: true,
+        stats: {
+          avg: 1.5,
+          min: 1,
+          max: 2,
+          stdDev: 0.5,
+          p50: 1,
+          p95: 2,
+          p99: 2,
+        },
+        sessionId: 12,
+        verdict: "unchanged",
+        error: null,
+      },
+      {
+        ...claudeDay01,
+        day: 3,
+        runs: 0,
+        answer: "",
+        isCorrect: null,
+        stats: null,
+        sessionId: null,
+        verdict: null,
+        error: 'Compilation failed:\nexpected ";", got "x"',
+      },
+    ];
+
+    it("should write one CSV line per puzzle", () => {
+      const lines = formatBenchReport(rows, "csv").trimEnd().split("\n");
+
+      expect(lines[0]).toMatch(/^agent,day,part,language,runs,answer,/);
+      expect(lines[1]).toBe(
+        "claude,1,1,c,2,6,true,1.5,1,1,2,2,2,0.5,12,unchanged,"
+      );
+      expect(lines.slice(2).join("\n")).toBe(
+        'claude,3,1,c,0,,,,,,,,,,,,"Compilation failed:\nexpected "";"", got ""x"""'
+      );
+    });
+
+    it("should write the rows as JSON", () => {
+      expect(JSON.parse(formatBenchReport(rows, "json"))).toEqual(rows);
+    });
+  });
+});
@@ -9,6 +9,9 @@ import {
   executeC,
   precompileC,
   executePrecompiled,
+  cBinaryPath,
+  cCompileCommand,
+  parseCBuildMode,
 } from "../core/runner/src/executor-c.js";
 import type { RunConfig } from "../core/runner/src/types.js";
 
@@ -26,11 +29,13 @@ describe("executor-c", () => {
     await mkdir(coreDataDir, { recursive: true });
     await mkdir(toolsDir, { recursive: true });
 
-    // Copy common.h
-    await copyFile(
-      join(process.cwd(), "core", "runner", "c", "common.h"),
-      join(toolsDir, "common.h")
-    );
+    // Copy the C harness
+    for (const file of ["common.h", "nolibc.h", "start.c"]) {
+      await copyFile(
+        join(process.cwd(), "core", "runner", "c", file),
+        join(toolsDir, file)
+      );
+    }
 
     // Create sample input
     await writeFile(join(agentDir, "data", "day99", "sample.txt"), "1\n2\n3\n");
@@ -124,6 +129,118 @@ int main(void) {
 `
     );
 
+    // Create C solvers reading the input as a stream of tiny chunks
+    // (part 1 with the reader thread, part 2 without)
+    await mkdir(join(agentDir, "c", "day93"), { recursive: true });
+    for (const [part, threaded] of [
+      [1, 1],
+      [2, 0],
+    ]) {
+      await writeFile(
+        join(agentDir, "c", "day93", `part${part}.c`),
+        `
+#include "../../tools/runner/c/common.h"
+
+int main(void) {
+    AocStream* stream = aoc_stream_open(4, ${threaded});
+    long long sum = 0;
+    size_t len;
+    const char* chunk;
+    while ((chunk = aoc_stream_next(stream, &len))) {
+        const char* end = chunk + len;
+        for (const char* p = chunk; p < end; p++) {
+            long long value = 0;
+            while (p < end && *p != '\\n') value = value * 10 + (*p++ - '0');
+            sum += value;
+        }
+    }
+    aoc_stream_close(stream);
+
+    AOC_RESULT_INT(sum);
+    return 0;
+}
+`
+      );
+    }
+
+    // Create a C solver parsing streamed numbers with aoc_parse_u64
+    await mkdir(join(agentDir, "c", "day90"), { recursive: true });
+    await writeFile(
+      join(agentDir, "c", "day90", "part1.c"),
+      `
+#include "../../tools/runner/c/common.h"
+
+int main(void) {
+    AocStream* stream = aoc_stream_open(4, 1);
+    uint64_t sum = 0;
+    size_t len;
+    const char* chunk;
+    while ((chunk = aoc_stream_next(stream, &len))) {
+        const char* end = chunk + len;
+        for (const char* p = chunk; p < end; p++) {
+            uint64_t value;
+            p = aoc_parse_u64(p, &value);
+            sum += value;
+        }
+    }
+    aoc_stream_close(stream);
+
+    AOC_RESULT_UINT(sum);
+    return 0;
+}
+`
+    );
+
+    // Create a C solver using a large zeroed table
+    await mkdir(join(agentDir, "c", "day92"), { recursive: true });
+    await writeFile(
+      join(agentDir, "c", "day92", "part1.c"),
+      `
+#include "../../tools/runner/c/common.h"
+
+#define SIZE (5 * 1024 * 1024)
+
+int main(void) {
+    AocPages pages;
+    uint32_t* table = (uint32_t*)aoc_alloc_large(SIZE * sizeof(uint32_t), &pages);
+    AOC_REPORT_PAGES(table, pages);
+
+    long long sum = 0;
+    for (int i = 0; i < SIZE; i += 4096) sum += table[i]++;
+    for (int i = 0; i < SIZE; i += 4096) sum += table[i];
+    aoc_free_large(table, SIZE * sizeof(uint32_t));
+
+    AOC_RESULT_INT(sum);
+    return 0;
+}
+`
+    );
+
+    // Create a C solver with work counters
+    await mkdir(join(agentDir, "c", "day91"), { recursive: true });
+    await writeFile(
+      join(agentDir, "c", "day91", "part1.c"),
+      `
+#include "../../tools/runner/c/common.h"
+
+int main(void) {
+    char* input = aoc_read_input();
+    long long sum = 0;
+    for (char* p = input; *p; p++) {
+        if (*p < '0' || *p > '9') continue;
+        AOC_COUNT(digits);
+        AOC_HIST(digit, *p - '0');
+        sum += *p - '0';
+    }
+    AOC_RESULT_INT(sum);
+    aoc_cleanup(input);
+    return 0;
+}
+`
+    );
+    await mkdir(join(agentDir, "data", "day91"), { recursive: true });
+    await writeFile(join(agentDir, "data", "day91", "sample.txt"), "1 2 3 9");
+
     // Create sample inputs for additional tests
     await mkdir(join(agentDir, "data", "day97"), { recursive: true });
     await writeFile(join(agentDir, "data", "day97", "sample.txt"), "test");
@@ -131,6 +248,18 @@ int main(void) {
     await writeFile(join(agentDir, "data", "day96", "sample.txt"), "test");
     await mkdir(join(agentDir, "data", "day95"), { recursive: true });
     await writeFile(join(agentDir, "data", "day95", "sample.txt"), "test");
+    await mkdir(join(agentDir, "data", "day90"), { recursive: true });
+    // 0 to 19 digits, 8-digit boundaries, no trailing newline
+    await writeFile(
+      join(agentDir, "data", "day90", "sample.txt"),
+      "0\n7\n12345678\n123456789\n9999999999999999999\n42"
+    );
+    await mkdir(join(agentDir, "data", "day93"), { recursive: true });
+    // Lines longer than a chunk, no trailing newline
+    await writeFile(
+      join(agentDir, "data", "day93", "sample.txt"),
+      "1\n22\n333333333333\n4444\n5"
+    );
   });
 
   afterAll(async () => {
@@ -277,6 +406,87 @@ int main(void) { printf("42"); return 0; }
     expect(result.error).toContain("Fatal error");
   });
 
+  it.each([1, 2] as const)(
+    "should stream the input in line-aligned chunks (part %i)",
+    async (part) => {
+      const result = await executeC({
+        day: 93,
+        part,
+        lang: "c",
+        useSample: true,
+        agentDir,
+        coreDataDir,
+      });
+
+      expect(result.error).toBeUndefined();
+      expect(result.answer).toBe("333333337805");
+    }
+  );
+
+  it("should parse numbers 8 digits at a time", async () => {
+    const result = await executeC({
+      day: 90,
+      part: 1,
+      lang: "c",
+      useSample: true,
+      agentDir,
+      coreDataDir,
+    });
+
+    expect(result.error).toBeUndefined();
+    expect(result.answer).toBe("10000000000135802515");
+  });
+
+  it("should allocate large tables and report their pages", async () => {
+    const precompile = await precompileC(agentDir, 92, 1);
+    expect("binaryPath" in precompile).toBe(true);
+
+    if ("binaryPath" in precompile) {
+      const perf: Record<string, number> = {};
+      const result = await executePrecompiled(
+        precompile.binaryPath,
+        "",
+        (record) => {
+          if (record.type === "perf") perf[record.name] = record.value;
+        }
+      );
+
+      expect(result.error).toBeUndefined();
+      // Zeroed, then each sampled entry incremented once
+      expect(result.answer).toBe(String((5 * 1024 * 1024) / 4096));
+      expect([0, 1, 2]).toContain(perf["pages.table"]);
+    }
+  });
+
+  it("should report work counters only in stats builds", async () => {
+    const config: RunConfig = {
+      day: 91,
+      part: 1,
+      lang: "c",
+      useSample: true,
+      agentDir,
+      coreDataDir,
+    };
+
+    const release = await executeC({ ...config, stats: false });
+    expect(release.answer).toBe("15");
+    expect(release.stats).toBeUndefined();
+
+    const result = await executeC({ ...config, stats: true });
+    expect(result.error).toBeUndefined();
+    expect(result.answer).toBe("15");
+    expect(result.stats).toEqual({
+      digits: { count: 4 },
+      digit: {
+        count: 4,
+        sum: 15,
+        min: 1,
+        max: 9,
+        hist: { 1: 1, 2: 2, 8: 1 },
+      },
+    });
+  });
+
   describe("precompileC", () => {
     it("should precompile a C solution", async () => {
       const result = await precompileC(agentDir, 99, 1);
@@ -294,6 +504,45 @@ int main(void) { printf("42"); return 0; }
     });
   });
 
+  describe("build modes", () => {
+    it("should parse build modes", () => {
+      expect(parseCBuildMode("nostart")).toBe("nostart");
+      expect(parseCBuildMode("shared")).toBeNull();
+      expect(parseCBuildMode(undefined)).toBeNull();
+    });
+
+    it("should keep one binary per mode", () => {
+      expect(cBinaryPath("day01", 1)).not.toBe(
+        cBinaryPath("day01", 1, "static")
+      );
+      expect(cBinaryPath("day01", 2, "nostart")).toContain("part2.nostart");
+      expect(cBinaryPath("day01", 1, "dynamic", true)).toContain(
+        "part1.stats"
+      );
+    });
+
+    it("should link the harness start file without libc", () => {
+      const { args } = cCompileCommand("nostart", "part1.c", "part1", "h");
+
+      expect(args).toContain("-nostdlib");
+      expect(args).toContain("-static");
+      expect(args).toContain(join("h", "start.c"));
+    });
+
+    it.runIf(process.platform === "linux")(
+      "should fall back to a static build when the solver uses libc",
+      async () => {
+        const result = await precompileC(agentDir, 99, 1, "nostart");
+
+        expect(result).toMatchObject({ mode: "static" });
+        if ("binaryPath" in result) {
+          const run = await executePrecompiled(result.binaryPath, "1\n2\n");
+          expect(run.answer).toBe("3");
+        }
+      }
+    );
+  });
+
   describe("executePrecompiled", () => {
     it("should execute a precompiled binary", async () => {
       const precompile = await precompileC(agentDir, 99, 1);
@@ -314,6 +563,20 @@ int main(void) { printf("42"); return 0; }
       }
     });
 
+    it("should report records as they are printed", async () => {
+      const precompile = await precompileC(agentDir, 99, 1);
+      expect("binaryPath" in precompile).toBe(true);
+
+      if ("binaryPath" in precompile) {
+        const types: string[] = [];
+        await executePrecompiled(precompile.binaryPath, "1\n", (record) =>
+          types.push(record.type)
+        );
+
+        expect(types).toEqual(["time", "time", "answer"]);
+      }
+    });
+
     it("should handle execution error in precompiled binary", async () => {
       // Precompile a failing binary
       const precompile = await precompileC(agentDir, 95, 1);
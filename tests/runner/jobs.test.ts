@@ -0,0 +1,141 @@
+/**
+ * 🧪 Tests - Job Queue
+ */
+
+import { describe, it, expect } from "vitest";
+import { JobQueue, ResultCache } from "../core/runner/src/jobs.js";
+
+function deferred<T>() {
+  let resolve!: (value: T) => void;
+  const promise = new Promise<T>((r) => (resolve = r));
+  return { promise, resolve };
+}
+
+const tick = () => new Promise((resolve) => setTimeout(resolve, 0));
+
+describe("jobs", () => {
+  describe("JobQueue", () => {
+    it("should share identical in-flight jobs", async () => {
+      const queue = new JobQueue();
+      const gate = deferred<string>();
+      let calls = 0;
+
+      const task = async () => {
+        calls++;
+        return gate.promise;
+      };
+
+      const a = queue.submit("run", "claude-1-1-c", task);
+      const b = queue.submit("run", "claude-1-1-c", task);
+
+      expect(b).toBe(a);
+      expect(a.info.subscribers).toBe(2);
+
+      gate.resolve("42");
+      expect(await b.promise).toBe("42");
+      expect(calls).toBe(1);
+    });
+
+    it("should run the same key again once finished", async () => {
+      const queue = new JobQueue();
+      let calls = 0;
+
+      await queue.submit("run", "k", async () => ++calls).promise;
+      const second = queue.submit("run", "k", async () => ++calls);
+
+      expect(await second.promise).toBe(2);
+      expect(queue.list().map((j) => j.status)).toEqual(["done", "done"]);
+    });
+
+    it("should keep kinds apart", () => {
+      const queue = new JobQueue();
+      const a = queue.submit("run", "k", () => new Promise(() => {}));
+      const b = queue.submit("benchmark", "k", () => new Promise(() => {}));
+
+      expect(b).not.toBe(a);
+    });
+
+    it("should queue jobs beyond the kind's concurrency", async () => {
+      const queue = new JobQueue({ concurrency: { run: 1 } });
+      const gate = deferred<void>();
+
+      const first = queue.submit("run", "a", () => gate.promise);
+      const second = queue.submit("run", "b", async () => "b");
+      const other = queue.submit("benchmark", "c", async () => "c");
+
+      await tick();
+      expect(first.info.status).toBe("running");
+      expect(second.info.status).toBe("queued");
+      expect(await other.promise).toBe("c");
+
+      gate.resolve();
+      expect(await second.promise).toBe("b");
+      expect(queue.status()).toEqual({
+        queued: 0,
+        running: 0,
+        done: 3,
+        failed: 0,
+      });
+    });
+
+    it("should record failures", async () => {
+      const queue = new JobQueue();
+      const job = queue.submit("run", "k", async () => {
+        throw new Error("boom");
+      });
+
+      await expect(job.promise).rejects.toThrow("boom");
+      expect(queue.get(job.info.id)).toMatchObject({
+        status: "failed",
+        error: "boom",
+      });
+    });
+
+    it("should forward progress to every subscriber", async () => {
+      const queue = new JobQueue();
+      const gate = deferred<void>();
+      const seen: unknown[] = [];
+
+      const job = queue.submit("benchmark", "k", async ({ progress }) => {
+        await gate.promise;
+        progress(1, 2, 0.5);
+        progress(2, 2, 0.7);
+      });
+      job.onProgress((p, detail) => seen.push([p.completed, detail]));
+      queue.submit("benchmark", "k", async () => {}).onProgress(() => {
+        seen.push("second");
+      });
+
+      gate.resolve();
+      await job.promise;
+
+      expect(seen).toEqual([[1, 0.5], "second", [2, 0.7], "second"]);
+      expect(job.info.progress).toEqual({ completed: 2, total: 2 });
+    });
+
+    it("should only keep a bounded history of finished jobs", async () => {
+      const queue = new JobQueue({ historySize: 2 });
+      for (let i = 0; i < 5; i++) {
+        await queue.submit("run", `k${i}`, async () => i).promise;
+      }
+
+      expect(queue.list().map((j) => j.key)).toEqual(["k4", "k3"]);
+      expect(queue.get(1)).toBeUndefined();
+    });
+  });
+
+  describe("ResultCache", () => {
+    it("should evict the least recently used entry", () => {
+      const cache = new ResultCache<number>(2);
+      cache.set("a", 1);
+      cache.set("b", 2);
+      cache.get("a");
+      cache.set("c", 3);
+
+      expect(cache.get("b")).toBeUndefined();
+      expect(cache.get("a")).toBe(1);
+      expect(cache.get("c")).toBe(3);
+      expect(cache.size).toBe(2);
+    });
+  });
+});
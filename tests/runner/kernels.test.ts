@@ -0,0 +1,125 @@
+/**
+ * 🧪 Tests - Kernel Shootouts
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from "vitest";
+import { mkdir, rm, writeFile, copyFile } from "node:fs/promises";
+import { join } from "node:path";
+import { runKernelBench } from "../core/runner/src/kernels.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-kernels");
+
+// Sum of the numbers of the input, three ways (one of them wrong)
+const BENCH = `
+#include "kernel.h"
+
+typedef struct { int n; int values[64]; } Input;
+
+static uint64_t loop(const void* ctx) {
+    const Input* in = ctx;
+    uint64_t sum = 0;
+    for (int i = 0; i < in->n; i++) sum += (uint64_t)in->values[i];
+    return sum;
+}
+
+static uint64_t unrolled(const void* ctx) {
+    const Input* in = ctx;
+    uint64_t a = 0, b = 0;
+    int i = 0;
+    for (; i + 1 < in->n; i += 2) { a += (uint64_t)in->values[i]; b += (uint64_t)in->values[i + 1]; }
+    if (i < in->n) a += (uint64_t)in->values[i];
+    return a + b;
+}
+
+static uint64_t wrong(const void* ctx) {
+    return loop(ctx) + WRONG;
+}
+
+int main(void) {
+    char* input = aoc_read_input();
+    static Input in;
+    for (char* p = input; *p && in.n < 64;) {
+        in.values[in.n++] = (int)strtol(p, &p, 10);
+        while (*p == '\\n') p++;
+    }
+
+    aoc_kernel_register("test/loop", loop);
+    aoc_kernel_register("test/unrolled", unrolled);
+    aoc_kernel_register("test/wrong", wrong);
+    return aoc_kernel_main(&in);
+}
+`;
+
+describe("kernels", () => {
+  beforeAll(async () => {
+    await mkdir(TEST_ROOT, { recursive: true });
+    for (const file of ["common.h", "kernel.h"]) {
+      await copyFile(
+        join(process.cwd(), "core", "runner", "c", file),
+        join(TEST_ROOT, file)
+      );
+    }
+    await writeFile(
+      join(TEST_ROOT, "right.c"),
+      `#define WRONG 0\n${BENCH}`
+    );
+    await writeFile(
+      join(TEST_ROOT, "wrong.c"),
+      `#define WRONG 1\n${BENCH}`
+    );
+  });
+
+  afterAll(async () => {
+    await rm(TEST_ROOT, { recursive: true, force: true });
+  });
+
+  const options = { harnessDir: TEST_ROOT, samples: 3, sampleMs: 1 };
+
+  it("should time every kernel", async () => {
+    const result = await runKernelBench(
+      join(TEST_ROOT, "right.c"),
+      "1\n2\n3\n4\n5\n",
+      options
+    );
+
+    expect(result.error).toBeUndefined();
+    expect(result.ok).toBe(true);
+    expect(result.answer).toBe("15");
+    expect(result.kernels.map((k) => k.name)).toEqual([
+      "test/loop",
+      "test/unrolled",
+      "test/wrong",
+    ]);
+    for (const kernel of result.kernels) {
+      expect(kernel.samples).toBe(3);
+      expect(kernel.iterations).toBeGreaterThan(0);
+      expect(kernel.medianNs).toBeGreaterThan(0);
+      expect(kernel.minNs).toBeLessThanOrEqual(kernel.medianNs);
+    }
+  }, 30000);
+
+  it("should flag kernels disagreeing with the reference", async () => {
+    const result = await runKernelBench(
+      join(TEST_ROOT, "wrong.c"),
+      "1\n2\n3\n",
+      options
+    );
+
+    expect(result.error).toBeUndefined();
+    expect(result.ok).toBe(false);
+    expect(result.kernels.map((k) => k.ok)).toEqual([true, true, false]);
+    expect(result.kernels[2]!.answer).toBe("7");
+  }, 30000);
+
+  it("should report compilation errors", async () => {
+    await writeFile(join(TEST_ROOT, "broken.c"), "int main(void) { nope; }");
+    const result = await runKernelBench(
+      join(TEST_ROOT, "broken.c"),
+      "",
+      options
+    );
+
+    expect(result.error).toContain("Compilation failed");
+    expect(result.kernels).toEqual([]);
+  }, 30000);
+});
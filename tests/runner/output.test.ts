@@ -0,0 +1,164 @@
+/**
+ * 🧪 Tests - Solver Output Parser
+ */
+
+import { describe, it, expect } from "vitest";
+import {
+  OutputParser,
+  CappedText,
+  parseOutputLine,
+  formatStatLine,
+} from "../core/runner/src/output.js";
+import type { OutputRecord } from "../core/runner/src/output.js";
+
+describe("output", () => {
+  describe("parseOutputLine", () => {
+    it("should parse the standardized records", () => {
+      expect(parseOutputLine("TIME:solve:1.25")).toEqual({
+        type: "time",
+        name: "solve",
+        ms: 1.25,
+      });
+      expect(parseOutputLine("PERF:cycles:1200")).toEqual({
+        type: "perf",
+        name: "cycles",
+        value: 1200,
+      });
+      expect(parseOutputLine("ANSWER:a:b")).toEqual({
+        type: "answer",
+        value: "a:b",
+      });
+      expect(parseOutputLine("ERROR:oops")).toEqual({
+        type: "error",
+        message: "oops",
+      });
+    });
+
+    it("should parse kernel benchmark results", () => {
+      const record = parseOutputLine(
+        "KERNEL:gemini/simd:iters=54,samples=20,min_ns=1.5,median_ns=2," +
+          "mean_ns=2.1,max_ns=3,stddev_ns=0.25,ok=0,answer=a,b=c"
+      );
+
+      expect(record).toEqual({
+        type: "kernel",
+        kernel: {
+          name: "gemini/simd",
+          iterations: 54,
+          samples: 20,
+          minNs: 1.5,
+          medianNs: 2,
+          meanNs: 2.1,
+          maxNs: 3,
+          stdDevNs: 0.25,
+          ok: false,
+          answer: "a,b=c",
+        },
+      });
+      expect(parseOutputLine("KERNEL:x:iters=1,answer=2").type).toBe("text");
+    });
+
+    it("should parse work counters", () => {
+      expect(parseOutputLine("STAT:nodes:count=12")).toEqual({
+        type: "stat",
+        name: "nodes",
+        stat: { count: 12 },
+      });
+
+      const line = "STAT:depth:count=5,sum=9,min=0,max=4,hist=0:1;2:3;4:1";
+      const record = parseOutputLine(line);
+      expect(record).toEqual({
+        type: "stat",
+        name: "depth",
+        stat: {
+          count: 5,
+          sum: 9,
+          min: 0,
+          max: 4,
+          hist: { 0: 1, 2: 3, 4: 1 },
+        },
+      });
+      if (record.type === "stat") {
+        expect(formatStatLine(record.name, record.stat)).toBe(line);
+      }
+      expect(parseOutputLine("STAT:nodes:sum=3").type).toBe("text");
+    });
+
+    it("should keep malformed records as text", () => {
+      expect(parseOutputLine("TIME:solve:abc")).toEqual({
+        type: "text",
+        line: "TIME:solve:abc",
+      });
+    });
+  });
+
+  describe("OutputParser", () => {
+    it("should parse lines split across chunks", () => {
+      const parser = new OutputParser();
+      parser.write("TIME:pa");
+      parser.write(Buffer.from("rse:0.5\r\nTIME:solve:2\nANS"));
+      parser.write("WER:42");
+
+      const output = parser.end();
+      expect(output.answer).toBe("42");
+      expect(output.times).toEqual({ parse: 0.5, solve: 2 });
+      expect(output.truncated).toBe(false);
+    });
+
+    it("should emit records as soon as their line is complete", () => {
+      const records: OutputRecord[] = [];
+      const parser = new OutputParser({ onRecord: (r) => records.push(r) });
+
+      parser.write("TIME:solve:1\nTIME:solve:2\nTIME:so");
+      expect(records.map((r) => r.type === "time" && r.ms)).toEqual([1, 2]);
+
+      parser.write("lve:3\n");
+      expect(records).toHaveLength(3);
+      expect(parser.end().timeCounts).toEqual({ solve: 3 });
+    });
+
+    it("should split multi-byte characters safely", () => {
+      const bytes = Buffer.from("ANSWER:été\n");
+      const parser = new OutputParser();
+      parser.write(bytes.subarray(0, 9));
+      parser.write(bytes.subarray(9));
+
+      expect(parser.end().answer).toBe("été");
+    });
+
+    it("should bound retained text", () => {
+      const parser = new OutputParser({ maxTextBytes: 100 });
+      for (let i = 0; i < 1000; i++) parser.write(`debug line ${i}\n`);
+      parser.write("ANSWER:7\n");
+
+      const output = parser.end();
+      expect(output.answer).toBe("7");
+      expect(output.text.length).toBeLessThanOrEqual(100);
+      expect(output.text.startsWith("debug line 0\n")).toBe(true);
+      expect(output.truncated).toBe(true);
+    });
+
+    it("should cut overlong lines", () => {
+      const parser = new OutputParser({ maxLineBytes: 16 });
+      parser.write("x".repeat(10));
+      parser.write("x".repeat(10_000));
+      parser.write("\nANSWER:1\n");
+
+      const output = parser.end();
+      expect(output.text).toBe(`${"x".repeat(16)}\n`);
+      expect(output.answer).toBe("1");
+      expect(output.truncated).toBe(true);
+    });
+  });
+
+  describe("CappedText", () => {
+    it("should keep the beginning of the stream", () => {
+      const text = new CappedText(8);
+      text.write("abcdef");
+      text.write("ghijkl");
+
+      expect(text.truncated).toBe(true);
+      expect(text.toString()).toBe("abcdefgh\n[output truncated]");
+    });
+  });
+});
@@ -0,0 +1,243 @@
+/**
+ * 🧪 Tests - Core Scheduler
+ */
+
+import { describe, it, expect, beforeAll, afterAll } from "vitest";
+import { mkdir, rm, writeFile } from "node:fs/promises";
+import { join } from "node:path";
+import {
+  parseCpuList,
+  readAllowedCpus,
+  detectCpuTopology,
+  pinCommand,
+  solverCores,
+  CoreScheduler,
+} from "../core/runner/src/scheduler.js";
+import type { PhysicalCore } from "../core/runner/src/scheduler.js";
+
+const TEST_ROOT = join(process.cwd(), "tests", ".tmp-scheduler");
+
+// 4 cores with 2 SMT threads each: cpuN and cpuN+4 are siblings
+const SMT_CORES: PhysicalCore[] = [
+  { cpus: [0, 4] },
+  { cpus: [1, 5] },
+  { cpus: [2, 6] },
+  { cpus: [3, 7] },
+];
+
+describe("scheduler", () => {
+  describe("parseCpuList", () => {
+    it("should parse ranges and single CPUs", () => {
+      expect(parseCpuList("0-3,8,10-11\n")).toEqual([0, 1, 2, 3, 8, 10, 11]);
+    });
+
+    it("should handle empty lists", () => {
+      expect(parseCpuList("")).toEqual([]);
+    });
+  });
+
+  describe("readAllowedCpus", () => {
+    beforeAll(async () => {
+      await mkdir(TEST_ROOT, { recursive: true });
+    });
+
+    afterAll(async () => {
+      await rm(TEST_ROOT, { recursive: true, force: true });
+    });
+
+    it("should read Cpus_allowed_list", async () => {
+      const statusPath = join(TEST_ROOT, "status");
+      await writeFile(
+        statusPath,
+        "Name:\tnode\nCpus_allowed:\tff\nCpus_allowed_list:\t0-2,5\n"
+      );
+      expect(readAllowedCpus(statusPath)).toEqual([0, 1, 2, 5]);
+    });
+
+    it("should return null when unavailable", () => {
+      expect(readAllowedCpus(join(TEST_ROOT, "missing"))).toBeNull();
+    });
+  });
+
+  describe("detectCpuTopology", () => {
+    const sysDir = join(TEST_ROOT, "cpu");
+
+    beforeAll(async () => {
+      await mkdir(sysDir, { recursive: true });
+      await writeFile(join(sysDir, "online"), "0-7\n");
+      for (let cpu = 0; cpu < 8; cpu++) {
+        const topology = join(sysDir, `cpu${cpu}`, "topology");
+        await mkdir(topology, { recursive: true });
+        const core = cpu % 4;
+        await writeFile(
+          join(topology, "thread_siblings_list"),
+          `${core},${core + 4}\n`
+        );
+      }
+    });
+
+    afterAll(async () => {
+      await rm(TEST_ROOT, { recursive: true, force: true });
+    });
+
+    it("should group SMT siblings into physical cores", () => {
+      expect(detectCpuTopology(sysDir, null)).toEqual(SMT_CORES);
+    });
+
+    it("should only keep allowed CPUs", () => {
+      expect(detectCpuTopology(sysDir, [2, 3, 6])).toEqual([
+        { cpus: [2, 6] },
+        { cpus: [3] },
+      ]);
+    });
+  });
+
+  describe("pinCommand", () => {
+    it("should leave the command unchanged without a lease", () => {
+      expect(pinCommand(undefined, "./part1", [])).toEqual({
+        command: "./part1",
+        args: [],
+      });
+    });
+  });
+
+  describe("solverCores", () => {
+    it("should give threaded solvers every core", () => {
+      const source = "ok = pthread_create(&thread, NULL, work, job) == 0;";
+      expect(solverCores(source)).toBe(Infinity);
+    });
+
+    it("should give other solvers one core", () => {
+      expect(solverCores("int main(void) { return 0; }")).toBe(1);
+    });
+  });
+
+  describe("CoreScheduler", () => {
+    it("should reserve the first core by default", () => {
+      const scheduler = new CoreScheduler({ cores: SMT_CORES });
+      expect(scheduler.capacity("isolated")).toBe(3);
+      expect(scheduler.capacity("throughput")).toBe(6);
+    });
+
+    it("should keep one core on single-core machines", () => {
+      const scheduler = new CoreScheduler({ cores: [{ cpus: [0] }] });
+      expect(scheduler.capacity("isolated")).toBe(1);
+    });
+
+    it("should give isolated tasks a whole physical core", async () => {
+      const scheduler = new CoreScheduler({
+        cores: SMT_CORES,
+        reserveCores: 0,
+      });
+
+      const leases = await Promise.all([
+        scheduler.acquire("isolated"),
+        scheduler.acquire("isolated"),
+      ]);
+
+      expect(leases.map((l) => l.cpus)).toEqual([
+        [0, 4],
+        [1, 5],
+      ]);
+    });
+
+    it("should lease several whole cores to parallel tasks", async () => {
+      const scheduler = new CoreScheduler({ cores: SMT_CORES });
+
+      const single = await scheduler.acquire("isolated");
+      expect(single.cpus).toEqual([1, 5]);
+
+      // Capped at the 3 cores of the pool: waits for the single-core task
+      const parallel = scheduler.acquire("isolated", Infinity);
+      expect(scheduler.status().queued).toBe(1);
+
+      scheduler.release(single);
+      expect((await parallel).cpus).toEqual([1, 2, 3, 5, 6, 7]);
+    });
+
+    it("should spread parallel throughput tasks", async () => {
+      const scheduler = new CoreScheduler({
+        cores: SMT_CORES,
+        reserveCores: 0,
+      });
+
+      const first = await scheduler.acquire("throughput");
+      const parallel = await scheduler.acquire("throughput", 4);
+      expect(first.cpus).toEqual([0]);
+      expect(parallel.cpus).toEqual([1, 2, 3, 4]);
+
+      // Capped at the 8 CPUs of the pool
+      const all = scheduler.acquire("throughput", 10);
+      expect(scheduler.status().queued).toBe(1);
+      scheduler.release(first);
+      scheduler.release(parallel);
+      expect((await all).cpus).toEqual([0, 1, 2, 3, 4, 5, 6, 7]);
+    });
+
+    it("should spread throughput tasks before using siblings", async () => {
+      const scheduler = new CoreScheduler({
+        cores: SMT_CORES,
+        reserveCores: 0,
+      });
+
+      const leases = [];
+      for (let i = 0; i < 6; i++) {
+        leases.push(await scheduler.acquire("throughput"));
+      }
+
+      expect(leases.map((l) => l.cpus)).toEqual([
+        [0],
+        [1],
+        [2],
+        [3],
+        [4],
+        [5],
+      ]);
+    });
+
+    it("should queue tasks beyond capacity in FIFO order", async () => {
+      const scheduler = new CoreScheduler({
+        cores: [{ cpus: [0, 1] }],
+      });
+
+      const order: string[] = [];
+      let releaseFirst!: () => void;
+      const first = scheduler.run("isolated", async () => {
+        order.push("first");
+        await new Promise<void>((resolve) => (releaseFirst = resolve));
+      });
+
+      const second = scheduler.run("isolated", async (lease) => {
+        order.push("second");
+        return lease.cpus;
+      });
+
+      await new Promise((resolve) => setTimeout(resolve, 0));
+      expect(scheduler.status()).toEqual({ busyCpus: [0, 1], queued: 1 });
+
+      releaseFirst();
+      await first;
+      expect(await second).toEqual([0, 1]);
+      expect(order).toEqual(["first", "second"]);
+      expect(scheduler.status()).toEqual({ busyCpus: [], queued: 0 });
+    });
+
+    it("should keep FIFO order across modes", async () => {
+      const scheduler = new CoreScheduler({ cores: [{ cpus: [0, 1] }] });
+
+      const a = await scheduler.acquire("throughput");
+      const isolated = scheduler.acquire("isolated");
+      const throughput = scheduler.acquire("throughput");
+
+      expect(scheduler.status().queued).toBe(2);
+
+      scheduler.release(a);
+      const lease = await isolated;
+      expect(lease.cpus).toEqual([0, 1]);
+      expect(scheduler.status().queued).toBe(1);
+
+      scheduler.release(lease);
+      expect((await throughput).cpus).toEqual([0]);
+    });
+  });
+});
@@ -0,0 +1,31 @@
+/**
+ * 🧪 Tests - C Startup Cost
+ */
+
+import { describe, it, expect } from "vitest";
+import { join } from "node:path";
+import { measureStartup } from "../core/runner/src/startup.js";
+
+const HARNESS_DIR = join(process.cwd(), "core", "runner", "c");
+
+describe("startup", () => {
+  it.runIf(process.platform === "linux")(
+    "should measure every build mode",
+    async () => {
+      const results = await measureStartup(HARNESS_DIR, 5);
+
+      expect(results.map((r) => r.mode)).toEqual([
+        "dynamic",
+        "static",
+        "nostart",
+      ]);
+      for (const cost of results) {
+        expect(cost.error).toBeUndefined();
+        expect(cost.execToMainUs).toBeGreaterThan(0);
+        expect(cost.execToExitUs).toBeGreaterThanOrEqual(cost.execToMainUs);
+        expect(cost.execToMainMinUs).toBeLessThanOrEqual(cost.execToMainUs);
+      }
+    },
+    30000
+  );
+});
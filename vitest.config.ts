@@ -35,6 +35,30 @@ export default defineConfig({
         __dirname,
         "core/runner/src/executor-c.ts"
       ),
+      "../core/runner/src/scheduler.js": resolve(
+        __dirname,
+        "core/runner/src/scheduler.ts"
+      ),
+      "../core/runner/src/output.js": resolve(
+        __dirname,
+        "core/runner/src/output.ts"
+      ),
+      "../core/runner/src/kernels.js": resolve(
+        __dirname,
+        "core/runner/src/kernels.ts"
+      ),
+      "../core/runner/src/bench.js": resolve(
+        __dirname,
+        "core/runner/src/bench.ts"
+      ),
+      "../core/runner/src/startup.js": resolve(
+        __dirname,
+        "core/runner/src/startup.ts"
+      ),
+      "../core/runner/src/jobs.js": resolve(
+        __dirname,
+        "core/runner/src/jobs.ts"
+      ),
       "../core/runner/src/types.js": resolve(
         __dirname,
         "core/runner/src/types.ts"
@@ -43,6 +67,24 @@ export default defineConfig({
         __dirname,
         "core/db/src/database.ts"
       ),
+      "../core/db/src/stats.js": resolve(__dirname, "core/db/src/stats.ts"),
+      "../core/db/src/samples.js": resolve(
+        __dirname,
+        "core/db/src/samples.ts"
+      ),
+      "../core/db/src/benchmarks.js": resolve(
+        __dirname,
+        "core/db/src/benchmarks.ts"
+      ),
+      "../core/db/src/histogram.js": resolve(
+        __dirname,
+        "core/db/src/histogram.ts"
+      ),
+      "../core/db/src/leaderboard.js": resolve(
+        __dirname,
+        "core/db/src/leaderboard.ts"
+      ),
+      "../core/db/src/blobs.js": resolve(__dirname, "core/db/src/blobs.ts"),
       // Scripts lib
       "../scripts/lib/scaffold.js": resolve(
         __dirname,